@@ -35,6 +35,6 @@ public:
 	int getPriority() const;
 	void updatePriority(const int& xDest, const int& yDest);
 	void nextLevel(const int& i); // i: direction
-	const int& estimate(const int& xDest, const int& yDest) const;
+	int estimate(const int& xDest, const int& yDest) const;
 
 };
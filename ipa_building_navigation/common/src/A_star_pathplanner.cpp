@@ -12,8 +12,6 @@ static int dx[dir] =
 static int dy[dir] =
 { 0, 1, 1, 1, 0, -1, -1, -1 };
 
-static int expanding_counter = 0;
-
 // Determine priority (in the priority queue)
 bool operator<(const NodeAstar& a, const NodeAstar& b)
 {
@@ -95,13 +93,13 @@ void AStarPlanner::downsampleMap(const cv::Mat& map, cv::Mat& downsampled_map, c
 // The route returned is a string of direction digits.
 std::string AStarPlanner::pathFind(const int & xStart, const int & yStart, const int & xFinish, const int & yFinish, const cv::Mat& map)
 {
-	static std::priority_queue<NodeAstar> pq[2]; // list of open (not-yet-tried) nodes
-	static int pqi; // pq index
-	static NodeAstar* n0;
-	static NodeAstar* m0;
-	static int i, j, x, y, xdx, ydy;
-	static char c;
-	pqi = 0;
+	// local state only, so that several planner instances may search concurrently
+	std::priority_queue<NodeAstar> pq[2]; // list of open (not-yet-tried) nodes
+	int pqi = 0; // pq index
+	NodeAstar* n0;
+	NodeAstar* m0;
+	int i, j, x, y, xdx, ydy;
+	char c;
 
 	cv::Mat map_to_calculate_path(cv::Size(m, n), CV_32S);
 
@@ -188,8 +186,6 @@ std::string AStarPlanner::pathFind(const int & xStart, const int & yStart, const
 			xdx = x + dx[i];
 			ydy = y + dy[i];
 
-			expanding_counter++;
-
 			if (!(xdx < 0 || xdx > n - 1 || ydy < 0 || ydy > m - 1 || map_to_calculate_path.at<int>(xdx, ydy) == 1 || closed_nodes_map.at<int>(xdx, ydy) == 1))
 			{
 				// generate a child node
@@ -250,7 +246,6 @@ double AStarPlanner::planPath(const cv::Mat& map, const cv::Point& start_point,
 		const double downsampling_factor, const double robot_radius, const double map_resolution,
 		const int end_point_valid_neighborhood_radius, std::vector<cv::Point>* route)
 {
-	expanding_counter = 0;
 	double step_length = 1./downsampling_factor;
 
 	//length of the planned path
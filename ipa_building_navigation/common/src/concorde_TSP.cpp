@@ -155,7 +155,7 @@ std::vector<int> ConcordeTSPSolver::solveConcordeTSP(const cv::Mat& path_length_
 	timeval time;
 	gettimeofday(&time, NULL);
 	std::stringstream ss;
-	ss << "_" << time.tv_sec << "_" << time.tv_usec;
+	ss << "_" << time.tv_sec << "_" << time.tv_usec << "_" << this;	// the object address separates concurrent solvers
 	unique_file_identifier_ = ss.str();
 	const std::string tsp_lib_filename = "TSPlib_file" + unique_file_identifier_ + ".txt";
 	const std::string tsp_order_filename = "TSP_order" + unique_file_identifier_ + ".txt";
@@ -75,6 +75,7 @@
 #include <ipa_room_exploration/meanshift2d.h>
 #include <ipa_room_exploration/fov_to_robot_mapper.h>
 #include <ipa_room_exploration/room_rotator.h>
+#include <ipa_room_exploration/path_post_processor.h>
 #include <ipa_room_exploration/grid.h>
 
 #include <geometry_msgs/Pose2D.h>
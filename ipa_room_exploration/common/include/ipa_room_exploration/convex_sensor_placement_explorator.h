@@ -86,6 +86,7 @@
 #include <ipa_building_navigation/nearest_neighbor_TSP.h>
 
 #include <ipa_room_exploration/room_rotator.h>
+#include <ipa_room_exploration/path_post_processor.h>
 #include <ipa_room_exploration/fov_to_robot_mapper.h>
 #include <ipa_room_exploration/grid.h>
 #include <ipa_room_exploration/timer.h>
@@ -65,11 +65,13 @@
 #include <vector>
 #include <cmath>
 #include <string>
+#include <algorithm>
 
 #include <Eigen/Dense>
 
 #include <ipa_room_exploration/meanshift2d.h>
 #include <ipa_room_exploration/room_rotator.h>
+#include <ipa_room_exploration/path_post_processor.h>
 #include <ipa_room_exploration/fov_to_robot_mapper.h>
 #include <ipa_room_exploration/grid.h>
 
@@ -82,21 +84,152 @@ const double PI_2_INV = 1./(0.5*PI);
 
 
 
-// Struct that is used to create a node and save the corresponding neighbors.
+// Struct that is used to create a node and save the information about its neighbors that is needed for the energy functional.
 struct EnergyExploratorNode
 {
 	cv::Point center_;
 	bool obstacle_;
 	bool visited_;
-	std::vector<EnergyExploratorNode*> neighbors_;
+	int accessible_neighbors_;	// number of neighbors that are no obstacles
+	int obstacle_neighbors_;	// number of neighbors that are obstacles
+	int visited_neighbors_;		// number of neighbors that are no obstacles and have been visited already
+};
+
+// Class that stores the nodes of the grid row-wise in one flat array, the neighbors of a node are addressed by their index in
+// this array. Additionally the number of not yet visited nodes is counted in square blocks of nodes, which allows to skip already
+// covered areas when searching for the next node after the path got stuck in a dead end.
+class EnergyExploratorNodeGrid
+{
+protected:
+	std::vector<EnergyExploratorNode> nodes_;
+	int rows_, columns_;
+
+	// size of the square blocks of nodes and the number of not visited accessible nodes in each block (CV_32S)
+	int block_size_;
+	cv::Mat unvisited_nodes_per_block_;
+
+public:
+
+	EnergyExploratorNodeGrid()
+	: rows_(0), columns_(0), block_size_(8)
+	{
+	}
+
+	// function that creates a grid of rows x columns nodes, the nodes have to be filled afterwards and finished with computeNeighborhoods()
+	void initialize(const int rows, const int columns, const int block_size=8)
+	{
+		rows_ = rows;
+		columns_ = columns;
+		block_size_ = block_size;
+		nodes_.assign(rows*columns, EnergyExploratorNode());
+		unvisited_nodes_per_block_ = cv::Mat::zeros((rows+block_size-1)/block_size, (columns+block_size-1)/block_size, CV_32S);
+	}
+
+	int rows() const
+	{
+		return rows_;
+	}
+
+	int columns() const
+	{
+		return columns_;
+	}
+
+	int size() const
+	{
+		return (int)nodes_.size();
+	}
+
+	int index(const int row, const int column) const
+	{
+		return row*columns_ + column;
+	}
 
-	int countNonObstacleNeighbors()
+	EnergyExploratorNode& operator[](const int node_index)
 	{
-		int non_obstacle_neighbors = 0;
-		for(std::vector<EnergyExploratorNode*>::iterator neighbor=neighbors_.begin(); neighbor!=neighbors_.end(); ++neighbor)
-			if((*neighbor)->obstacle_==false)
-				++non_obstacle_neighbors;
-		return non_obstacle_neighbors;
+		return nodes_[node_index];
+	}
+
+	const EnergyExploratorNode& operator[](const int node_index) const
+	{
+		return nodes_[node_index];
+	}
+
+	// function that writes the indices of the (up to 8) direct neighbors of the given node into neighbors, ordered row-wise from
+	// the upper left to the lower right neighbor, and returns the number of neighbors
+	int getNeighbors(const int node_index, int* neighbors) const
+	{
+		const int row = node_index/columns_;
+		const int column = node_index%columns_;
+		int number_of_neighbors = 0;
+		for(int neighbor_row=std::max(0, row-1); neighbor_row<=std::min(rows_-1, row+1); ++neighbor_row)
+			for(int neighbor_column=std::max(0, column-1); neighbor_column<=std::min(columns_-1, column+1); ++neighbor_column)
+				if(neighbor_row!=row || neighbor_column!=column)
+					neighbors[number_of_neighbors++] = index(neighbor_row, neighbor_column);
+		return number_of_neighbors;
+	}
+
+	// function that counts the obstacle and accessible neighbors of each node and the not visited nodes in each block
+	void computeNeighborhoods()
+	{
+		int neighbors[8];
+		unvisited_nodes_per_block_.setTo(0);
+		for(int node_index=0; node_index<size(); ++node_index)
+		{
+			EnergyExploratorNode& node = nodes_[node_index];
+			node.accessible_neighbors_ = 0;
+			node.obstacle_neighbors_ = 0;
+			node.visited_neighbors_ = 0;
+			const int number_of_neighbors = getNeighbors(node_index, neighbors);
+			for(int neighbor=0; neighbor<number_of_neighbors; ++neighbor)
+			{
+				const EnergyExploratorNode& neighbor_node = nodes_[neighbors[neighbor]];
+				if(neighbor_node.obstacle_ == true)
+					++node.obstacle_neighbors_;
+				else
+				{
+					++node.accessible_neighbors_;
+					if(neighbor_node.visited_ == true)
+						++node.visited_neighbors_;
+				}
+			}
+			if(node.obstacle_==false && node.visited_==false)
+				++unvisited_nodes_per_block_.at<int>((node_index/columns_)/block_size_, (node_index%columns_)/block_size_);
+		}
+	}
+
+	// function that marks the given accessible node as visited and updates the counters of its neighbors and its block
+	void markAsVisited(const int node_index)
+	{
+		EnergyExploratorNode& node = nodes_[node_index];
+		if(node.visited_ == true)
+			return;
+		node.visited_ = true;
+		--unvisited_nodes_per_block_.at<int>((node_index/columns_)/block_size_, (node_index%columns_)/block_size_);
+		int neighbors[8];
+		const int number_of_neighbors = getNeighbors(node_index, neighbors);
+		for(int neighbor=0; neighbor<number_of_neighbors; ++neighbor)
+			++nodes_[neighbors[neighbor]].visited_neighbors_;
+	}
+
+	int blockSize() const
+	{
+		return block_size_;
+	}
+
+	int blockRows() const
+	{
+		return unvisited_nodes_per_block_.rows;
+	}
+
+	int blockColumns() const
+	{
+		return unvisited_nodes_per_block_.cols;
+	}
+
+	int unvisitedNodesInBlock(const int block_row, const int block_column) const
+	{
+		return unvisited_nodes_per_block_.at<int>(block_row, block_column);
 	}
 };
 
@@ -127,7 +260,8 @@ struct cv_Point_cmp
 // locations among the 8 neighbors Nb8(n) around n and is computed as
 //		N(n) = 4 - sum_(k in Nb8(n)) |k ∩ L|/2,
 // where L is the number of already visited nodes. If no accessible node in the direct neighborhood could be found, the algorithm
-// searches for the next node in the whole grid. This procedure is repeated until all nodes have been visited.
+// searches for the next node in the whole grid, starting at the nodes around the current location. This procedure is repeated
+// until all nodes have been visited.
 // This class only produces a static path, regarding the given map in form of a point series. To react on dynamic
 // obstacles, one has to do this in upper algorithms.
 //
@@ -137,6 +271,12 @@ protected:
 	// function to compute the energy function for each pair of nodes
 	double E(const EnergyExploratorNode& location, const EnergyExploratorNode& neighbor, const double cell_size_in_pixel, const double previous_travel_angle);
 
+	// function that finds the not visited node that minimizes the energy functional, searching the blocks of nodes in rings of
+	// increasing distance around the last node until no remaining block can contain a node with a lower energy,
+	// returns -1 if all nodes have been visited
+	int findBestUnvisitedNode(const EnergyExploratorNodeGrid& nodes, const int last_node_index, const double cell_size_in_pixel,
+			const int node_distance_in_pixel, const double previous_travel_angle);
+
 public:
 	// constructor
 	EnergyFunctionalExplorator();
@@ -5,6 +5,7 @@
 #include <iostream>
 #include <vector>
 #include <set>
+#include <map>
 #include <cmath>
 #include <string>
 #include <fstream>
@@ -17,6 +18,9 @@
 #include <coin/CoinModel.hpp>
 #include <coin/CbcModel.hpp>
 #include <coin/CbcHeuristicFPump.hpp>
+#include <coin/CglCutGenerator.hpp>
+#include <coin/OsiRowCut.hpp>
+#include <coin/OsiCuts.hpp>
 // Coin-Or library with Clp linear programming solver
 #include <coin/ClpSimplex.hpp>
 // Boost libraries
@@ -29,6 +33,7 @@
 #include <ipa_building_navigation/contains.h>
 #include <ipa_room_exploration/fov_to_robot_mapper.h>
 #include <ipa_room_exploration/room_rotator.h>
+#include <ipa_room_exploration/path_post_processor.h>
 // msgs
 #include <geometry_msgs/Pose2D.h>
 #include <geometry_msgs/Polygon.h>
@@ -480,10 +485,11 @@ protected:
 			const std::vector<uint>& start_arcs);
 
 	// function that is used to create and solve a Cbc optimization problem out of the given matrices and vectors, using
-	// the three-stage ansatz and lazy generalized cutset inequalities (GCI)
+	// the three-stage ansatz and lazy generalized cutset inequalities (GCI), if use_cut_generator is true the inequalities
+	// are also added during the branch and bound
 	void solveLazyConstraintOptimizationProblem(std::vector<double>& C, const cv::Mat& V, const std::vector<double>& weights,
 			const std::vector<std::vector<uint> >& flows_into_nodes, const std::vector<std::vector<uint> >& flows_out_of_nodes,
-			const std::vector<uint>& start_arcs);
+			const std::vector<uint>& start_arcs, const bool use_cut_generator);
 
 	// function that checks if the given point is more close enough to any point in the given vector
 	bool pointClose(const std::vector<cv::Point>& points, const cv::Point& point, const double min_distance);
@@ -495,15 +501,46 @@ public:
 	// constructor
 	FlowNetworkExplorator();
 
+	// function that searches for cycles in the given solution of the three-stage problem and computes the cycle prevention
+	// constraints (indices of the variables, that have a coefficient of 1, and upper bounds), returns false if no cycle
+	// has to be prevented
+	static bool computeCyclePreventionConstraints(const double* solution, const int number_of_arcs,
+			const std::vector<std::vector<uint> >& flows_into_nodes, const std::vector<std::vector<uint> >& flows_out_of_nodes,
+			const std::vector<uint>& start_arcs, std::vector<std::vector<int> >& constraint_indices, std::vector<double>& constraint_upper_bounds);
+
 	// Function that creates an exploration path for a given room. The room has to be drawn in a cv::Mat (filled with Bit-uchar),
 	// with free space drawn white (255) and obstacles as black (0). It returns a series of 2D poses that show to which positions
 	// the robot should drive at. The footprint stores a polygon that is used to determine the visibility at a specific
-	// sensing pose. delta_theta provides an angular step to determine candidates for sensing poses.
+	// sensing pose. delta_theta provides an angular step to determine candidates for sensing poses. If use_cut_generator is true,
+	// the Cbc solver also adds the cycle prevention constraints as cuts during the branch and bound (not used with Gurobi).
 	void getExplorationPath(const cv::Mat& room_map, std::vector<geometry_msgs::Pose2D>& path, const float map_resolution,
 				const cv::Point starting_position, const cv::Point2d map_origin,
 				const int cell_size, const Eigen::Matrix<float, 2, 1>& robot_to_fov_middlepoint_vector, const float coverage_radius,
-				const bool plan_for_footprint, const double path_eps, const double curvature_factor, const double max_distance_factor);
+				const bool plan_for_footprint, const double path_eps, const double curvature_factor, const double max_distance_factor,
+				const bool use_cut_generator);
 
 	// test function
 	void testFunc();
 };
+
+// Cut generator for Cbc that checks integer solutions found during the branch and bound for cycles that are not connected to
+// the rest of the path and adds the corresponding cycle prevention constraints as cuts, similar to the
+// CyclePreventionCallbackClass for Gurobi.
+class CyclePreventionCutGenerator : public CglCutGenerator
+{
+public:
+	// constructor
+	CyclePreventionCutGenerator(const std::vector<std::vector<uint> >& flows_into_nodes, const std::vector<std::vector<uint> >& flows_out_of_nodes,
+			const std::vector<uint>& start_arcs, const int number_of_arcs);
+
+	// Cbc stores a copy of each cut generator
+	virtual CglCutGenerator* clone() const;
+
+	// function that generates the cycle prevention cuts for the current solution of the solver
+	virtual void generateCuts(const OsiSolverInterface& si, OsiCuts& cs, const CglTreeInfo info = CglTreeInfo());
+
+protected:
+	std::vector<std::vector<uint> > flows_into_nodes_, flows_out_of_nodes_;
+	std::vector<uint> start_arcs_;
+	int number_of_arcs_;
+};
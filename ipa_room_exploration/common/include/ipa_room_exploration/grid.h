@@ -132,12 +132,14 @@ public:
 		// create the grid
 		if (complete_cell_test == true)
 		{
+			cv::Mat accessible_area_integral;
+			computeAccessibleAreaIntegral(room_map, accessible_area_integral);
 			for(int y=min_y; y<=max_y; y+=cell_size)
 			{
 				for(int x=min_x; x<=max_x; x+=cell_size)
 				{
 					cv::Point cell_center(x,y);
-					if (completeCellTest(room_map, cell_center, cell_size) == true)
+					if (completeCellTest(room_map, cell_center, cell_size, &accessible_area_integral) == true)
 						cell_centers.push_back(cell_center);
 				}
 			}
@@ -152,13 +154,23 @@ public:
 		}
 	}
 
+	// computes the summed-area table of the accessible pixels of room_map (CV_32S, one row and column larger than room_map),
+	// with this table completeCellTest can reject cells without accessible pixels in constant time
+	static void computeAccessibleAreaIntegral(const cv::Mat& room_map, cv::Mat& accessible_area_integral)
+	{
+		cv::Mat accessible_area = (room_map==255)/255;
+		cv::integral(accessible_area, accessible_area_integral, CV_32S);
+	}
+
 	// checks the whole cell for accessible areas and sets cell_center to the cell-center-most accessible point in the cell
 	// room_map = the map with inaccessible areas = 0 and accessible areas = 255
 	// cell_center = the provided cell center point to check, is updated with a new cell center if the original cell_center is not accessible but some other pixels in the cell around
 	// cell_size = the grid spacing in [pixels]
+	// accessible_area_integral = optional summed-area table of room_map from computeAccessibleAreaIntegral, should be provided when many cells are tested,
+	//                            then only cells that are partially accessible need to be searched for a new center
 	// returns true if any accessible cell was found in the cell area and then cell_center is returned with an updated value. If the cell does not contain
 	//         any accessible pixel, the return value is false.
-	static bool completeCellTest(const cv::Mat& room_map, cv::Point& cell_center, const int cell_size)
+	static bool completeCellTest(const cv::Mat& room_map, cv::Point& cell_center, const int cell_size, const cv::Mat* accessible_area_integral=0)
 	{
 		const int x = cell_center.x;
 		const int y = cell_center.y;
@@ -174,6 +186,16 @@ public:
 
 			// check whether there are accessible pixels within the cell
 			const int upper_bound = even_grid_size==true ? half_cell_size-1 : half_cell_size;	// adapt the neighborhood accordingly for even and odd grid sizes
+			if (accessible_area_integral != 0)
+			{
+				const int min_u = std::max(0, x-half_cell_size), max_u = std::min(room_map.cols-1, x+upper_bound);
+				const int min_v = std::max(0, y-half_cell_size), max_v = std::min(room_map.rows-1, y+upper_bound);
+				if (min_u>max_u || min_v>max_v)
+					return false;
+				const cv::Mat& integral = *accessible_area_integral;
+				if (integral.at<int>(max_v+1,max_u+1) - integral.at<int>(min_v,max_u+1) - integral.at<int>(max_v+1,min_u) + integral.at<int>(min_v,min_u) == 0)
+					return false;
+			}
 			cv::Mat cell_pixels = cv::Mat::zeros(cell_size, cell_size, CV_8UC1);
 			int accessible_pixels = 0;
 			for (int dy=-half_cell_size; dy<=upper_bound; ++dy)
@@ -296,6 +318,30 @@ public:
 		if ((min_x==inflated_room_map.cols) || (max_x==-1) || (min_y==inflated_room_map.rows) || (max_y==-1))
 			return;
 
+		// precompute for each column of the room's bounding box the closest accessible pixel above and below each pixel (including the
+		// pixel itself), so that searching shifted grid points off the track is a lookup instead of scanning the column for each point
+		const int roi_min_y = std::max(0, min_y-max_deviation_from_track);
+		const int roi_max_y = std::min(inflated_room_map.rows-1, max_y+max_deviation_from_track);
+		cv::Mat accessible_row_above(roi_max_y-roi_min_y+1, max_x-min_x+1, CV_32SC1);	// -1 if there is no accessible pixel above
+		cv::Mat accessible_row_below(roi_max_y-roi_min_y+1, max_x-min_x+1, CV_32SC1);	// inflated_room_map.rows if there is no accessible pixel below
+		for (int x=min_x; x<=max_x; ++x)
+		{
+			int last_accessible_row = -1;
+			for (int v=roi_min_y; v<=roi_max_y; ++v)
+			{
+				if (inflated_room_map.at<uchar>(v,x) == 255)
+					last_accessible_row = v;
+				accessible_row_above.at<int>(v-roi_min_y, x-min_x) = last_accessible_row;
+			}
+			last_accessible_row = inflated_room_map.rows;
+			for (int v=roi_max_y; v>=roi_min_y; --v)
+			{
+				if (inflated_room_map.at<uchar>(v,x) == 255)
+					last_accessible_row = v;
+				accessible_row_below.at<int>(v-roi_min_y, x-min_x) = last_accessible_row;
+			}
+		}
+
 		// create grid
 		const int squared_grid_spacing_horizontal = grid_spacing_horizontal*grid_spacing_horizontal;
 		//std::cout << "((max_y - min_y) <= grid_spacing): min_y=" << min_y << "   max_y=" << max_y << "   grid_spacing=" << grid_spacing << std::endl;
@@ -310,6 +356,9 @@ public:
 			const cv::Point invalid_point(-1,-1);
 			cv::Point last_added_grid_point_above(-10000,-10000), last_added_grid_point_below(-10000,-10000);	// for keeping the horizontal grid distance
 			cv::Point last_valid_grid_point_above(-1,-1), last_valid_grid_point_below(-1,-1);	// for adding the rightmost possible point
+			const uchar* map_row = inflated_room_map.ptr<uchar>(y);
+			const int* row_above = (y-1>=roi_min_y ? accessible_row_above.ptr<int>(y-1-roi_min_y) : 0);
+			const int* row_below = (y+1<=roi_max_y ? accessible_row_below.ptr<int>(y+1-roi_min_y) : 0);
 			// loop through the horizontal grid points with horizontal grid spacing length
 			for (int x=min_x; x<=max_x; x+=1)
 			{
@@ -322,7 +371,7 @@ public:
 				//      d) but some point below and above are --> valid points are added to upper_line and lower_line, respectively
 
 				// 1. check accessibility on regular location
-				if (inflated_room_map.at<uchar>(y,x)==255)
+				if (map_row[x]==255)
 				{
 					if (squaredPointDistance(last_added_grid_point_above,cv::Point(x,y))>=squared_grid_spacing_horizontal)
 					{
@@ -336,17 +385,9 @@ public:
 				// todo: add parameter to switch else branch off
 				else // 2. check accessibility above or below the targeted point
 				{
-					// check accessibility above the target location
-					bool found_above = false;
-					int dy = -1;
-					for (; dy>-max_deviation_from_track; --dy)
-					{
-						if (y+dy>=0 && inflated_room_map.at<uchar>(y+dy,x)==255)
-						{
-							found_above = true;
-							break;
-						}
-					}
+					// check accessibility above the target location (closer than max_deviation_from_track)
+					int dy = (row_above!=0 ? row_above[x-min_x]-y : -max_deviation_from_track);
+					const bool found_above = (row_above!=0 && row_above[x-min_x]>=0 && dy>-max_deviation_from_track);
 					if (found_above == true)
 					{
 						if (squaredPointDistance(last_added_grid_point_above,cv::Point(x,y+dy))>=squared_grid_spacing_horizontal)
@@ -359,17 +400,9 @@ public:
 							last_valid_grid_point_above = cv::Point(x,y+dy);	// store this point and add it to the upper line if it was the rightmost point
 					}
 
-					// check accessibility below the target location
-					bool found_below = false;
-					dy = 1;
-					for (; dy<max_deviation_from_track; ++dy)
-					{
-						if (y+dy<inflated_room_map.rows && inflated_room_map.at<uchar>(y+dy,x)==255)
-						{
-							found_below = true;
-							break;
-						}
-					}
+					// check accessibility below the target location (closer than max_deviation_from_track)
+					dy = (row_below!=0 ? row_below[x-min_x]-y : max_deviation_from_track);
+					const bool found_below = (row_below!=0 && row_below[x-min_x]<inflated_room_map.rows && dy<max_deviation_from_track);
 					if (found_below == true)
 					{
 						if (squaredPointDistance(last_added_grid_point_below,cv::Point(x,y+dy))>=squared_grid_spacing_horizontal)
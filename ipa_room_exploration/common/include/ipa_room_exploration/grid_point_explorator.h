@@ -69,6 +69,7 @@
 #include <ipa_building_navigation/tsp_solvers.h>
 #include <ipa_building_navigation/distance_matrix.h>
 #include <ipa_room_exploration/room_rotator.h>
+#include <ipa_room_exploration/path_post_processor.h>
 #include <ipa_room_exploration/fov_to_robot_mapper.h>
 #include <ipa_room_exploration/grid.h>
 
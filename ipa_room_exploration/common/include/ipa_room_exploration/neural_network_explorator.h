@@ -12,9 +12,10 @@
 #include <geometry_msgs/Polygon.h>
 #include <Eigen/Dense>
 
-#include <ipa_room_exploration/neuron_class.h>
+#include <ipa_room_exploration/neuron_grid.h>
 #include <ipa_room_exploration/fov_to_robot_mapper.h>
 #include <ipa_room_exploration/room_rotator.h>
+#include <ipa_room_exploration/path_post_processor.h>
 #include <ipa_room_exploration/grid.h>
 
 /*!
@@ -107,8 +108,8 @@ class NeuralNetworkExplorator
 {
 protected:
 
-	// vector that stores the neurons of the given map
-	std::vector<std::vector<Neuron> > neurons_;
+	// grid that stores the neurons of the given map
+	NeuronGrid neurons_;
 
 	// step size used for integrating the states of the neurons
 	double step_size_;
@@ -116,6 +117,10 @@ protected:
 	// parameters for the neural network
 	double A_, B_, D_, E_, mu_, delta_theta_weight_;
 
+	// state changes smaller than this threshold are treated as converged, so that the network only gets updated locally
+	// around the changed neurons after each step, a value <= 0 updates the whole network in every step
+	double update_threshold_;
+
 public:
 
 	// constructor
@@ -127,6 +132,18 @@ public:
 		step_size_ = step_size;
 	}
 
+	// function to set the number of threads that are used to update the states of the neural network
+	void setNumberOfThreads(int number_of_threads)
+	{
+		neurons_.setNumberOfThreads(number_of_threads);
+	}
+
+	// function to set the threshold for the local updates of the neural network
+	void setUpdateThreshold(double update_threshold)
+	{
+		update_threshold_ = update_threshold;
+	}
+
 	// function to set the parameters needed for the neural network
 	void setParameters(double A, double B, double D, double E, double mu, double step_size, double delta_theta_weight)
 	{
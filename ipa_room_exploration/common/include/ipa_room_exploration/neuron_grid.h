@@ -0,0 +1,419 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include <opencv2/opencv.hpp>
+
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+
+/*!
+ *****************************************************************
+ * \file
+ *
+ * \note
+ * Copyright (c) 2026 \n
+ * Fraunhofer Institute for Manufacturing Engineering
+ * and Automation (IPA) \n\n
+ *
+ *****************************************************************
+ *
+ * \note
+ * Project name: Care-O-bot
+ * \note
+ * ROS stack name: autopnp
+ * \note
+ * ROS package name: ipa_room_exploration
+ *
+ * \brief
+ *
+ *
+ *****************************************************************
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer. \n
+ * - Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution. \n
+ * - Neither the name of the Fraunhofer Institute for Manufacturing
+ * Engineering and Automation (IPA) nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission. \n
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************/
+
+#pragma once
+
+// This class stores the neurons of the artificial neural network used by the NeuralNetworkExplorator, see the paper
+//
+// Yang, Simon X., and Chaomin Luo. "A neural network approach to complete coverage path planning." IEEE Transactions on Systems, Man, and Cybernetics, Part B (Cybernetics) 34.1 (2004): 718-724.
+//
+// for reference. The states and the external inputs of all neurons are stored in contiguous arrays that span a regular
+// grid. This grid is surrounded by a border of neurons that always have the state 0, so each neuron can be updated with
+// the same fixed 8-neighborhood stencil, which is written s.t. the compiler can vectorize it. The states are double
+// buffered, i.e. each update computes the new states out of the states of the last time step. Optionally the rows are split into blocks that are updated in parallel.
+// Because the activity only changes around neurons whose external input changed, the states can also be updated locally:
+// then only the neurons inside a band around the neurons that changed more than a convergence threshold in the last time
+// step are updated, all other neurons are assumed to be converged. Only if this band grows too large, all neurons are
+// updated. The local update splits the rows of the updated region into blocks for parallel updates as well.
+//
+class NeuronGrid
+{
+protected:
+
+	// size of the grid and number of elements in one row of the arrays (including the border)
+	int rows_, columns_, stride_;
+
+	// states (activities) of the neurons, double buffered, current_ gives the buffer with the states of the current time step
+	std::vector<double> states_[2];
+	int current_;
+
+	// positive and negative part of the external input of each neuron, i.e. max(I,0) and max(-I,0)
+	std::vector<double> excitatory_inputs_, inhibitory_inputs_;
+
+	// booleans to check if a neuron is cleaned or an obstacle
+	std::vector<uchar> visited_, obstacle_;
+
+	// parameters used to update the states
+	double A_, B_, D_, E_;
+
+	// weights to the direct (left, right, top, bottom) and diagonal neighbors
+	double straight_weight_, diagonal_weight_;
+
+	// step size for updating the states
+	double step_size_;
+
+	// number of threads used to update the states
+	int number_of_threads_;
+
+	// bounding box of the neurons whose state changed more than the convergence threshold in the last local update or whose
+	// external input changed since then
+	cv::Rect changed_region_;
+
+	// index of a neuron in the arrays
+	inline int index(const int row, const int column) const
+	{
+		return (row+1)*stride_ + column+1;
+	}
+
+	// function to add a neuron to the region of changed neurons
+	void markAsChanged(const int row, const int column)
+	{
+		if(changed_region_.area() == 0)
+		{
+			changed_region_ = cv::Rect(column, row, 1, 1);
+			return;
+		}
+		const int first_row = std::min(changed_region_.y, row);
+		const int first_column = std::min(changed_region_.x, column);
+		const int last_row = std::max(changed_region_.y+changed_region_.height, row+1);
+		const int last_column = std::max(changed_region_.x+changed_region_.width, column+1);
+		changed_region_ = cv::Rect(first_column, first_row, last_column-first_column, last_row-first_row);
+	}
+
+	// function to set the external input of the neuron, +E for unvisited neurons, -E for obstacles and 0 otherwise
+	void updateInput(const int i)
+	{
+		double input = 0.0;
+		if(obstacle_[i] == true)
+			input = -1.0*E_;
+		else if(visited_[i] == false)
+			input = E_;
+		excitatory_inputs_[i] = std::max(input, 0.0);
+		inhibitory_inputs_[i] = std::max(-1.0*input, 0.0);
+	}
+
+	// function to compute the states of the next time step for the given rows and columns out of the states in the given
+	// buffer, using euler discretization
+	void updateRows(const int first_row, const int last_row, const int source, const int first_column=0, int last_column=-1)
+	{
+		if(last_column < 0)
+			last_column = columns_;
+		const double* states = &states_[source][0];
+		double* next_states = &states_[1-source][0];
+		for(int row=first_row; row<last_row; ++row)
+		{
+			const double* top = states + index(row-1, 0);
+			const double* middle = states + index(row, 0);
+			const double* bottom = states + index(row+1, 0);
+			const double* excitation = &excitatory_inputs_[index(row, 0)];
+			const double* inhibition = &inhibitory_inputs_[index(row, 0)];
+			double* next = next_states + index(row, 0);
+			for(int column=first_column; column<last_column; ++column)
+			{
+				// get the current sum of weights times the state of the neighbor
+				double weight_sum = 0;
+				weight_sum += diagonal_weight_*std::max(top[column-1], 0.0);
+				weight_sum += straight_weight_*std::max(top[column], 0.0);
+				weight_sum += diagonal_weight_*std::max(top[column+1], 0.0);
+				weight_sum += straight_weight_*std::max(middle[column-1], 0.0);
+				weight_sum += straight_weight_*std::max(middle[column+1], 0.0);
+				weight_sum += diagonal_weight_*std::max(bottom[column-1], 0.0);
+				weight_sum += straight_weight_*std::max(bottom[column], 0.0);
+				weight_sum += diagonal_weight_*std::max(bottom[column+1], 0.0);
+
+				// calculate current gradient --> see stated paper from the beginning
+				const double state = middle[column];
+				const double gradient = -A_*state + (B_-state)*(excitation[column] + weight_sum) - (D_+state)*inhibition[column];
+
+				// update state using euler method
+				next[column] = state + step_size_*gradient;
+			}
+		}
+	}
+
+	// function that updates a block of rows for the given number of iterations, the threads wait for each other after
+	// each iteration because the next one needs the states of the neighboring blocks
+	void updateRowBlock(const int first_row, const int last_row, const int iterations, boost::barrier& barrier)
+	{
+		int source = current_;
+		for(int iteration=0; iteration<iterations; ++iteration)
+		{
+			updateRows(first_row, last_row, source);
+			barrier.wait();
+			source = 1-source;
+		}
+	}
+
+public:
+
+	// constructor
+	NeuronGrid()
+	: rows_(0), columns_(0), stride_(2), current_(0), A_(0.), B_(0.), D_(0.), E_(0.), straight_weight_(0.), diagonal_weight_(0.),
+	  step_size_(0.), number_of_threads_(1)
+	{
+	}
+
+	// function to create a grid of free, unvisited neurons with the given distance between two neighboring neurons
+	void initialize(const int rows, const int columns, const int grid_spacing, double A, double B, double D, double E, double mu,
+			double step_size)
+	{
+		rows_ = rows;
+		columns_ = columns;
+		stride_ = columns+2;
+		const size_t size = (rows+2)*stride_;
+		states_[0].assign(size, 0.0);
+		states_[1].assign(size, 0.0);
+		current_ = 0;
+		visited_.assign(size, false);
+		obstacle_.assign(size, false);
+		excitatory_inputs_.assign(size, 0.0);
+		inhibitory_inputs_.assign(size, 0.0);
+		A_ = A;
+		B_ = B;
+		D_ = D;
+		E_ = E;
+		step_size_ = step_size;
+
+		// calculate the weights out of the distances to the neighbors
+		straight_weight_ = mu/cv::norm(cv::Point(grid_spacing, 0));
+		diagonal_weight_ = mu/cv::norm(cv::Point(grid_spacing, grid_spacing));
+
+		// set the external inputs of the neurons inside the grid
+		for(int row=0; row<rows_; ++row)
+			for(int column=0; column<columns_; ++column)
+				updateInput(index(row, column));
+		changed_region_ = cv::Rect(0, 0, columns_, rows_);
+	}
+
+	// function to set the number of threads that update the states
+	void setNumberOfThreads(const int number_of_threads)
+	{
+		number_of_threads_ = std::max(1, number_of_threads);
+	}
+
+	// size of the grid
+	int rows() const
+	{
+		return rows_;
+	}
+	int columns() const
+	{
+		return columns_;
+	}
+
+	// function to get the state of a neuron
+	double getState(const int row, const int column) const
+	{
+		return states_[current_][index(row, column)];
+	}
+
+	// function to mark a neuron as obstacle
+	void markAsObstacle(const int row, const int column)
+	{
+		const int i = index(row, column);
+		obstacle_[i] = true;
+		updateInput(i);
+		markAsChanged(row, column);
+	}
+
+	// function to mark a neuron as cleaned
+	void markAsVisited(const int row, const int column)
+	{
+		const int i = index(row, column);
+		visited_[i] = true;
+		updateInput(i);
+		markAsChanged(row, column);
+	}
+
+	// function to check if a neuron is an obstacle or not
+	bool isObstacle(const int row, const int column) const
+	{
+		return obstacle_[index(row, column)];
+	}
+
+	// function to check if a neuron has been visited or not
+	bool visitedNeuron(const int row, const int column) const
+	{
+		return visited_[index(row, column)];
+	}
+
+	// function to update the states of all neurons for the given number of time steps
+	void updateStates(const int iterations)
+	{
+		// all states may change
+		changed_region_ = cv::Rect(0, 0, columns_, rows_);
+
+		// only use several threads if each gets a reasonable amount of rows
+		const int number_of_threads = std::min(number_of_threads_, rows_/8);
+		if(number_of_threads <= 1)
+		{
+			for(int iteration=0; iteration<iterations; ++iteration)
+			{
+				updateRows(0, rows_, current_);
+				current_ = 1-current_;
+			}
+			return;
+		}
+
+		// split the rows into blocks and update each block in its own thread
+		boost::barrier barrier(number_of_threads);
+		boost::thread_group threads;
+		for(int thread=0; thread<number_of_threads; ++thread)
+		{
+			const int first_row = (thread*rows_)/number_of_threads;
+			const int last_row = ((thread+1)*rows_)/number_of_threads;
+			threads.create_thread(boost::bind(&NeuronGrid::updateRowBlock, this, first_row, last_row, iterations, boost::ref(barrier)));
+		}
+		threads.join_all();
+		current_ = (current_+iterations)%2;
+	}
+
+	// function to update the states for the given number of time steps, only updating the neurons around the neurons that
+	// changed by more than the convergence threshold in the previous time step, if this band contains more than the given
+	// fraction of all neurons, all neurons get updated
+	void updateStatesLocally(const int iterations, const double convergence_threshold, const double max_local_fraction=0.5)
+	{
+		// only use several threads if each gets a reasonable amount of rows
+		const int number_of_threads = std::min(number_of_threads_, rows_/8);
+		if(number_of_threads <= 1)
+		{
+			for(int iteration=0; iteration<iterations && changed_region_.area()!=0; ++iteration)
+			{
+				const cv::Rect region = getLocalRegion(max_local_fraction);
+				updateRows(region.y, region.y+region.height, current_, region.x, region.x+region.width);
+				changed_region_ = copyLocalStates(region, region.y, region.y+region.height, convergence_threshold);
+			}
+			return;
+		}
+
+		// split the rows of the updated region into blocks and update each block in its own thread
+		boost::barrier barrier(number_of_threads);
+		boost::thread_group threads;
+		std::vector<cv::Rect> changed_regions(number_of_threads);
+		for(int thread=0; thread<number_of_threads; ++thread)
+			threads.create_thread(boost::bind(&NeuronGrid::updateRegionBlockLocally, this, thread, number_of_threads, iterations,
+					convergence_threshold, max_local_fraction, boost::ref(changed_regions), boost::ref(barrier)));
+		threads.join_all();
+	}
+
+protected:
+
+	// function to get the region of the next local update, i.e. the changed neurons and their neighbors or the whole grid if
+	// this region contains more than the given fraction of all neurons
+	cv::Rect getLocalRegion(const double max_local_fraction) const
+	{
+		const cv::Rect grid(0, 0, columns_, rows_);
+		cv::Rect region(changed_region_.x-1, changed_region_.y-1, changed_region_.width+2, changed_region_.height+2);
+		region &= grid;
+		if(region.area() > max_local_fraction*grid.area())
+			region = grid;
+		return region;
+	}
+
+	// function to copy the new states of the given rows of the region back to the current buffer, s.t. both buffers stay equal
+	// outside of the updated region, returns the bounding box of the neurons that changed more than the threshold
+	cv::Rect copyLocalStates(const cv::Rect& region, const int first_row, const int last_row, const double convergence_threshold)
+	{
+		const int first_column = region.x, last_column = region.x+region.width;
+		int min_row = rows_, max_row = -1, min_column = columns_, max_column = -1;
+		for(int row=first_row; row<last_row; ++row)
+		{
+			double* states = &states_[current_][index(row, 0)];
+			const double* next_states = &states_[1-current_][index(row, 0)];
+			for(int column=first_column; column<last_column; ++column)
+			{
+				if(std::abs(next_states[column]-states[column]) > convergence_threshold)
+				{
+					min_row = std::min(min_row, row);
+					max_row = std::max(max_row, row);
+					min_column = std::min(min_column, column);
+					max_column = std::max(max_column, column);
+				}
+				states[column] = next_states[column];
+			}
+		}
+		if(max_row < 0)
+			return cv::Rect();
+		return cv::Rect(min_column, min_row, max_column-min_column+1, max_row-min_row+1);
+	}
+
+	// function that locally updates a block of rows of the updated region for the given number of iterations, the threads
+	// wait for each other after computing and after copying the new states, then the first thread merges the changed regions
+	// of all blocks, which gives the region of the next iteration
+	void updateRegionBlockLocally(const int thread, const int number_of_threads, const int iterations, const double convergence_threshold,
+			const double max_local_fraction, std::vector<cv::Rect>& changed_regions, boost::barrier& barrier)
+	{
+		for(int iteration=0; iteration<iterations && changed_region_.area()!=0; ++iteration)
+		{
+			const cv::Rect region = getLocalRegion(max_local_fraction);
+			const int first_row = region.y + (thread*region.height)/number_of_threads;
+			const int last_row = region.y + ((thread+1)*region.height)/number_of_threads;
+			updateRows(first_row, last_row, current_, region.x, region.x+region.width);
+			barrier.wait();
+			changed_regions[thread] = copyLocalStates(region, first_row, last_row, convergence_threshold);
+			barrier.wait();
+			if(thread == 0)
+			{
+				changed_region_ = cv::Rect();
+				for(size_t block=0; block<changed_regions.size(); ++block)
+				{
+					const cv::Rect& changed_block = changed_regions[block];
+					if(changed_block.area() == 0)
+						continue;
+					markAsChanged(changed_block.y, changed_block.x);
+					markAsChanged(changed_block.y+changed_block.height-1, changed_block.x+changed_block.width-1);
+				}
+			}
+			barrier.wait();
+		}
+	}
+};
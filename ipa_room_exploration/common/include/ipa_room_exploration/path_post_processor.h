@@ -0,0 +1,320 @@
+/*!
+ *****************************************************************
+ * \file
+ *
+ * \note
+ * Copyright (c) 2026 \n
+ * Fraunhofer Institute for Manufacturing Engineering
+ * and Automation (IPA) \n\n
+ *
+ *****************************************************************
+ *
+ * \note
+ * Project name: Care-O-bot
+ * \note
+ * ROS stack name: autopnp
+ * \note
+ * ROS package name: ipa_room_exploration
+ *
+ * \brief
+ *
+ *
+ *****************************************************************
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer. \n
+ * - Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution. \n
+ * - Neither the name of the Fraunhofer Institute for Manufacturing
+ * Engineering and Automation (IPA) nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission. \n
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <cmath>
+
+#include <opencv2/opencv.hpp>
+
+#include <geometry_msgs/Pose2D.h>
+
+
+// Post-processing of computed coverage paths. The path passes a configurable sequence of stages, always in this order:
+//  1. rotation back from the rotated room map into the original map (inverse of the affine transform R used for rotating the room)
+//  2. downsampling: a pose is dropped if it is not farther than min_distance from the last kept pose, unless the path turns there by more than min_angle
+//  3. removal of collinear poses, i.e. poses that deviate less than max_deviation from the line between the last kept and the next pose
+//  4. smoothing of corners, each corner pose is moved towards its neighbors by at most max_displacement
+//  5. orientation of the poses along the path (poses at the same location as their predecessor are dropped), this stage always runs,
+//     optionally it runs directly after stage 1 so that the angles follow the dense path and are kept by the later stages
+//  6. transformation from pixel coordinates into world coordinates
+// All distances are provided in [pixel] of the map that the path is planned in, angles in [rad]. All stages work in place on the output
+// vector, which is allocated only once, so that even paths with several 100000 poses are processed without any temporary copies.
+class PathPostProcessor
+{
+protected:
+	bool rotate_back_;				// if true, the path is transformed with R_inv_
+	cv::Mat R_inv_;					// inverse of the room rotation, 2x3 matrix of type CV_64F
+	double min_distance_;			// minimum distance between two successive poses in [pixel], <0 deactivates downsampling
+	double min_angle_;				// turning angle in [rad] from which poses are kept regardless of min_distance_, <0 deactivates this criterion
+	double max_collinear_deviation_;	// maximum distance of a removed pose from the line through its neighbors in [pixel], <0 deactivates removal
+	double max_smoothing_displacement_;	// maximum shift of a pose by the smoothing in [pixel], <=0 deactivates smoothing
+	bool orientation_before_downsampling_;	// if true, the angles are computed on the dense path before stage 2 and kept afterwards
+	bool transform_to_world_;		// if true, the poses are converted from [pixel] to [m] with map_resolution_ and map_origin_
+	double map_resolution_;			// in [m/pixel]
+	cv::Point2d map_origin_;		// in [m]
+
+	// stage 1, applies R_inv_ to all poses starting at index begin
+	void rotateBack(std::vector<geometry_msgs::Pose2D>& poses, const size_t begin) const
+	{
+		const double* r0 = R_inv_.ptr<double>(0);
+		const double* r1 = R_inv_.ptr<double>(1);
+		for (size_t i=begin; i<poses.size(); ++i)
+		{
+			const double x = poses[i].x;
+			const double y = poses[i].y;
+			poses[i].x = r0[0]*x + r0[1]*y + r0[2];
+			poses[i].y = r1[0]*x + r1[1]*y + r1[2];
+		}
+	}
+
+	// stage 2, the first and the last pose are always kept
+	void downsample(std::vector<geometry_msgs::Pose2D>& poses, const size_t begin) const
+	{
+		const size_t end = poses.size();
+		if (end-begin < 3)
+			return;
+		const double min_distance_squared = min_distance_*min_distance_;
+		size_t kept = begin+1;
+		for (size_t i=begin+1; i<end; ++i)
+		{
+			const double dx = poses[i].x - poses[kept-1].x;
+			const double dy = poses[i].y - poses[kept-1].y;
+			bool keep = (dx*dx+dy*dy > min_distance_squared || i==end-1);
+			if (keep==false && min_angle_>=0.)
+			{
+				// poses[i+1] is not overwritten yet since kept<=i
+				const double dx_next = poses[i+1].x - poses[i].x;
+				const double dy_next = poses[i+1].y - poses[i].y;
+				if ((dx!=0. || dy!=0.) && (dx_next!=0. || dy_next!=0.))
+					keep = (std::fabs(std::atan2(dx*dy_next - dy*dx_next, dx*dx_next + dy*dy_next)) > min_angle_);
+			}
+			if (keep == true)
+				poses[kept++] = poses[i];
+		}
+		poses.resize(kept);
+	}
+
+	// stage 3, a pose is removed if it lies between the last kept pose and its successor and is closer than max_collinear_deviation_
+	// to the line connecting both
+	void removeCollinearPoses(std::vector<geometry_msgs::Pose2D>& poses, const size_t begin) const
+	{
+		const size_t end = poses.size();
+		if (end-begin < 3)
+			return;
+		size_t kept = begin+1;
+		for (size_t i=begin+1; i<end; ++i)
+		{
+			bool keep = true;
+			if (i+1 < end)
+			{
+				const double lx = poses[i+1].x - poses[kept-1].x;
+				const double ly = poses[i+1].y - poses[kept-1].y;
+				const double px = poses[i].x - poses[kept-1].x;
+				const double py = poses[i].y - poses[kept-1].y;
+				const double length_squared = lx*lx + ly*ly;
+				const double projection = px*lx + py*ly;
+				if (length_squared > 0. && projection >= 0. && projection <= length_squared)
+				{
+					const double cross = lx*py - ly*px;
+					keep = (cross*cross > max_collinear_deviation_*max_collinear_deviation_*length_squared);
+				}
+			}
+			if (keep == true)
+				poses[kept++] = poses[i];
+		}
+		poses.resize(kept);
+	}
+
+	// stage 4, moves each inner pose towards the weighted mean 1/4*previous + 1/2*current + 1/4*next of the unsmoothed path, the shift
+	// is limited to max_smoothing_displacement_ so that corners are only rounded and the path cannot leave the covered area noticeably
+	void smoothCorners(std::vector<geometry_msgs::Pose2D>& poses, const size_t begin) const
+	{
+		const size_t end = poses.size();
+		if (end-begin < 3)
+			return;
+		double previous_x = poses[begin].x, previous_y = poses[begin].y;	// unsmoothed position of the previous pose
+		for (size_t i=begin+1; i+1<end; ++i)
+		{
+			const double x = poses[i].x;
+			const double y = poses[i].y;
+			double shift_x = 0.25*(previous_x + poses[i+1].x) - 0.5*x;
+			double shift_y = 0.25*(previous_y + poses[i+1].y) - 0.5*y;
+			const double shift_squared = shift_x*shift_x + shift_y*shift_y;
+			if (shift_squared > max_smoothing_displacement_*max_smoothing_displacement_)
+			{
+				const double scale = max_smoothing_displacement_/std::sqrt(shift_squared);
+				shift_x *= scale;
+				shift_y *= scale;
+			}
+			poses[i].x = x + shift_x;
+			poses[i].y = y + shift_y;
+			previous_x = x;
+			previous_y = y;
+		}
+	}
+
+	// stage 5, the angle of each pose is the direction from the previous pose, the first pose looks towards the second,
+	// poses without a direction (same location as the predecessor or single pose paths) are dropped
+	void computeOrientations(std::vector<geometry_msgs::Pose2D>& poses, const size_t begin) const
+	{
+		const size_t end = poses.size();
+		size_t kept = begin;
+		double previous_x = 0., previous_y = 0.;	// location of the previous pose before compaction
+		for (size_t i=begin; i<end; ++i)
+		{
+			const double x = poses[i].x;
+			const double y = poses[i].y;
+			double dx = 0., dy = 0.;
+			if (i > begin)
+			{
+				dx = x - previous_x;
+				dy = y - previous_y;
+			}
+			else if (end-begin >= 2)
+			{
+				dx = poses[i+1].x - x;
+				dy = poses[i+1].y - y;
+			}
+			previous_x = x;
+			previous_y = y;
+			if (dx!=0. || dy!=0.)
+			{
+				poses[kept].x = x;
+				poses[kept].y = y;
+				poses[kept].theta = std::atan2(dy, dx);
+				++kept;
+			}
+		}
+		poses.resize(kept);
+	}
+
+	// stage 6
+	void transformToWorld(std::vector<geometry_msgs::Pose2D>& poses, const size_t begin) const
+	{
+		for (size_t i=begin; i<poses.size(); ++i)
+		{
+			poses[i].x = poses[i].x*map_resolution_ + map_origin_.x;
+			poses[i].y = poses[i].y*map_resolution_ + map_origin_.y;
+		}
+	}
+
+	// runs all activated stages on the poses starting at index begin, which contain the locations of the input path
+	void processInPlace(std::vector<geometry_msgs::Pose2D>& poses, const size_t begin) const
+	{
+		if (rotate_back_ == true)
+			rotateBack(poses, begin);
+		if (orientation_before_downsampling_ == true)
+			computeOrientations(poses, begin);
+		if (min_distance_ >= 0.)
+			downsample(poses, begin);
+		if (max_collinear_deviation_ >= 0.)
+			removeCollinearPoses(poses, begin);
+		if (max_smoothing_displacement_ > 0.)
+			smoothCorners(poses, begin);
+		if (orientation_before_downsampling_ == false)
+			computeOrientations(poses, begin);
+		if (transform_to_world_ == true)
+			transformToWorld(poses, begin);
+	}
+
+public:
+	PathPostProcessor()
+	: rotate_back_(false), min_distance_(-1.), min_angle_(-1.), max_collinear_deviation_(-1.), max_smoothing_displacement_(-1.),
+	  orientation_before_downsampling_(false), transform_to_world_(false), map_resolution_(1.), map_origin_(0., 0.)
+	{
+	}
+
+	// transforms the path back from the rotated room map, R is the affine transform that was used for rotating the room
+	void setRotationBack(const cv::Mat& R)
+	{
+		cv::Mat R_inv;
+		cv::invertAffineTransform(R, R_inv);
+		R_inv.convertTo(R_inv_, CV_64F);
+		rotate_back_ = true;
+	}
+
+	// min_distance in [pixel], min_angle in [rad] (<0 keeps only poses farther than min_distance)
+	void setDownsampling(const double min_distance, const double min_angle=-1.)
+	{
+		min_distance_ = min_distance;
+		min_angle_ = min_angle;
+	}
+
+	// max_deviation in [pixel], 0 removes only exactly collinear poses
+	void setCollinearRemoval(const double max_deviation)
+	{
+		max_collinear_deviation_ = max_deviation;
+	}
+
+	// max_displacement in [pixel], 0 deactivates the smoothing (default)
+	void setSmoothing(const double max_displacement)
+	{
+		max_smoothing_displacement_ = max_displacement;
+	}
+
+	// if true, each pose keeps the direction from its predecessor on the dense path instead of the direction from the last kept pose
+	void setOrientationBeforeDownsampling(const bool orientation_before_downsampling)
+	{
+		orientation_before_downsampling_ = orientation_before_downsampling;
+	}
+
+	// converts the final poses from [pixel] into [m], map_resolution in [m/pixel], map_origin in [m]
+	void setWorldTransform(const double map_resolution, const cv::Point2d& map_origin)
+	{
+		map_resolution_ = map_resolution;
+		map_origin_ = map_origin;
+		transform_to_world_ = true;
+	}
+
+	// processes the point path and appends the resulting poses to pose_path
+	template <typename PointT>
+	void process(const std::vector<PointT>& point_path, std::vector<geometry_msgs::Pose2D>& pose_path) const
+	{
+		const size_t begin = pose_path.size();
+		pose_path.resize(begin + point_path.size());
+		for (size_t i=0; i<point_path.size(); ++i)
+		{
+			pose_path[begin+i].x = point_path[i].x;
+			pose_path[begin+i].y = point_path[i].y;
+			pose_path[begin+i].theta = 0.;
+		}
+		processInPlace(pose_path, begin);
+	}
+
+	// processes the path in place, the locations are read from pose_path and the angles are recomputed
+	void process(std::vector<geometry_msgs::Pose2D>& pose_path) const
+	{
+		processInPlace(pose_path, 0);
+	}
+};
@@ -0,0 +1,243 @@
+/*!
+ *****************************************************************
+ * \file
+ *
+ * \note
+ * Copyright (c) 2026 \n
+ * Fraunhofer Institute for Manufacturing Engineering
+ * and Automation (IPA) \n\n
+ *
+ *****************************************************************
+ *
+ * \note
+ * Project name: Care-O-bot
+ * \note
+ * ROS stack name: autopnp
+ * \note
+ * ROS package name: ipa_room_exploration
+ *
+ * \brief
+ *
+ *
+ *****************************************************************
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer. \n
+ * - Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution. \n
+ * - Neither the name of the Fraunhofer Institute for Manufacturing
+ * Engineering and Automation (IPA) nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission. \n
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <cmath>
+
+#pragma once
+
+#include <vector>
+#include <iostream>
+#include <cmath>
+
+#include <opencv2/opencv.hpp>
+
+#include <Eigen/Dense>
+
+#include <boost/thread.hpp>
+
+#include <geometry_msgs/Pose2D.h>
+#include <geometry_msgs/Point32.h>
+
+#include <ipa_building_navigation/tsp_solver_defines.h>
+#include <ipa_room_exploration/grid_point_explorator.h>
+#include <ipa_room_exploration/boustrophedon_explorator.h>
+#include <ipa_room_exploration/neural_network_explorator.h>
+#include <ipa_room_exploration/convex_sensor_placement_explorator.h>
+#include <ipa_room_exploration/flow_network_explorator.h>
+#include <ipa_room_exploration/energy_functional_explorator.h>
+#include <ipa_room_exploration/path_post_processor.h>
+#include <ipa_room_exploration/fov_to_robot_mapper.h>
+#include <ipa_room_exploration/multi_resolution_coverage_planner.h>
+
+
+// the set of planner objects that is needed to plan one room, each planning thread needs its own set
+struct ExplorationPlanners
+{
+	GridPointExplorator grid_point_planner; // object that uses the grid point method to plan a path trough a room
+	BoustrophedonExplorer boustrophedon_explorer; // object that uses the boustrophedon exploration method to plan a path trough the room
+	NeuralNetworkExplorator neural_network_explorator; // object that uses the neural network method to create an exploration path
+	convexSPPExplorator convex_SPP_explorator; // object that uses the convex spp exploration methd to create an exploration path
+	FlowNetworkExplorator flow_network_explorator; // object that uses the flow network exploration method to create an exploration path
+	EnergyFunctionalExplorator energy_functional_explorator; // object that uses the energy functional exploration method to create an exploration path
+	BoustrophedonVariantExplorer boustrophedon_variant_explorer; // object that uses the boustrophedon variant exploration method to plan a path trough the room
+};
+
+// the algorithm and the parameters of the coverage path planners, a planning call only reads its own copy of them
+struct RoomExplorationPlannerParameters
+{
+	int room_exploration_algorithm;	// variable to specify which algorithm is going to be used to plan a path
+									// 1: grid point explorator
+									// 2: boustrophedon explorator
+									// 3: neural network explorator
+									// 4: convexSPP explorator
+									// 5: flowNetwork explorator
+									// 6: energyFunctional explorator
+									// 7: Voronoi explorator
+									// 8: boustrophedon variant explorator
+
+	// parameters on map correction
+	int map_correction_closing_neighborhood_size;	// Applies a closing operation to neglect inaccessible areas and map errors/artifacts if the
+													// map_correction_closing_neighborhood_size parameter is larger than 0.
+													// The parameter then specifies the iterations (or neighborhood size) of that closing operation.
+
+	// parameters of the multi-resolution planning
+	int multi_resolution_factor;	// if > 1, the room is planned on a map downsampled by this factor and refined at full resolution afterwards
+	double multi_resolution_max_uncovered_ratio;	// maximum ratio of the room area that may stay uncovered after the refinement, else the room is planned at full resolution
+
+	// parameters specific to the grid point explorator
+	int tsp_solver;	// indicates which TSP solver should be used
+					//   1 = Nearest Neighbor
+					//   2 = Genetic solver
+					//   3 = Concorde solver
+	int64_t tsp_solver_timeout;	// a sophisticated solver like Concorde or Genetic can be interrupted if it does not find a solution within this time, in [s], and then falls back to the nearest neighbor solver
+
+	// parameters specific for the boustrophedon explorator
+	double min_cell_area;			// minimal area a cell can have, when using the boustrophedon explorator
+	double path_eps;		// the distance between points when generating a path
+	double grid_obstacle_offset;	// in [m], the additional offset of the grid to obstacles, i.e. allows to displace the grid by more than the standard half_grid_size from obstacles
+	int max_deviation_from_track;	// in [pixel], maximal allowed shift off the ideal boustrophedon track to both sides for avoiding obstacles on track
+									// setting max_deviation_from_track=grid_spacing is usually a good choice
+									// for negative values (e.g. max_deviation_from_track: -1) max_deviation_from_track is automatically set to grid_spacing
+	int cell_visiting_order;		// cell visiting order
+									//   1 = optimal visiting order of the cells determined as TSP problem
+									//   2 = alternative ordering from left to right (measured on y-coordinates of the cells), visits the cells in a more obvious fashion to the human observer (though it is not optimal)
+
+	// parameters specific for the neural network explorator, see "A Neural Network Approach to Complete Coverage Path Planning" from Simon X. Yang and Chaomin Luo
+	double step_size; // step size for integrating the state dynamics
+	int A; // decaying parameter that pulls the activity of a neuron closer to zero, larger value means faster decreasing
+	int B; // increasing parameter that tries to increase the activity of a neuron when it's not too big already, higher value means a higher desired value and a faster increasing at the beginning
+	int D; // decreasing parameter when the neuron is labeled as obstacle, higher value means faster decreasing
+	int E; // external input parameter of one neuron that is used in the dynamics corresponding to if it is an obstacle or uncleaned/cleaned, E>>B
+	double mu; // parameter to set the importance of the states of neighboring neurons to the dynamics, higher value means higher influence
+	double delta_theta_weight; // parameter to set the importance of the traveleing direction from the previous step and the next step, a higher value means that the robot should turn less
+	int number_of_threads; // number of threads that update the states of the neural network in parallel, each thread gets a block of rows of the network
+	double neural_network_update_threshold; // state changes below this threshold count as converged, so only the neurons around the last step get updated, <= 0 updates the whole network after each step
+
+	// parameters specific for the convexSPP explorator
+	int cell_size;				// size of one cell that is used to discretize the free space, <= 0 uses the grid spacing
+	double delta_theta;			// sampling angle when creating possible sensing poses in the convexSPP explorator
+
+	// parameters specific for the flowNetwork explorator
+	double curvature_factor; // double that shows the factor, an arc can be longer than a straight arc when using the flowNetwork explorator
+	double max_distance_factor; // double that shows how much an arc can be longer than the maximal distance of the room, which is determined by the min/max coordinates that are set in the goal
+	bool use_cut_generator; // if true, the Cbc solver also adds the cycle prevention constraints as cuts during the branch and bound
+
+	RoomExplorationPlannerParameters()
+	: room_exploration_algorithm(1), map_correction_closing_neighborhood_size(2), multi_resolution_factor(1), multi_resolution_max_uncovered_ratio(0.05),
+	  tsp_solver(TSP_CONCORDE), tsp_solver_timeout(600), min_cell_area(10.), path_eps(2.), grid_obstacle_offset(0.), max_deviation_from_track(-1),
+	  cell_visiting_order(1), step_size(0.008), A(17), B(5), D(7), E(80), mu(1.03), delta_theta_weight(0.15), number_of_threads(1),
+	  neural_network_update_threshold(0.), cell_size(0), delta_theta(1.570796), curvature_factor(1.1), max_distance_factor(1.0),
+	  use_cut_generator(true)
+	{
+	}
+};
+
+// Plans coverage paths with the algorithm selected in RoomExplorationPlannerParameters, either for a single preprocessed room map or
+// for a batch of rooms of a labeled segmented map. For a batch, the rooms are cut out of the segmented map and preprocessed by the
+// planning threads themselves, which take the rooms one after another from a shared job. The field of view geometry and the grid spacing
+// are computed once for all rooms. All functions only read the parameters that are passed with the call, so they can be used without
+// the action server and the parameters may change between calls without affecting a running planning.
+class RoomExplorationPlanner
+{
+protected:
+	// the shared data of one batch planning call, defined in the source file
+	struct BatchJob;
+
+	// worker of the batch planning, takes rooms from the job until all are planned
+	void planRoomsOfBatchJob(BatchJob* job) const;
+
+	// function object that calls planCoveragePath with the fixed parameters of one room, used as planning function of the MultiResolutionCoveragePlanner
+	struct CoveragePathPlanningFunction
+	{
+		const RoomExplorationPlanner* planner;
+		const RoomExplorationPlannerParameters* parameters;
+		int planning_mode;
+		const Eigen::Matrix<float, 2, 1>* fitting_circle_center_point_in_meter;
+		const std::vector<Eigen::Matrix<float, 2, 1> >* fov_corners_meter;
+		double coverage_radius;
+		double robot_radius;
+		ExplorationPlanners* planners;
+
+		void operator()(const cv::Mat& room_map, std::vector<geometry_msgs::Pose2D>& path, const float map_resolution, const cv::Point& starting_position,
+				const cv::Point2d& map_origin, const double grid_spacing_in_pixel, const int cell_size) const;
+	};
+
+public:
+	enum PlanningMode {PLAN_FOR_FOOTPRINT=1, PLAN_FOR_FOV=2};
+
+	RoomExplorationPlanner()
+	{
+	}
+
+	// applies the closing operation for map correction and removes the unconnected parts of the room, returns false if the room is empty afterwards
+	static bool preprocessRoomMap(cv::Mat& room_map, const int closing_neighborhood_size);
+
+	// remove unconnected, i.e. inaccessible, parts of the room (i.e. obstructed by furniture), only keep the room with the largest area
+	static bool removeUnconnectedRoomParts(cv::Mat& room_map);
+
+	// computes the grid spacing in [pixel] that fits into the coverage radius or field of view, and the field of view geometry
+	static void computeGridSpacing(const int planning_mode, const std::vector<geometry_msgs::Point32>& field_of_view, const double coverage_radius,
+			const float map_resolution, double& grid_spacing_in_pixel, Eigen::Matrix<float, 2, 1>& fitting_circle_center_point_in_meter,
+			std::vector<Eigen::Matrix<float, 2, 1> >& fov_corners_meter);
+
+	// plans the coverage path through the preprocessed room_map with the configured algorithm, the path is returned in [meter,meter,rad]
+	// planners has to be used by one thread at a time only
+	void planCoveragePath(const cv::Mat& room_map, std::vector<geometry_msgs::Pose2D>& exploration_path, const float map_resolution,
+			const cv::Point& starting_position, const cv::Point2d& map_origin, const int planning_mode, const double grid_spacing_in_pixel,
+			const Eigen::Matrix<float, 2, 1>& fitting_circle_center_point_in_meter, const std::vector<Eigen::Matrix<float, 2, 1> >& fov_corners_meter,
+			const double coverage_radius, const double robot_radius, const int cell_size, const RoomExplorationPlannerParameters& parameters,
+			ExplorationPlanners& planners) const;
+
+	// plans the coverage path like planCoveragePath, on a downsampled map with local refinement if parameters.multi_resolution_factor > 1
+	void planCoveragePathMultiResolution(const cv::Mat& room_map, std::vector<geometry_msgs::Pose2D>& exploration_path, const float map_resolution,
+			const cv::Point& starting_position, const cv::Point2d& map_origin, const int planning_mode, const double grid_spacing_in_pixel,
+			const Eigen::Matrix<float, 2, 1>& fitting_circle_center_point_in_meter, const std::vector<Eigen::Matrix<float, 2, 1> >& fov_corners_meter,
+			const Eigen::Matrix<float, 2, 1>& fov_origin, const double coverage_radius, const double robot_radius, const int cell_size,
+			const RoomExplorationPlannerParameters& parameters, ExplorationPlanners& planners) const;
+
+	// plans the coverage paths of several rooms of a segmented map in parallel
+	// segmented_map: labeled map (CV_32SC1), room_ids: labels of the rooms that shall be planned
+	// starting_positions: starting position of each room in [m], if the number does not match room_ids the room centers are used
+	// field_of_view: corners of the field of view in robot coordinates in [m], only used with planning_mode PLAN_FOR_FOV
+	// fov_origin: mounting position of the sensor spanning the field of view in robot coordinates in [m]
+	// number_of_planning_threads: number of rooms that are planned in parallel, <= 0 uses one thread per available cpu core
+	// coverage_paths: the path of each room in [m,m,rad] in the order of room_ids, empty for rooms that could not be planned
+	// returns the number of rooms with a non-empty coverage path
+	int planRooms(const cv::Mat& segmented_map, const std::vector<int>& room_ids, const std::vector<cv::Point2d>& starting_positions,
+			const float map_resolution, const cv::Point2d& map_origin, const int planning_mode, const std::vector<geometry_msgs::Point32>& field_of_view,
+			const Eigen::Matrix<float, 2, 1>& fov_origin, const double coverage_radius, const double robot_radius,
+			const RoomExplorationPlannerParameters& parameters, const int number_of_planning_threads,
+			std::vector<std::vector<geometry_msgs::Pose2D> >& coverage_paths) const;
+};
@@ -60,17 +60,40 @@
 #pragma once
 
 #include <ipa_room_exploration/histogram.h>
+#include <ipa_room_exploration/path_post_processor.h>
 
 #include <opencv2/opencv.hpp>
 #include <opencv2/highgui/highgui.hpp>
 
 #include <vector>
+#include <map>
+
+#include <boost/cstdint.hpp>
+#include <boost/thread/mutex.hpp>
 
 #include <geometry_msgs/Pose2D.h>
 
 
 class RoomRotator
 {
+protected:
+	// cached main direction of one map, size and resolution of the map are stored to reject hash matches of different maps
+	struct MainDirectionCacheEntry
+	{
+		int rows;
+		int cols;
+		double map_resolution;	// in [m/pixel]
+		double main_direction;	// in [rad]
+	};
+
+	// main directions of already processed maps, the key is a hash of the map and the map resolution, shared by all planners
+	// (the map content is not compared, a collision of the 64 bit hash between two maps of the same size and resolution is accepted)
+	static std::map<boost::uint64_t, MainDirectionCacheEntry> main_direction_cache_;
+	static boost::mutex main_direction_cache_mutex_;
+
+	// computes a hash of the map content, its size and the map resolution that is used as key in main_direction_cache_
+	static boost::uint64_t computeMapHash(const cv::Mat& room_map, const double map_resolution);
+
 public:
 	RoomRotator()
 	{
@@ -88,6 +111,7 @@ public:
 
 	// computes the major direction of the walls from a map (preferably one room)
 	// the map (room_map, CV_8UC1) is black (0) at impassable areas and white (255) on drivable areas
+	// the result is cached, so calling it again with the same map returns without recomputation
 	double computeRoomMainDirection(const cv::Mat& room_map, const double map_resolution);
 
 	// transforms a vector of points back to the original map and generates poses
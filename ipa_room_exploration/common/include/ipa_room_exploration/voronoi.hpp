@@ -24,6 +24,7 @@
 #include <boost/shared_ptr.hpp>
 #include <vector>
 #include <queue>
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -103,7 +104,7 @@ struct Pos {
 	
 };
 
-std::ostream &operator<<(std::ostream &os, const Pos &p) {
+inline std::ostream &operator<<(std::ostream &os, const Pos &p) {
 	return os<<p.x_<<","<<p.y_;
 }
 
@@ -278,6 +279,67 @@ struct pless : public std::binary_function<Type *, Type *, bool> {
 		}
 };
 
+//* Bucket queue (Dial's algorithm) for the wavefronts over the integer squared distances of the cells
+//  returns the cells in the same order as a priority queue with pless (smallest squared distance first, ties by position)
+//  as long as the squared distance of a queued cell is not changed, otherwise the cell is returned at its old distance
+class CellBucketQueue {
+	std::vector<std::vector<Cell*> > buckets_;	///< queued cells by squared distance, a bucket is sorted (descending positions) once it is reached
+	std::vector<char> sorted_;	///< true if the bucket is sorted
+	size_t current_;			///< all buckets below are empty
+	size_t size_;				///< number of queued cells
+	
+	static inline bool greaterPos(const Cell *a, const Cell *b) {
+		if(a->pos_.x_==b->pos_.x_)
+			return a->pos_.y_>b->pos_.y_;
+		return a->pos_.x_>b->pos_.x_;
+	}
+	
+	/*!
+	 * \brief moves to the first non-empty bucket and sorts it if necessary (queue must not be empty)
+	 */
+	inline std::vector<Cell*> &first() {
+		while(buckets_[current_].empty()) ++current_;
+		if(!sorted_[current_]) {
+			std::sort(buckets_[current_].begin(), buckets_[current_].end(), greaterPos);
+			sorted_[current_] = 1;
+		}
+		return buckets_[current_];
+	}
+	
+public:
+	CellBucketQueue() : current_(0), size_(0)
+	{}
+	
+	inline size_t size() const {return size_;}
+	inline bool empty() const {return size_==0;}
+	
+	inline void push(Cell *c) {
+		const size_t d = c->dist2();
+		if(d>=buckets_.size()) {
+			buckets_.resize(d+1);
+			sorted_.resize(d+1, 0);
+		}
+		std::vector<Cell*> &b = buckets_[d];
+		if(sorted_[d])	//bucket was reached before and is not empty yet
+			b.insert(std::upper_bound(b.begin(), b.end(), c, greaterPos), c);
+		else
+			b.push_back(c);
+		current_ = std::min(current_, d);
+		++size_;
+	}
+	
+	inline Cell *top() {
+		return first().back();
+	}
+	
+	inline void pop() {
+		std::vector<Cell*> &b = first();
+		b.pop_back();
+		if(b.empty()) sorted_[current_] = 0;	//later pushes are collected unsorted again
+		--size_;
+	}
+};
+
 //* Helper class for finding nearest neighbours
 template <typename T>
 struct PointCloud
@@ -357,7 +419,11 @@ struct TSPTour {
 	
 	inline size_t size() const {return 2*items_.size();}
 	
-	inline double costs() const {
+	/*!
+	 * \brief costs for moving from the end of the previous item (last, last_dir) into the given item
+	 *  (symmetric: reversing the direction of both items and swapping their order does not change the costs)
+	 */
+	static inline double transitionCosts(const Pos &last, const cv::Point2f &last_dir, const T &item) {
 		//TODO: include direction change as costs
 		// depending on:
 		//  * translation speed
@@ -368,26 +434,29 @@ struct TSPTour {
 		*/
 		const double relation = (M_PI/0.2) * (0.05/0.3); //assumption: rotation_speed=0.2rad/s, translation_speed=0.3m/s, resolution=0.05m
 		
+		const double dist = std::sqrt(last.dist2(item.in_));
+		double rotation=0;
+		if(dist>10) { //we replace last_dir
+			Pos t = item.in_-last;
+			cv::Point2f interm(t.x_,t.y_);
+			interm*= 1./dist;
+			
+			rotation = (1+interm.dot(item.in_dir_));
+			rotation+= (1-last_dir.dot(interm));
+		}
+		else {
+			rotation = (1+last_dir.dot(item.in_dir_));
+		}
+		
+		return dist + rotation*relation;
+	}
+	
+	inline double costs() const {
 		double c=0;
 		Pos last = start_;
 		cv::Point2f last_dir(0,0);
 		for(size_t i=0; i<items_.size(); i++) {
-			const double dist = std::sqrt(last.dist2(items_[i].in_));
-			double rotation=0;
-			if(dist>10) { //we replace last_dir
-				Pos t = items_[i].in_-last;
-				cv::Point2f interm(t.x_,t.y_);
-				interm*= 1./dist;
-				
-				rotation = (1+interm.dot(items_[i].in_dir_));
-				rotation+= (1-last_dir.dot(interm));
-			}
-			else {
-				rotation = (1+last_dir.dot(items_[i].in_dir_));
-			}
-			
-			c += dist +
-				rotation*relation;
+			c += transitionCosts(last, last_dir, items_[i]);
 			last = items_[i].out_;
 			last_dir = items_[i].out_dir_;
 		}
@@ -416,73 +485,128 @@ struct TSPalgorithm {
 	TSPalgorithm(const Pos &p) : tour_(p)
 	{}
 
-	// Do all 2-opt combinations
-	void optimize()
-	{ 
+	/*!
+	 * \brief 2-opt optimization of the tour, each move reverses the items a..b of the tour and either turns them around
+	 *  (classical 2-opt) or keeps their directions, only moves that connect one of the num_neighbours closest endpoints
+	 *  are evaluated and their change of costs is computed in constant time
+	 */
+	void optimize(const size_t num_neighbours=16)
+	{
+		std::vector<T> &items = tour_.items_;
+		const int n = items.size();
+		if(n==0) return;
+		
+		// the endpoints never change, only order and direction of the items, so the neighbour lists are computed once
+		// endpoint 2*s is the initial in_ of item s, endpoint 2*s+1 its initial out_
+		PointCloud<int> cloud;
+		for(int s=0; s<n; s++) {
+			cloud.pts.push_back(PointCloud<int>::Point(items[s].in_.x_, items[s].in_.y_));
+			cloud.pts.push_back(PointCloud<int>::Point(items[s].out_.x_, items[s].out_.y_));
+		}
+		typedef nanoflann::KDTreeSingleIndexAdaptor<
+			nanoflann::L2_Simple_Adaptor<int, PointCloud<int> > ,
+			PointCloud<int>,
+			2 /* dim */
+			> my_kd_tree_t;
+		my_kd_tree_t index(2 /*dim*/, cloud, nanoflann::KDTreeSingleIndexAdaptorParams(10 /* max leaf */) );
+		index.buildIndex();
+		
+		const size_t num = std::min((size_t)2*n, num_neighbours+2);	//the own endpoints are found as well
+		std::vector<size_t> neighbours((2*n+1)*num);	//neighbours of all endpoints, the last row belongs to the start position
+		std::vector<int> neighbour_dists(num);
+		for(int e=0; e<=2*n; e++) {
+			const int query_pt[2] = {(e<2*n ? cloud.pts[e].x : tour_.start_.x_), (e<2*n ? cloud.pts[e].y : tour_.start_.y_)};
+			const size_t found = index.knnSearch(&query_pt[0], num, &neighbours[e*num], &neighbour_dists[0]);
+			for(size_t j=found; j<num; j++)
+				neighbours[e*num+j] = neighbours[e*num];
+		}
+		
+		std::vector<int> item_at(n), position_of(n);	//item index at tour position and vice versa
+		std::vector<char> turned(n, 0);					//true if the item is used in the opposite of its initial direction
+		for(int s=0; s<n; s++)
+			item_at[s] = position_of[s] = s;
+		
+		// costs of all transitions between the items in tour order (forward) and in reversed order (backward), as prefix sums
+		std::vector<double> forward(n, 0.), backward(n, 0.);
+		
 		// repeat until no improvement is made 
+		const double EPS = 1e-6;
 		bool improved = true;
-		time_t start = time(NULL);
-	 
 		while ( improved )
 		{
 			improved=false;
-			double best_distance = tour_.costs();
-	 
-			for ( int i = 0; i < tour_.size() - 1; i+=2 ) 
-			{
-				for ( int k = i + 1; k < tour_.size(); k++) 
-				{
-					TSPTour<T> new_tour(tour_.start_);
-					swap2opt(new_tour, i, k );
-	 
-					const double new_distance = new_tour.costs();
-	 
-					if ( new_distance < best_distance ) 
-					{
-						// Improvement found so reset
-						improved = true;
-						tour_ = new_tour;
-						best_distance = new_distance;
+			
+			for(int j=1; j<n; j++) {
+				forward[j] = forward[j-1] + TSPTour<T>::transitionCosts(items[j-1].out_, items[j-1].out_dir_, items[j]);
+				backward[j] = backward[j-1] + TSPTour<T>::transitionCosts(items[j].out_, items[j].out_dir_, items[j-1]);
+			}
+			
+			for(int j=0; j<n && !improved; j++) {
+				// candidates that start at position a=j, connecting the predecessor to a close endpoint
+				// and candidates that end at position b=j, connecting a close endpoint to the successor
+				for(int side=0; side<2 && !improved; side++) {
+					int e0;	//endpoint whose neighbours are checked
+					if(side==0) e0 = (j>0 ? 2*item_at[j-1]+(turned[item_at[j-1]]?0:1) : 2*n);
+					else if(j+1<n) e0 = 2*item_at[j+1]+(turned[item_at[j+1]]?1:0);
+					else continue;
+					
+					for(size_t k=0; k<=num && !improved; k++) {
+						int a=j, b=j;
+						bool turn=true;
+						if(k==num) {	//always check turning around the single item
+							if(side==1) continue;
+						}
+						else {
+							const int e = neighbours[e0*num+k];
+							const int s = e/2;
+							const bool is_in = ((e%2==0)!=(turned[s]!=0));	//endpoint is the current in_ of item s
+							if(side==0) {
+								b = position_of[s];
+								if(b<a) continue;
+								turn = !is_in;	//the new predecessor of item b has to be its current out_
+							}
+							else {
+								a = position_of[s];
+								if(a>b) continue;
+								turn = is_in;
+							}
+							if(!turn && a==b) continue;
+						}
 						
-						//std::cout<<"new costs "<<new_distance<<std::endl;
-						//Notify( tour_.costs() );
+						// change of costs for reversing a..b
+						double delta = 0;
+						if(a>0) {
+							delta -= TSPTour<T>::transitionCosts(items[a-1].out_, items[a-1].out_dir_, items[a]);
+							delta += TSPTour<T>::transitionCosts(items[a-1].out_, items[a-1].out_dir_, turn ? items[b].swap() : items[b]);
+						}
+						else {
+							delta -= TSPTour<T>::transitionCosts(tour_.start_, cv::Point2f(0,0), items[a]);
+							delta += TSPTour<T>::transitionCosts(tour_.start_, cv::Point2f(0,0), turn ? items[b].swap() : items[b]);
+						}
+						if(b+1<n) {
+							delta -= TSPTour<T>::transitionCosts(items[b].out_, items[b].out_dir_, items[b+1]);
+							const T last = (turn ? items[a].swap() : items[a]);
+							delta += TSPTour<T>::transitionCosts(last.out_, last.out_dir_, items[b+1]);
+						}
+						if(!turn)	//the transitions inside of a..b are only symmetric if the items are turned around
+							delta += (backward[b]-backward[a]) - (forward[b]-forward[a]);
 						
-						i=tour_.size(); break; //go to start
+						if(delta < -EPS) {
+							// Improvement found so apply it
+							improved = true;
+							std::reverse(items.begin()+a, items.begin()+b+1);
+							std::reverse(item_at.begin()+a, item_at.begin()+b+1);
+							for(int p=a; p<=b; p++) {
+								position_of[item_at[p]] = p;
+								if(turn) {
+									items[p] = items[p].swap();
+									turned[item_at[p]] = !turned[item_at[p]];
+								}
+							}
+						}
 					}
-					
-					/*if(time(NULL)-start>15) {
-						std::cout<<"TIMEOUT!"<<std::endl;
-						return;
-					}*/
 				}
 			}
-			
-		}
-	}
-
-	void swap2opt(TSPTour<T> &new_tour, const int& i, const int& k ) 
-	{
-		// 1. take route[0] to route[i-1] and add them in order to new_route
-		int c = 0;
-		for (; c+1 <= i - 1; c+=2 )
-		{
-			new_tour.set( c, tour_.get( c ) );
-		}
-		 
-		// 2. take route[i] to route[k] and add them in reverse order to new_route
-		int dec = 0;//(i%2==1?2:0);
-		for (; c<=k; c+=2 )
-		{
-			//std::cout<<c<<" "<<k<<" "<<dec<<std::endl;
-			assert(dec<=k);
-			new_tour.set( c, tour_.get( k - dec ) );
-			dec+=2;
-		}
-	 
-		// 3. take route[k+1] to end and add them in order to new_route
-		for (; c < tour_.size(); c+=2 )
-		{
-			new_tour.set( c, tour_.get( c ) );
 		}
 	}
 
@@ -515,21 +639,21 @@ void connect(const Points &pts, std::vector<int> &out, const cv::Mat &coverage,
 	
 	///////////////////////////////////
 	
-	PointCloud<int> cloud;
+	// the points lie on the grid, so the neighbours within the search radius are looked up in an image of point indices
+	// (same result as a radius search with squared radius 5 in a kd-tree, but without traversing the tree for each point)
+	int min_x=pts[0].x_, min_y=pts[0].y_, max_x=pts[0].x_, max_y=pts[0].y_;
+	for(size_t i=1; i<pts.size(); i++) {
+		min_x = std::min(min_x, pts[i].x_);
+		min_y = std::min(min_y, pts[i].y_);
+		max_x = std::max(max_x, pts[i].x_);
+		max_y = std::max(max_y, pts[i].y_);
+	}
+	cv::Mat point_index(max_y-min_y+1, max_x-min_x+1, CV_32S, cv::Scalar(-1));
 	for(size_t i=0; i<pts.size(); i++)
-		cloud.pts.push_back(PointCloud<int>::Point(pts[i].x_, pts[i].y_));
-	
-	// construct a kd-tree index:
-	typedef nanoflann::KDTreeSingleIndexAdaptor<
-		nanoflann::L2_Simple_Adaptor<int, PointCloud<int> > ,
-		PointCloud<int>,
-		2 /* dim */
-		> my_kd_tree_t;
-
-	my_kd_tree_t   index(2 /*dim*/, cloud, nanoflann::KDTreeSingleIndexAdaptorParams(10 /* max leaf */) );
-	index.buildIndex();
-	
-	int query_pt[2];
+		point_index.at<int>(pts[i].y_-min_y, pts[i].x_-min_x) = i;
+	//offsets with squared distance below 5, ordered by distance
+	const int NUM_OFFSETS=13;
+	static const Pos offsets[NUM_OFFSETS] = {Pos(0,0), Pos(-1,0), Pos(0,-1), Pos(1,0), Pos(0,1), Pos(-1,-1), Pos(1,-1), Pos(-1,1), Pos(1,1), Pos(-2,0), Pos(0,-2), Pos(2,0), Pos(0,2)};
 	
 	//1. build line segments
 	std::vector<LineSegment> segs;
@@ -567,15 +691,14 @@ void connect(const Points &pts, std::vector<int> &out, const cv::Mat &coverage,
 			}*/
 			
 			//search for neighbouring pts
-			query_pt[0] = pts[nexts[num]].x_;
-			query_pt[1] = pts[nexts[num]].y_;
-			
 			std::vector<std::pair<size_t,int> >   ret_matches;
-			nanoflann::SearchParams params;
-			params.sorted = true;
-
-			const size_t nMatches = index.radiusSearch(&query_pt[0], 5, ret_matches, params);
-			//const size_t nMatches = index.knnSearch(&query_pt[0], 3 /*direct neighbours*/, ret_matches, params);
+			for(int o=0; o<NUM_OFFSETS; o++) {
+				const int u = pts[nexts[num]].x_+offsets[o].x_-min_x;
+				const int v = pts[nexts[num]].y_+offsets[o].y_-min_y;
+				if(u>=0 && v>=0 && u<point_index.cols && v<point_index.rows && point_index.at<int>(v,u)>=0)
+					ret_matches.push_back(std::pair<size_t,int>(point_index.at<int>(v,u), offsets[o].dist2()));
+			}
+			const size_t nMatches = ret_matches.size();
 			//std::cout<<"nMatches "<<nMatches<<" ";
 			int n = num;
 			for (int j=(int)nMatches-1;j>=0;j--) {
@@ -670,7 +793,7 @@ class VoronoiMap {
 	int wall_offset_;				//< distance to wall for path generation in pixels
 	bool single_room_;				//< if true the map is handled as one complete room
 	
-	typedef std::priority_queue<Cell*, std::vector<Cell*>, pless<Cell, std::greater<Cell> > > T_WAVE;
+	typedef CellBucketQueue T_WAVE;	//< equivalent to std::priority_queue<Cell*, std::vector<Cell*>, pless<Cell, std::greater<Cell> > >, but without the logarithmic heap operations
 	
 	enum {
 		OCC=100, 	///< value for occupied cell in ROS gridmap
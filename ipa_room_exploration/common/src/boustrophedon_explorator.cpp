@@ -128,10 +128,21 @@ void BoustrophedonExplorer::getExplorationPath(const cv::Mat& room_map, std::vec
 				robot_pos, grid_spacing_as_int, half_grid_spacing_as_int, path_eps, max_deviation_from_track, grid_obstacle_offset/map_resolution);
 	}
 
+	ROS_INFO("Found the cell paths.");
+
 	// transform the calculated path back to the originally rotated map and create poses with an angle
-	RoomRotator room_rotation;
+	PathPostProcessor path_processor;
+	path_processor.setRotationBack(R);
+
+	// if the path should be planned for the robot footprint create the path directly in world coordinates and return here
+	if (plan_for_footprint == true)
+	{
+		path_processor.setWorldTransform(map_resolution, map_origin);
+		path_processor.process(fov_middlepoint_path, path);
+		return;
+	}
 	std::vector<geometry_msgs::Pose2D> fov_poses;	// this is the trajectory of poses of the robot footprint or the field of view, in [pixels]
-	room_rotation.transformPathBackToOriginalRotation(fov_middlepoint_path, fov_poses, R);
+	path_processor.process(fov_middlepoint_path, fov_poses);
 #ifdef DEBUG_VISUALIZATION
 	std::cout << "printing path" << std::endl;
 	cv::Mat room_map_path = room_map.clone();
@@ -145,24 +156,7 @@ void BoustrophedonExplorer::getExplorationPath(const cv::Mat& room_map, std::vec
 	//	for(size_t i=0; i<optimal_order.size()-1; ++i)
 	//		cv::line(room_map_path, polygon_centers[optimal_order[i]], polygon_centers[optimal_order[i+1]], cv::Scalar(100), 1);
 	cv::imshow("room_map_path_intermediate", room_map_path);
-	if (plan_for_footprint == true)
-		cv::waitKey();
 #endif
-	ROS_INFO("Found the cell paths.");
-
-	// if the path should be planned for the robot footprint create the path and return here
-	if (plan_for_footprint == true)
-	{
-		for(std::vector<geometry_msgs::Pose2D>::iterator pose=fov_poses.begin(); pose != fov_poses.end(); ++pose)
-		{
-			geometry_msgs::Pose2D current_pose;
-			current_pose.x = (pose->x * map_resolution) + map_origin.x;
-			current_pose.y = (pose->y * map_resolution) + map_origin.y;
-			current_pose.theta = pose->theta;
-			path.push_back(current_pose);
-		}
-		return;
-	}
 
 	// *********************** V. Get the robot path out of the fov path. ***********************
 	// go trough all computed fov poses and compute the corresponding robot pose
@@ -584,13 +584,9 @@ void convexSPPExplorator::getExplorationPath(const cv::Mat& room_map, std::vecto
 	// determine the correct viewing angles for the poses (footprint planning just used one fixed dummy direction)
 	if (plan_for_footprint == true)
 	{
-		// compute viewing directions
-		room_rotation.transformPointPathToPosePath(fov_poses, path);
-		// convert to meters
-		for (size_t i=0; i<path.size(); ++i)
-		{
-			path[i].x = path[i].x * map_resolution + map_origin.x;
-			path[i].y = path[i].y * map_resolution + map_origin.y;
-		}
+		// compute viewing directions and convert to meters
+		PathPostProcessor path_processor;
+		path_processor.setWorldTransform(map_resolution, map_origin);
+		path_processor.process(fov_poses, path);
 	}
 }
@@ -25,23 +25,70 @@ double EnergyFunctionalExplorator::E(const EnergyExploratorNode& location, const
 	energy_functional += std::abs(diff_angle)*PI_2_INV;	// 1.01 for punishing turns a little bit more on a tie
 
 	// 3. neighboring function, determining how many neighbors of the neighbor have been visited
-	int visited_neighbors = 0;
-	for(std::vector<EnergyExploratorNode*>::const_iterator n=neighbor.neighbors_.begin(); n!=neighbor.neighbors_.end(); ++n)
-		if ((*n)->obstacle_ == false && (*n)->visited_ == true)
-			++visited_neighbors;
-	energy_functional += 4. - 0.5*visited_neighbors;
-
-	int wall_points = 0;
-	for(std::vector<EnergyExploratorNode*>::const_iterator n=neighbor.neighbors_.begin(); n!=neighbor.neighbors_.end(); ++n)
-		if ((*n)->obstacle_ == true)
-			++wall_points;
-	energy_functional += 0.72 - 0.09*wall_points;
+	energy_functional += 4. - 0.5*neighbor.visited_neighbors_;
+
+	energy_functional += 0.72 - 0.09*neighbor.obstacle_neighbors_;
 
 	//std::cout << "E: " << cv::norm(diff)/cell_size << " + " << std::abs(diff_angle)*PI_2_INV << " + " << 4. - 0.5*visited_neighbors << " + " << 0.72 - 0.09*wall_points << "                        angles: " << travel_angle_to_node << ", " << previous_travel_angle << "   diff ang: " << diff_angle << std::endl;
 
 	return energy_functional;
 }
 
+// Function that finds the not visited node with the lowest energy functional. The blocks of the node grid are checked in square
+// rings around the block of the last node, skipping blocks without unvisited nodes. A node in ring k is at least (k-1)*block_size+1
+// nodes away from the last node and the terms 3. and 4. of the energy functional are at least 0.72 (at most 8 neighbors can be
+// visited or obstacles), so the search stops as soon as this lower bound exceeds the best found energy. On ties the node with the
+// lowest index is taken, which is the same node a row-wise scan through the whole grid would return.
+int EnergyFunctionalExplorator::findBestUnvisitedNode(const EnergyExploratorNodeGrid& nodes, const int last_node_index, const double cell_size_in_pixel,
+		const int node_distance_in_pixel, const double previous_travel_angle)
+{
+	const EnergyExploratorNode& last_node = nodes[last_node_index];
+	const int block_size = nodes.blockSize();
+	const int last_block_row = (last_node_index/nodes.columns())/block_size;
+	const int last_block_column = (last_node_index%nodes.columns())/block_size;
+	const int max_ring = std::max(std::max(last_block_row, nodes.blockRows()-1-last_block_row), std::max(last_block_column, nodes.blockColumns()-1-last_block_column));
+
+	double min_energy = 1e10;
+	int best_node_index = -1;
+	for(int ring=0; ring<=max_ring; ++ring)
+	{
+		// stop if no node in this or a further ring can have a lower energy (small margin for the float computation of E)
+		const int min_node_distance = (ring==0 ? 0 : (ring-1)*block_size+1);
+		if(best_node_index>=0 && (double)min_node_distance*node_distance_in_pixel/cell_size_in_pixel + 0.72 > min_energy + 1e-3)
+			break;
+
+		for(int block_row=std::max(0, last_block_row-ring); block_row<=std::min(nodes.blockRows()-1, last_block_row+ring); ++block_row)
+		{
+			// the first and last row of the ring are checked completely, in between only the left and right end belong to the ring
+			const int column_step = ((ring==0 || std::abs(block_row-last_block_row)==ring) ? 1 : 2*ring);
+			for(int block_column=last_block_column-ring; block_column<=last_block_column+ring; block_column+=column_step)
+			{
+				if(block_column<0 || block_column>=nodes.blockColumns() || nodes.unvisitedNodesInBlock(block_row, block_column)==0)
+					continue;
+
+				for(int row=block_row*block_size; row<std::min(nodes.rows(), (block_row+1)*block_size); ++row)
+				{
+					for(int column=block_column*block_size; column<std::min(nodes.columns(), (block_column+1)*block_size); ++column)
+					{
+						const int node_index = nodes.index(row, column);
+						const EnergyExploratorNode& node = nodes[node_index];
+						if(node.obstacle_==true || node.visited_==true)
+							continue;
+
+						const double current_energy = E(last_node, node, cell_size_in_pixel, previous_travel_angle);
+						if(current_energy<min_energy || (current_energy==min_energy && node_index<best_node_index))
+						{
+							min_energy = current_energy;
+							best_node_index = node_index;
+						}
+					}
+				}
+			}
+		}
+	}
+	return best_node_index;
+}
+
 // Function that plans a coverage path trough the given map, using the method proposed in
 //
 //	Bormann Richard, Joshua Hampp, and Martin Hägele. "New brooms sweep clean-an autonomous robotic cleaning assistant for
@@ -98,101 +145,55 @@ void EnergyFunctionalExplorator::getExplorationPath(const cv::Mat& room_map, std
 	}
 	cv::Mat inflated_rotated_room_map;
 	cv::erode(rotated_room_map, inflated_rotated_room_map, cv::Mat(), cv::Point(-1, -1), half_grid_spacing_as_int);
+	cv::Mat accessible_area_integral;
+	GridGenerator::computeAccessibleAreaIntegral(inflated_rotated_room_map, accessible_area_integral);
 
 	// *********************** II. Find the nodes and their neighbors ***********************
-	// get the nodes in the free space
-	std::vector<std::vector<EnergyExploratorNode> > nodes; // 2-dimensional vector to easily find the neighbors
-	int number_of_nodes = 0;
-
-//	// compute min/max room coordinates
-//	int min_y = 1000000, min_x = 1000000;
-//	for (int v=0; v<rotated_room_map.rows; ++v)
-//	{
-//		for (int u=0; u<rotated_room_map.cols; ++u)
-//		{
-//			if (rotated_room_map.at<uchar>(v,u)==255)
-//			{
-//				min_x = std::min(min_x, u);
-//				min_y = std::min(min_y, v);
-//			}
-//		}
-//	}
-//	if (min_x-grid_spacing_as_int > 0)
-//		min_x -= grid_spacing_as_int;
-//	if (min_y-grid_spacing_as_int > 0)
-//		min_y -= grid_spacing_as_int;
-
+	// get the nodes in the free space, stored row-wise in one array to easily find the neighbors
 	// todo: create grid in external class - it is the same in all approaches
 	// todo: if first/last row or column in grid has accessible areas but center is inaccessible, create a node in the accessible area
-	for(int y=min_room.y+half_grid_spacing_as_int; y<max_room.y; y+=grid_spacing_as_int)
+	const int number_of_rows = (max_room.y-min_room.y-half_grid_spacing_as_int <= 0 ? 0 : (max_room.y-min_room.y-half_grid_spacing_as_int-1)/grid_spacing_as_int+1);
+	const int number_of_columns = (max_room.x-min_room.x-half_grid_spacing_as_int <= 0 ? 0 : (max_room.x-min_room.x-half_grid_spacing_as_int-1)/grid_spacing_as_int+1);
+	EnergyExploratorNodeGrid nodes;
+	nodes.initialize(number_of_rows, number_of_columns);
+	for(int row=0; row<number_of_rows; ++row)
 	{
-		// for the current row create a new set of neurons to span the network over time
-		std::vector<EnergyExploratorNode> current_row;
-		for(int x=min_room.x+half_grid_spacing_as_int; x<max_room.x; x+=grid_spacing_as_int)
+		for(int column=0; column<number_of_columns; ++column)
 		{
 			// create node if the current point is in the free space
-			EnergyExploratorNode current_node;
-			current_node.center_ = cv::Point(x,y);
+			EnergyExploratorNode& current_node = nodes[nodes.index(row, column)];
+			current_node.center_ = cv::Point(min_room.x+half_grid_spacing_as_int+column*grid_spacing_as_int, min_room.y+half_grid_spacing_as_int+row*grid_spacing_as_int);
 			//if(rotated_room_map.at<uchar>(y,x) == 255)				// could make sense to test all pixels of the cell, not only the center
-			if (GridGenerator::completeCellTest(inflated_rotated_room_map, current_node.center_, grid_spacing_as_int) == true)
+			if (GridGenerator::completeCellTest(inflated_rotated_room_map, current_node.center_, grid_spacing_as_int, &accessible_area_integral) == true)
 			{
 				current_node.obstacle_ = false;
 				current_node.visited_ = false;
-				++number_of_nodes;
 			}
 			// add the obstacle nodes as already visited
 			else
 			{
 				current_node.obstacle_ = true;
 				current_node.visited_ = true;
-				++number_of_nodes;
 			}
-			current_row.push_back(current_node);
 		}
-
-		// insert the current row into grid
-		nodes.push_back(current_row);
 	}
-	std::cout << "found " << number_of_nodes <<  " nodes" << std::endl;
+	std::cout << "found " << nodes.size() <<  " nodes" << std::endl;
 
-	// find the neighbors for each node
-	EnergyExploratorNode* first_accessible_node = 0;
-	std::vector<EnergyExploratorNode*> corner_nodes; // vector that stores the corner nodes, i.e. nodes with 3 or less neighbors
-	for(size_t row=0; row<nodes.size(); ++row)
+	// count the obstacle and accessible neighbors of each node
+	nodes.computeNeighborhoods();
+	int first_accessible_node = -1;
+	std::vector<int> corner_nodes; // vector that stores the corner nodes, i.e. nodes with 3 or less neighbors
+	for(int node_index=0; node_index<nodes.size(); ++node_index)
 	{
-		for(size_t column=0; column<nodes[row].size(); ++column)
-		{
-			std::vector<EnergyExploratorNode*>& current_neighbors = nodes[row][column].neighbors_;
-			for(int dy=-1; dy<=1; ++dy)
-			{
-				// don't exceed the current row
-				if(row+dy < 0 || row+dy >= nodes.size())
-					continue;
-
-				// get the neighbors left from the current neuron
-				if(column > 0)
-					current_neighbors.push_back(&nodes[row+dy][column-1]);
-
-				// get the nodes on the same column as the current neuron
-				if(dy != 0)
-					current_neighbors.push_back(&nodes[row+dy][column]);
+		// check if the current node is a corner, i.e. nodes that have 3 or less neighbors that are not obstacles
+		if(nodes[node_index].accessible_neighbors_<=3 && nodes[node_index].obstacle_==false)
+			corner_nodes.push_back(node_index);
 
-				// get the nodes right from the current neuron
-				if(column < nodes[row].size()-1)
-					current_neighbors.push_back(&nodes[row+dy][column+1]);
-			}
-
-			// check if the current node is a corner, i.e. nodes that have 3 or less neighbors that are not obstacles
-			int non_obstacle_neighbors = nodes[row][column].countNonObstacleNeighbors();
-			if(non_obstacle_neighbors<=3 && nodes[row][column].obstacle_==false)
-				corner_nodes.push_back(&nodes[row][column]);
-
-			if (first_accessible_node==0 && nodes[row][column].obstacle_==false)
-				first_accessible_node = &nodes[row][column];
-		}
+		if (first_accessible_node<0 && nodes[node_index].obstacle_==false)
+			first_accessible_node = node_index;
 	}
 	std::cout << "found neighbors, corners: " << corner_nodes.size() << std::endl;
-	if (first_accessible_node == 0)
+	if (first_accessible_node < 0)
 	{
 		std::cout << "Warning: there are no accessible points in this room." << std::endl;
 		return;
@@ -200,37 +201,22 @@ void EnergyFunctionalExplorator::getExplorationPath(const cv::Mat& room_map, std
 
 //	// testing
 //	cv::Mat test_map = rotated_room_map.clone();
-//	for (size_t i=0; i<nodes.size(); ++i)
-//		for (size_t j=0; j<nodes[i].size(); ++j)
-//			if (nodes[i][j].obstacle_==false)
-//				cv::circle(test_map, nodes[i][j].center_, 2, cv::Scalar(127), CV_FILLED);
+//	for (int i=0; i<nodes.size(); ++i)
+//		if (nodes[i].obstacle_==false)
+//			cv::circle(test_map, nodes[i].center_, 2, cv::Scalar(127), CV_FILLED);
 //	cv::imshow("grid", test_map);
 //	cv::waitKey();
-//	for(size_t i=0; i<nodes.size(); ++i)
-//	{
-//		for(size_t j=0; j<nodes[i].size(); ++j)
-//		{
-//			cv::Mat test_map = rotated_room_map.clone();
-//
-//			std::vector<EnergyExploratorNode*> neighbors = nodes[i][j].neighbors_;
-//			for(std::vector<EnergyExploratorNode*>::iterator n=neighbors.begin(); n!=neighbors.end(); ++n)
-//				cv::circle(test_map, (*n)->center_, 2, cv::Scalar(127), CV_FILLED);
-//
-//			cv::imshow("neighbors", test_map);
-//			cv::waitKey();
-//		}
-//	}
 
 	// *********************** III. Plan the coverage path ***********************
 	// i. find the start node of the path as a corner that is closest to the starting position
 	std::vector<cv::Point> starting_point_vector(1, starting_position); // opencv syntax
 	cv::transform(starting_point_vector, starting_point_vector, R);
 	const cv::Point rotated_starting_point = starting_point_vector[0]; // Point that keeps track of the last point after the boustrophedon path in each cell
-	EnergyExploratorNode* start_node = first_accessible_node;
+	int start_node = first_accessible_node;
 	double min_distance = 1e10;
-	for(std::vector<EnergyExploratorNode*>::iterator corner=corner_nodes.begin(); corner!=corner_nodes.end(); ++corner)
+	for(std::vector<int>::iterator corner=corner_nodes.begin(); corner!=corner_nodes.end(); ++corner)
 	{
-		cv::Point diff = (*corner)->center_ - rotated_starting_point;
+		cv::Point diff = nodes[*corner].center_ - rotated_starting_point;
 		double current_distance = diff.x*diff.x+diff.y*diff.y;
 		if(current_distance<=min_distance)
 		{
@@ -238,33 +224,37 @@ void EnergyFunctionalExplorator::getExplorationPath(const cv::Mat& room_map, std
 			min_distance = current_distance;
 		}
 	}
-	std::cout << "start node: " << start_node->center_ << std::endl;
+	const cv::Point start_center = nodes[start_node].center_;
+	std::cout << "start node: " << start_center << std::endl;
 
 	// insert start node into coverage path
 	std::vector<cv::Point2f> fov_coverage_path;
-	fov_coverage_path.push_back(cv::Point2f(start_node->center_.x, start_node->center_.y));
-	start_node->visited_ = true;	// mark visited nodes as obstacles
+	fov_coverage_path.push_back(cv::Point2f(start_center.x, start_center.y));
+	nodes.markAsVisited(start_node);	// mark visited nodes as obstacles
 
 	// ii. starting at the start node, find the coverage path, by choosing the node that min. the energy functional
-	EnergyExploratorNode* last_node = start_node;
+	int last_node = start_node;
+	int neighbors[8];
+	int number_of_neighbors = nodes.getNeighbors(last_node, neighbors);
 	double previous_travel_angle = 0;  //always use x-direction in the rotated map  //std::atan2(rotated_starting_point.y-start_node->center_.y, rotated_starting_point.x-start_node->center_.x);
-	for(std::vector<EnergyExploratorNode*>::iterator neighbor=last_node->neighbors_.begin(); neighbor!=last_node->neighbors_.end(); ++neighbor)
+	for(int neighbor=0; neighbor<number_of_neighbors; ++neighbor)
 	{
-		if ((*neighbor)->obstacle_==false && (*neighbor)->center_.y==start_node->center_.y && (*neighbor)->center_.x>start_node->center_.x)
+		const EnergyExploratorNode& neighbor_node = nodes[neighbors[neighbor]];
+		if (neighbor_node.obstacle_==false && neighbor_node.center_.y==start_center.y && neighbor_node.center_.x>start_center.x)
 		{
 			previous_travel_angle = 0;
 			break;
 		}
-		if ((*neighbor)->obstacle_==false && (*neighbor)->center_.y==start_node->center_.y && (*neighbor)->center_.x<start_node->center_.x)
+		if (neighbor_node.obstacle_==false && neighbor_node.center_.y==start_center.y && neighbor_node.center_.x<start_center.x)
 		{
 			previous_travel_angle = PI;
 			break;
 		}
-		if ((*neighbor)->obstacle_==false && (*neighbor)->center_.y<start_node->center_.y && (*neighbor)->center_.x==start_node->center_.x)
+		if (neighbor_node.obstacle_==false && neighbor_node.center_.y<start_center.y && neighbor_node.center_.x==start_center.x)
 		{
 			previous_travel_angle = -0.5*PI;
 		}
-		if ((*neighbor)->obstacle_==false && (*neighbor)->center_.y>start_node->center_.y && (*neighbor)->center_.x==start_node->center_.x)
+		if (neighbor_node.obstacle_==false && neighbor_node.center_.y>start_center.y && neighbor_node.center_.x==start_center.x)
 		{
 			previous_travel_angle = 0.5*PI;
 		}
@@ -273,61 +263,40 @@ void EnergyFunctionalExplorator::getExplorationPath(const cv::Mat& room_map, std
 //	cv::circle(path_map, fov_coverage_path[0], 2, cv::Scalar(100), CV_FILLED);
 	do
 	{
-		//std::cout << "Point: " << last_node->center_ << std::endl;
-		// check the direct neighbors, if at least one is not already visited
-		std::vector<EnergyExploratorNode*> not_visited_neighbors;
-		for(std::vector<EnergyExploratorNode*>::iterator neighbor=last_node->neighbors_.begin(); neighbor!=last_node->neighbors_.end(); ++neighbor)
-			if ((*neighbor)->obstacle_ == false && (*neighbor)->visited_ == false)
-				not_visited_neighbors.push_back(*neighbor);
-
-		// if there are not visited direct neighbors, find the one of them that minimizes the energy functional
+		//std::cout << "Point: " << nodes[last_node].center_ << std::endl;
+		// check the direct neighbors, if at least one is not already visited, and find the one of them that minimizes the energy functional
 		double min_energy = 1e10;
-		EnergyExploratorNode* next_node = 0;
-		if (not_visited_neighbors.size() > 0)
+		int next_node = -1;
+		number_of_neighbors = nodes.getNeighbors(last_node, neighbors);
+		for(int neighbor=0; neighbor<number_of_neighbors; ++neighbor)
 		{
-			// find best neighbor
-			for (std::vector<EnergyExploratorNode*>::iterator candidate=not_visited_neighbors.begin(); candidate!=not_visited_neighbors.end(); ++candidate)
+			const EnergyExploratorNode& candidate = nodes[neighbors[neighbor]];
+			if (candidate.obstacle_ == true || candidate.visited_ == true)
+				continue;
+
+			const double current_energy = E(nodes[last_node], candidate, grid_spacing_in_pixel, previous_travel_angle);
+			//std::cout << "Neighbor: " << candidate.center_ << "    energy: " << current_energy << std::endl;
+			if(current_energy < min_energy)
 			{
-				const double current_energy = E(*last_node, **candidate, grid_spacing_in_pixel, previous_travel_angle);
-				//std::cout << "Neighbor: " << (*candidate)->center_ << "    energy: " << current_energy << std::endl;
-				if(current_energy < min_energy)
-				{
-					min_energy = current_energy;
-					next_node = *candidate;
-				}
+				min_energy = current_energy;
+				next_node = neighbors[neighbor];
 			}
 		}
 		// if no direct neighbor is unvisited, search for the next node in all unvisited nodes
-		else
+		if (next_node < 0)
 		{
-			// find best next node
-			for (size_t row=0; row<nodes.size(); ++row)
-			{
-				for (size_t col=0; col<nodes[row].size(); ++col)
-				{
-					// only check free nodes and not visited ones
-					if (nodes[row][col].obstacle_==false && nodes[row][col].visited_==false)
-					{
-						// check if current node has a better energy
-						const double current_energy = E(*last_node, nodes[row][col], grid_spacing_in_pixel, previous_travel_angle);
-						if (current_energy < min_energy)
-						{
-							min_energy = current_energy;
-							next_node = &nodes[row][col];
-						}
-					}
-				}
-			}
-			if (next_node == 0)
+			next_node = findBestUnvisitedNode(nodes, last_node, grid_spacing_in_pixel, grid_spacing_as_int, previous_travel_angle);
+			if (next_node < 0)
 				break;				// stop if all nodes have been visited
 		}
 		// add next node to path and set robot location
-		previous_travel_angle = std::atan2(next_node->center_.y-last_node->center_.y, next_node->center_.x-last_node->center_.x);
-		fov_coverage_path.push_back(cv::Point2f(next_node->center_.x, next_node->center_.y));
-		next_node->visited_ = true;	// mark visited nodes as obstacles
+		const cv::Point next_center = nodes[next_node].center_;
+		previous_travel_angle = std::atan2(next_center.y-nodes[last_node].center_.y, next_center.x-nodes[last_node].center_.x);
+		fov_coverage_path.push_back(cv::Point2f(next_center.x, next_center.y));
+		nodes.markAsVisited(next_node);	// mark visited nodes as obstacles
 
-//		cv::circle(path_map, next_node->center_, 2, cv::Scalar(100), CV_FILLED);
-//		cv::line(path_map, next_node->center_, last_node->center_, cv::Scalar(127));
+//		cv::circle(path_map, next_center, 2, cv::Scalar(100), CV_FILLED);
+//		cv::line(path_map, next_center, nodes[last_node].center_, cv::Scalar(127));
 //		cv::imshow("path", path_map);
 //		cv::waitKey();
 
@@ -335,8 +304,18 @@ void EnergyFunctionalExplorator::getExplorationPath(const cv::Mat& room_map, std
 	} while (true);
 
 	// transform the calculated path back to the originally rotated map
+	PathPostProcessor path_processor;
+	path_processor.setRotationBack(R);
+
+	// if the path should be planned for the footprint, directly transform the image points to the map coordinates
+	if(plan_for_footprint==true)
+	{
+		path_processor.setWorldTransform(map_resolution, map_origin);
+		path_processor.process(fov_coverage_path, path);
+		return;
+	}
 	std::vector<geometry_msgs::Pose2D> fov_poses;
-	room_rotation.transformPathBackToOriginalRotation(fov_coverage_path, fov_poses, R);
+	path_processor.process(fov_coverage_path, fov_poses);
 
 //	// go trough the found fov-path and compute the angles of the poses s.t. it points to the next pose that should be visited
 //	for(unsigned int point_index=0; point_index<fov_coverage_path.size(); ++point_index)
@@ -351,20 +330,6 @@ void EnergyFunctionalExplorator::getExplorationPath(const cv::Mat& room_map, std
 //		fov_coverage_path[point_index].theta = angle;
 //	}
 
-	// if the path should be planned for the footprint, transform the image points to the map coordinates
-	if(plan_for_footprint==true)
-	{
-		for(std::vector<geometry_msgs::Pose2D>::iterator pose=fov_poses.begin(); pose!=fov_poses.end(); ++pose)
-		{
-			geometry_msgs::Pose2D current_pose;
-			current_pose.x = (pose->x * map_resolution) + map_origin.x;
-			current_pose.y = (pose->y * map_resolution) + map_origin.y;
-			current_pose.theta = pose->theta;
-			path.push_back(current_pose);
-		}
-		return;
-	}
-
 //	// testing
 //	cv::Mat path_map = rotated_room_map.clone();
 //	cv::circle(path_map, fov_coverage_path[0], 2, cv::Scalar(100), CV_FILLED);
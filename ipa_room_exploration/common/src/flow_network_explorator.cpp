@@ -64,15 +64,16 @@ void FlowNetworkExplorator::solveThreeStageOptimizationProblem(std::vector<doubl
 	for(size_t row=0; row<V.rows; ++row)
 	{
 		std::vector<int> variable_indices;
+		const uchar* V_row = V.ptr<uchar>(row);
 
 		for(size_t col=0; col<start_arcs.size(); ++col)
-			if(V.at<uchar>(row, start_arcs[col])==1)
+			if(V_row[start_arcs[col]]==1)
 				variable_indices.push_back((int) col);
 
 		// coverage and final stage
 		for(size_t col=0; col<V.cols; ++col)
 		{
-			if(V.at<uchar>(row, col)==1)
+			if(V_row[col]==1)
 			{
 				variable_indices.push_back((int) col + start_arcs.size()); // coverage stage
 				variable_indices.push_back((int) col + start_arcs.size() + V.cols); // final stage
@@ -102,6 +103,11 @@ void FlowNetworkExplorator::solveThreeStageOptimizationProblem(std::vector<doubl
 	}
 	problem_builder.addRow((int) start_indices.size(), &start_indices[0], &start_coefficients[0], 1.0, 1.0);
 
+	// position of each arc in the initial stage, -1 if the arc is not a start arc
+	std::vector<int> start_arc_positions(V.cols, -1);
+	for(size_t start=0; start<start_arcs.size(); ++start)
+		start_arc_positions[start_arcs[start]] = start;
+
 	// coverage stage, also add the flow decreasing and node indicator constraints
 	for(size_t node=0; node<flows_into_nodes.size(); ++node)
 	{
@@ -125,10 +131,10 @@ void FlowNetworkExplorator::solveThreeStageOptimizationProblem(std::vector<doubl
 		for(size_t inflow=0; inflow<flows_into_nodes[node].size(); ++inflow)
 		{
 			// if a start arcs flows into the node, additionally take the index of the arc in the start_arc vector
-			if(contains(start_arcs, flows_into_nodes[node][inflow])==true)
+			if(start_arc_positions[flows_into_nodes[node][inflow]]>=0)
 			{
 				// conservativity
-				variable_indices.push_back(std::find(start_arcs.begin(), start_arcs.end(), flows_into_nodes[node][inflow])-start_arcs.begin());
+				variable_indices.push_back(start_arc_positions[flows_into_nodes[node][inflow]]);
 				variable_coefficients.push_back(1.0);
 				// decreasing flow
 				flow_decrease_indices.push_back(variable_indices.back() + start_arcs.size() + 2.0*V.cols);
@@ -319,15 +325,16 @@ void FlowNetworkExplorator::solveGurobiOptimizationProblem(std::vector<double>&
 	for(size_t row=0; row<V.rows; ++row)
 	{
 		std::vector<int> variable_indices;
+		const uchar* V_row = V.ptr<uchar>(row);
 
 		for(size_t col=0; col<start_arcs.size(); ++col)
-			if(V.at<uchar>(row, start_arcs[col])==1)
+			if(V_row[start_arcs[col]]==1)
 				variable_indices.push_back((int) col);
 
 		// coverage and final stage
 		for(size_t col=0; col<V.cols; ++col)
 		{
-			if(V.at<uchar>(row, col)==1)
+			if(V_row[col]==1)
 			{
 				variable_indices.push_back((int) col + start_arcs.size()); // coverage stage
 				variable_indices.push_back((int) col + start_arcs.size() + V.cols); // final stage
@@ -355,6 +362,11 @@ void FlowNetworkExplorator::solveGurobiOptimizationProblem(std::vector<double>&
 		initial_stage_constraint += optimization_variables[start];
 	model.addConstr(initial_stage_constraint==1);
 
+	// position of each arc in the initial stage, -1 if the arc is not a start arc
+	std::vector<int> start_arc_positions(V.cols, -1);
+	for(size_t start=0; start<start_arcs.size(); ++start)
+		start_arc_positions[start_arcs[start]] = start;
+
 	// coverage stage
 	for(size_t node=0; node<flows_into_nodes.size(); ++node)
 	{
@@ -365,10 +377,10 @@ void FlowNetworkExplorator::solveGurobiOptimizationProblem(std::vector<double>&
 		for(size_t inflow=0; inflow<flows_into_nodes[node].size(); ++inflow)
 		{
 			// if a start arcs flows into the node, additionally take the index of the arc in the start_arc vector
-			if(contains(start_arcs, flows_into_nodes[node][inflow])==true)
+			if(start_arc_positions[flows_into_nodes[node][inflow]]>=0)
 			{
 				// conservativity
-				variable_indices.push_back(std::find(start_arcs.begin(), start_arcs.end(), flows_into_nodes[node][inflow])-start_arcs.begin());
+				variable_indices.push_back(start_arc_positions[flows_into_nodes[node][inflow]]);
 				variable_coefficients.push_back(1.0);
 			}
 			// get the index of the arc in the optimization vector
@@ -457,10 +469,11 @@ void FlowNetworkExplorator::solveGurobiOptimizationProblem(std::vector<double>&
 // without cycle prevention constraints is determined and then cycles are detected in this solution. For these cycles
 // then additional constraints are added and a new solution is determined. This procedure gets repeated until no cycle
 // is detected in the solution or the only cycle contains all visited nodes, because such a solution is a traveling
-// salesman like solution, which is a valid solution.
+// salesman like solution, which is a valid solution. The constraints are added to one persistent Cbc model, optionally
+// they are also generated during the branch and bound by a cut generator that checks each found integer solution.
 void FlowNetworkExplorator::solveLazyConstraintOptimizationProblem(std::vector<double>& C, const cv::Mat& V, const std::vector<double>& weights,
 		const std::vector<std::vector<uint> >& flows_into_nodes, const std::vector<std::vector<uint> >& flows_out_of_nodes,
-		const std::vector<uint>& start_arcs)
+		const std::vector<uint>& start_arcs, const bool use_cut_generator)
 {
 	// initialize the problem
 	CoinModel problem_builder;
@@ -498,15 +511,16 @@ void FlowNetworkExplorator::solveLazyConstraintOptimizationProblem(std::vector<d
 	for(size_t row=0; row<V.rows; ++row)
 	{
 		std::vector<int> variable_indices;
+		const uchar* V_row = V.ptr<uchar>(row);
 
 		for(size_t col=0; col<start_arcs.size(); ++col)
-			if(V.at<uchar>(row, start_arcs[col])==1)
+			if(V_row[start_arcs[col]]==1)
 				variable_indices.push_back((int) col);
 
 		// coverage and final stage
 		for(size_t col=0; col<V.cols; ++col)
 		{
-			if(V.at<uchar>(row, col)==1)
+			if(V_row[col]==1)
 			{
 				variable_indices.push_back((int) col + start_arcs.size()); // coverage stage
 				variable_indices.push_back((int) col + start_arcs.size() + V.cols); // final stage
@@ -536,6 +550,11 @@ void FlowNetworkExplorator::solveLazyConstraintOptimizationProblem(std::vector<d
 	}
 	problem_builder.addRow((int) start_indices.size(), &start_indices[0], &start_coefficients[0], 1.0, 1.0);
 
+	// position of each arc in the initial stage, -1 if the arc is not a start arc
+	std::vector<int> start_arc_positions(V.cols, -1);
+	for(size_t start=0; start<start_arcs.size(); ++start)
+		start_arc_positions[start_arcs[start]] = start;
+
 	// coverage stage
 	for(size_t node=0; node<flows_into_nodes.size(); ++node)
 	{
@@ -546,10 +565,10 @@ void FlowNetworkExplorator::solveLazyConstraintOptimizationProblem(std::vector<d
 		for(size_t inflow=0; inflow<flows_into_nodes[node].size(); ++inflow)
 		{
 			// if a start arcs flows into the node, additionally take the index of the arc in the start_arc vector
-			if(contains(start_arcs, flows_into_nodes[node][inflow])==true)
+			if(start_arc_positions[flows_into_nodes[node][inflow]]>=0)
 			{
 				// conservativity
-				variable_indices.push_back(std::find(start_arcs.begin(), start_arcs.end(), flows_into_nodes[node][inflow])-start_arcs.begin());
+				variable_indices.push_back(start_arc_positions[flows_into_nodes[node][inflow]]);
 				variable_coefficients.push_back(1.0);
 			}
 			// get the index of the arc in the optimization vector
@@ -593,363 +612,204 @@ void FlowNetworkExplorator::solveLazyConstraintOptimizationProblem(std::vector<d
 
 	// load the created LP problem to the solver
 	OsiClpSolverInterface LP_solver;
-	OsiClpSolverInterface* solver_pointer = &LP_solver;
-
-	solver_pointer->loadFromCoinModel(problem_builder);
+	LP_solver.loadFromCoinModel(problem_builder);
 
-	// testing
-	solver_pointer->writeLp("lin_flow_prog", "lp");
-
-	// solve the created integer optimization problem
-	CbcModel model(*solver_pointer);
+	// create one Cbc model that is kept for the whole lazy constraint loop, the found cycle prevention constraints get
+	// added as rows to this model instead of building a new model for each iteration
+	CbcModel model(LP_solver);
 	model.solver()->setHintParam(OsiDoReducePrint, true, OsiHintTry);
 
 	CbcHeuristicFPump heuristic(model);
 	model.addHeuristic(&heuristic);
-	model.initialSolve();
-	model.branchAndBound();
 
-//	testing
-//	std::vector<int> test_row(2);
-//	std::vector<double> test_coeff(2);
-//
-//	test_row[0] = 0;
-//	test_row[1] = 1;
-//
-//	test_coeff[0] = 1.0;
-//	test_coeff[1] = 1.0;
-//	solver_pointer->addRow(2, &test_row[0], &test_coeff[0], 0.0, 0.0);
-//	solver_pointer->writeLp("lin_flow_prog", "lp");
-//	solver_pointer->resolve();
+	// if wanted, check each integer solution found during the branch and bound for cycles and add the cycle prevention
+	// constraints directly as cuts, similar to the lazy constraint callback used with Gurobi (the model stores a copy)
+	if(use_cut_generator==true)
+	{
+		CyclePreventionCutGenerator cycle_prevention(flows_into_nodes, flows_out_of_nodes, start_arcs, V.cols);
+		model.addCutGenerator(&cycle_prevention, 1, "CyclePrevention", true, true);
+	}
 
-	// retrieve solution
-	const double* solution = model.solver()->getColSolution();
+	// solve the relaxation once and keep it as reference, s.t. later iterations can start from its basis
+	model.initialSolve();
+	model.saveReferenceSolver();
 
-	// search for cycles in the retrieved solution, if one is found add a constraint to prevent this cycle
+	// solve the problem and search for cycles in the retrieved solution, if one is found add a constraint to prevent this
+	// cycle and resolve the problem, until the solution is free of cycles
+	std::vector<double> solution(number_of_variables, 0.0);
 	bool cycle_free = false;
-
+	int iteration = 0;
 	do
 	{
-		// get the arcs that are used in the previously calculated solution
-		std::set<uint> used_arcs; // set that stores the indices of the arcs corresponding to non-zero elements in the solution
-
-		// go trough the start arcs
-		for(size_t start_arc=0; start_arc<start_arcs.size(); ++start_arc)
-		{
-			if(solution[start_arc]!=0)
-			{
-				// insert start index
-				used_arcs.insert(start_arcs[start_arc]);
-			}
-		}
-
-		// go trough the coverage stage
-		for(size_t arc=start_arcs.size(); arc<start_arcs.size()+V.cols; ++arc)
+		++iteration;
+		model.branchAndBound();
+
+		// retrieve solution
+		const double* current_solution = (model.bestSolution()!=NULL) ? model.bestSolution() : model.solver()->getColSolution();
+		solution.assign(current_solution, current_solution+number_of_variables);
+
+		// search for cycles in the retrieved solution
+		std::vector<std::vector<int> > cpc_indices;
+		std::vector<double> cpc_upper_bounds;
+		cycle_free = !computeCyclePreventionConstraints(&solution[0], V.cols, flows_into_nodes, flows_out_of_nodes, start_arcs,
+				cpc_indices, cpc_upper_bounds);
+		std::cout << "iteration " << iteration << ": found " << cpc_indices.size() << " cycles" << std::endl;
+
+		// if cycles appear add the prevention constraints to the problem, the previously computed solution is excluded by them,
+		// so the resolve starts from the basis of the last relaxation
+		if(cycle_free==false)
 		{
-			if(solution[arc]!=0)
+			model.resetToReferenceSolver();
+			for(size_t cycle=0; cycle<cpc_indices.size(); ++cycle)
 			{
-				// insert index, relative to the first coverage variable
-				used_arcs.insert(arc-start_arcs.size());
+				std::vector<double> cpc_coefficients(cpc_indices[cycle].size(), 1.0);
+				model.solver()->addRow((int) cpc_indices[cycle].size(), &cpc_indices[cycle][0], &cpc_coefficients[0], -COIN_DBL_MAX, cpc_upper_bounds[cycle]);
 			}
+			model.solver()->resolve();
+			model.saveReferenceSolver();
 		}
+	}while(cycle_free == false);
 
-		 // go trough the final stage and find the remaining used arcs
-		 for(uint flow=start_arcs.size()+V.cols; flow<start_arcs.size()+2*V.cols; ++flow)
-		 {
-			 if(solution[flow]>0)
-			 {
-				 // insert saved outgoing flow index
-				 used_arcs.insert(flow-start_arcs.size()-V.cols);
-			 }
-		}
-//		 go trough the final stage and find the remaining used arcs
-//		for(size_t node=0; node<flows_out_of_nodes.size(); ++node)
-//		{
-//			for(size_t flow=0; flow<flows_out_of_nodes[node].size(); ++flow)
-//			{
-//				if(solution[flows_out_of_nodes[node][flow]+start_arcs.size()+V.cols]!=0)
-//				{
-//					// insert saved outgoing flow index
-//					used_arcs.insert(flows_out_of_nodes[node][flow]);
-//				}
-//			}
-//		}
-
-		std::cout << "got " << used_arcs.size() << " used arcs" << std::endl;
-//		std::cout << "got the used arcs:" << std::endl;
-//		for(std::set<uint>::iterator sol=used_arcs.begin(); sol!=used_arcs.end(); ++sol)
-//			std::cout << *sol << std::endl;
-//		std::cout << std::endl;
-
-		// construct the directed edges out of the used arcs
-		std::vector<std::vector<int> > directed_edges; // vector that stores the directed edges for each node
-		for(uint start_node=0; start_node<flows_out_of_nodes.size(); ++start_node)
-		{
-			// check if a used arc is flowing out of the current start node
-			std::vector<uint> originating_flows;
-			bool originating = false;
-			for(std::set<uint>::iterator arc=used_arcs.begin(); arc!=used_arcs.end(); ++arc)
-			{
-				if(contains(flows_out_of_nodes[start_node], *arc)==true)
-				{
-					originating = true;
-					originating_flows.push_back(*arc);
-				}
-			}
-
-			// if the arc is originating from this node, find its destination
-			std::vector<int> current_directed_edges;
-			if(originating==true)
-			{
-				for(uint end_node=0; end_node<flows_into_nodes.size(); ++end_node)
-				{
-					if(end_node==start_node)
-						continue;
-
-					for(std::vector<uint>::iterator arc=originating_flows.begin(); arc!=originating_flows.end(); ++arc)
-						if(contains(flows_into_nodes[end_node], *arc)==true)
-							current_directed_edges.push_back(end_node);
-				}
-			}
-
-			// if the current node doesn't flow into another node insert a vector storing -1
-			if(current_directed_edges.size()==0)
-				current_directed_edges.push_back(-1);
+	for(size_t res=0; res<number_of_variables; ++res)
+	{
+//		std::cout << solution[res] << std::endl;
+		C[res] = solution[res];
+	}
+}
 
-			// save the found used directed edges
-			directed_edges.push_back(current_directed_edges);
-		}
+// Function that searches for cycles in the given solution of the three-stage problem, which are not connected to the rest
+// of the path. For that the support graph spanned by the used arcs is constructed and its strongly connected components
+// are determined. For each component with more than one node the constraint
+//		sum(used_arcs_in_component) <= |component|-1
+// is returned, which prevents this cycle in the next solution. A component containing all nodes or all used arcs is a
+// traveling salesman like solution, which is valid. Returns true if constraints have been found.
+bool FlowNetworkExplorator::computeCyclePreventionConstraints(const double* solution, const int number_of_arcs,
+		const std::vector<std::vector<uint> >& flows_into_nodes, const std::vector<std::vector<uint> >& flows_out_of_nodes,
+		const std::vector<uint>& start_arcs, std::vector<std::vector<int> >& constraint_indices, std::vector<double>& constraint_upper_bounds)
+{
+	const size_t number_of_nodes = flows_out_of_nodes.size();
+	const size_t number_of_start_arcs = start_arcs.size();
+
+	// get the arcs that are used in the solution of the initial, coverage and final stage
+	std::vector<bool> used_arcs(number_of_arcs, false);
+	for(size_t start_arc=0; start_arc<number_of_start_arcs; ++start_arc)
+		if(solution[start_arc]>0.01) // precision of the solver
+			used_arcs[start_arcs[start_arc]] = true;
+	for(int arc=0; arc<number_of_arcs; ++arc)
+		if(solution[arc+number_of_start_arcs]>0.01 || solution[arc+number_of_start_arcs+number_of_arcs]>0.01)
+			used_arcs[arc] = true;
+	const size_t number_of_used_arcs = std::count(used_arcs.begin(), used_arcs.end(), true);
+
+	// nodes that the arcs are flowing into
+	std::vector<std::vector<uint> > arc_end_nodes(number_of_arcs);
+	for(size_t node=0; node<number_of_nodes; ++node)
+		for(std::vector<uint>::const_iterator inflow=flows_into_nodes[node].begin(); inflow!=flows_into_nodes[node].end(); ++inflow)
+			arc_end_nodes[*inflow].push_back(node);
+
+	// construct the support graph out of the used arcs
+	directedGraph support_graph(number_of_nodes);
+	for(size_t start_node=0; start_node<number_of_nodes; ++start_node)
+		for(std::vector<uint>::const_iterator outflow=flows_out_of_nodes[start_node].begin(); outflow!=flows_out_of_nodes[start_node].end(); ++outflow)
+			if(used_arcs[*outflow]==true)
+				for(std::vector<uint>::iterator end_node=arc_end_nodes[*outflow].begin(); end_node!=arc_end_nodes[*outflow].end(); ++end_node)
+					if(*end_node!=start_node)
+						boost::add_edge(start_node, *end_node, support_graph);
+
+	// search for the strongly connected components
+	std::vector<int> c(number_of_nodes);
+	int number_of_strong_components = boost::strong_components(support_graph, boost::make_iterator_property_map(c.begin(), boost::get(boost::vertex_index, support_graph), c[0]));
+	std::vector<size_t> component_sizes(number_of_strong_components, 0);
+	for(std::vector<int>::iterator comp=c.begin(); comp!=c.end(); ++comp)
+		++component_sizes[*comp];
+
+	// check how many cycles there are in the solution (components with a size >= 2)
+	int number_of_cycles = 0;
+	std::vector<bool> done_components(number_of_strong_components, false);
+	for(std::vector<int>::iterator comp=c.begin(); comp!=c.end(); ++comp)
+	{
+		// don't check a component more than one time
+		if(done_components[*comp]==true)
+			continue;
 
-//		// testing
-//		std::cout << "used destinations: " << std::endl;
-////		directed_edges[1].push_back(0);
-//		for(size_t i=0; i<directed_edges.size(); ++i)
-//		{
-//			for(size_t j=0; j<directed_edges[i].size(); ++j)
-//			{
-//				std::cout << directed_edges[i][j] << " ";
-//			}
-//			std::cout << std::endl;
-//		}
-//		std::cout << std::endl;
+		if(component_sizes[*comp]>=2)
+			++number_of_cycles;
 
-		// construct the support graph out of the directed edges
-		directedGraph support_graph(flows_out_of_nodes.size()); // initialize with the right number of edges
+		// check if a tsp path is computed (number of arcs is same as number of nodes) or all the nodes belong to one
+		// strongly connected component
+		if(component_sizes[*comp]==number_of_used_arcs || component_sizes[*comp]==number_of_nodes)
+			number_of_cycles = 0;
 
-		int number_of_not_used_nodes = 0;
-		for(size_t start=0; start<directed_edges.size(); ++start)
-		{
-			for(size_t end=0; end<directed_edges[start].size(); ++end)
-			{
-				// if no destination starting from this node could be found ignore this node
-				if(directed_edges[start][end]==-1)
-				{
-					break;
-					++number_of_not_used_nodes;
-				}
+		done_components[*comp] = true;
+	}
+	if(number_of_cycles==0)
+		return false;
 
-				// add the directed edge
-				boost::add_edge(start, directed_edges[start][end], support_graph);
-			}
-		}
+	// gather the nodes of the components that form a cycle
+	std::vector<std::vector<uint> > cycle_nodes(number_of_strong_components);
+	for(size_t node=0; node<number_of_nodes; ++node)
+		if(component_sizes[c[node]]>=2 && component_sizes[c[node]]!=number_of_used_arcs)
+			cycle_nodes[c[node]].push_back(node);
 
-		// search for the strongly connected components
-		std::vector<int> c(flows_into_nodes.size());
-		int number_of_strong_components = boost::strong_components(support_graph, boost::make_iterator_property_map(c.begin(), boost::get(boost::vertex_index, support_graph), c[0]));
-		std::cout << "got " << number_of_strong_components << " strongly connected components" << std::endl;
-//		for (std::vector <int>::iterator i = c.begin(); i != c.end(); ++i)
-//		  std::cout << "Vertex " << i - c.begin() << " is in component " << *i << std::endl;
-
-		// check how many cycles there are in the solution (components with a size >= 2)
-		int number_of_cycles = 0;
-		std::set<int> done_components; // set that stores the component indices for that the nodes already were found
-		for(std::vector<int>::iterator comp=c.begin(); comp!=c.end(); ++comp)
+	// for each cycle find the used arcs that lie in it, i.e. that flow from one node of the cycle into another one
+	for(size_t cycle=0; cycle<cycle_nodes.size(); ++cycle)
+	{
+		if(cycle_nodes[cycle].size()==0)
+			continue;
+
+		std::vector<int> cpc_indices;
+		for(std::vector<uint>::iterator node=cycle_nodes[cycle].begin(); node!=cycle_nodes[cycle].end(); ++node)
+			for(std::vector<uint>::const_iterator outflow=flows_out_of_nodes[*node].begin(); outflow!=flows_out_of_nodes[*node].end(); ++outflow)
+				if(used_arcs[*outflow]==true)
+					for(std::vector<uint>::iterator end_node=arc_end_nodes[*outflow].begin(); end_node!=arc_end_nodes[*outflow].end(); ++end_node)
+						if(*end_node!=*node && c[*end_node]==(int)cycle)
+							cpc_indices.push_back(*outflow+number_of_start_arcs);
+
+		if(cpc_indices.size()>0)
 		{
-			// don't check a component more than one time
-			if(done_components.find(*comp)!=done_components.end())
-				continue;
-
-			int elements = std::count(c.begin(), c.end(), *comp);
-			if(elements>=2)
-				++number_of_cycles;
-
-			// check if a tsp path is computed (number of arcs is same as number of nodes), each arc is a strongly
-			// connected component itself or all the nodes belong to one strongly connected component
-			if(elements==used_arcs.size() || elements==flows_out_of_nodes.size())
-				number_of_cycles = 0;
-
-			// add it to done components
-			done_components.insert(*comp);
+			constraint_indices.push_back(cpc_indices);
+			constraint_upper_bounds.push_back(cycle_nodes[cycle].size()-1);
 		}
+	}
 
-		// check if no cycle appears in the solution, i.e. if not each node is a component of its own or a traveling
-		// salesman path has been computed (not_used_nodes+1) or each arc flows to another node
-		if(number_of_cycles==0)
-			cycle_free = true;
-
-		// if a cycle appears find it and add the prevention constraint to the problem and resolve it
-		if(cycle_free==false)
-		{
-			// go trough the components and find components with more than 1 element in it
-			std::vector<std::vector<uint> > cycle_nodes;
-			done_components.clear();
-			for (int component=0; component<c.size(); ++component)
-			{
-				// check if component hasn't been done yet
-				if(done_components.find(c[component])==done_components.end())
-				{
-					std::vector<uint> current_component_nodes;
-					int elements = std::count(c.begin(), c.end(), c[component]);
-//					std::cout << c[component] << std::endl;
-					if(elements>=2 && elements!=used_arcs.size())
-					{
-						for(std::vector<int>::iterator element=c.begin(); element!=c.end(); ++element)
-						{
-							if(*element==c[component])
-							{
-								current_component_nodes.push_back(element-c.begin());
-							}
-						}
-
-						// save the found cycle
-						if(current_component_nodes.size()>0)
-							cycle_nodes.push_back(current_component_nodes);
-
-						// add it to done components
-						done_components.insert(c[component]);
-					}
-				}
-			}
-
-//			std::cout << "found nodes that are part of a cycle: " << std::endl;
-//			for(size_t i=0; i<cycle_nodes.size(); ++i)
-//			{
-//				for(size_t j=0; j<cycle_nodes[i].size(); ++j)
-//				{
-//					std::cout << cycle_nodes[i][j] << " ";
-//				}
-//				std::cout << std::endl;
-//			}
-
-			// add the cycle prevention constraints for each found cycle to the optimization problem and resolve it
-			for(size_t cycle=0; cycle<cycle_nodes.size(); ++cycle)
-			{
-				// for each node in this cycle only use the outgoing arcs that are part of the cycle and the outflows
-				// out of the cycle that don't start at the current node
-//				std::cout << "searching for outflows" << std::endl;
-//				for(size_t node=0; node<cycle_nodes[cycle].size(); ++node)
-//				{
-//					std::vector<int> cpc_indices;
-//					std::vector<double> cpc_coefficients;
-//
-//					// gather the arcs in outgoing from all neighbors
-//					for(size_t neighbor=0; neighbor<cycle_nodes[cycle].size(); ++neighbor)
-//					{
-//						// for the node itself gather the outflows that belong to the cycle
-//						if(neighbor==node)
-//						{
-////							std::cout << "node itself: " << cycle_nodes[cycle][neighbor] << std::endl;
-//							int flow_index = -1;
-//							for(std::vector<uint>::const_iterator outflow=flows_out_of_nodes[cycle_nodes[cycle][neighbor]].begin(); outflow!=flows_out_of_nodes[cycle_nodes[cycle][neighbor]].end(); ++outflow)
-//							{
-//								// if the current arc is used in the solution, search for it in the incoming flows of
-//								// the other nodes in the cycle
-//								if(used_arcs.find(*outflow)!=used_arcs.end())
-//									for(size_t new_node=0; new_node<cycle_nodes[cycle].size(); ++new_node)
-//										if(contains(flows_into_nodes[cycle_nodes[cycle][new_node]], *outflow)==true)
-//											flow_index=*outflow;
-//							}
-//
-//							// if the outflow is an inflow of another cycle node, add its index to the constraint
-//							if(flow_index!=-1)
-//							{
-//								cpc_indices.push_back(flow_index+start_arcs.size());
-//								cpc_coefficients.push_back(-1.0);
-//							}
-//
-//						}
-//						// for other nodes gather outflows that are not part of the cycle
-//						else
-//						{
-////							std::cout << "neighbor" << std::endl;
-//							bool in_cycle = false;
-//							for(std::vector<uint>::const_iterator outflow=flows_out_of_nodes[cycle_nodes[cycle][neighbor]].begin(); outflow!=flows_out_of_nodes[cycle_nodes[cycle][neighbor]].end(); ++outflow)
-//							{
-//								// search for the current flow in the incoming flows of the other nodes in the cycle
-//								for(size_t new_node=0; new_node<cycle_nodes[cycle].size(); ++new_node)
-//									if(contains(flows_into_nodes[cycle_nodes[cycle][new_node]], *outflow)==true)
-//										in_cycle=true;
-//
-//								// if the arc is not in the cycle add its index
-//								if(in_cycle==false)
-//								{
-//									cpc_indices.push_back(*outflow+start_arcs.size());
-//									cpc_coefficients.push_back(1.0);
-//								}
-//
-//								// reset the indication boolean
-//								in_cycle = false;
-//							}
-//						}
-//					}
-//
-////					std::cout << "adding constraint" << std::endl;
-//					// add the constraint
-//					solver_pointer->addRow((int) cpc_indices.size(), &cpc_indices[0], &cpc_coefficients[0], 0.0, COIN_DBL_MAX);
-//				}
-				// for each cycle find the arcs that lie in it
-
-//				std::cout << "size: " << cycle_nodes[cycle].size() << std::endl;
-//				std::cout << "constraint: " << std::endl;
-				std::vector<int> cpc_indices;
-				std::vector<double> cpc_coefficients;
-				for(size_t node=0; node<cycle_nodes[cycle].size(); ++node)
-				{
-					for(std::vector<uint>::const_iterator outflow=flows_out_of_nodes[cycle_nodes[cycle][node]].begin(); outflow!=flows_out_of_nodes[cycle_nodes[cycle][node]].end(); ++outflow)
-					{
-						for(size_t neighbor=0; neighbor<cycle_nodes[cycle].size(); ++neighbor)
-						{
-							if(neighbor==node)
-								continue;
-
-							// if a cycle-node contains this arc is incoming node and was used in the solution, it belongs to the subset
-							if(contains(flows_into_nodes[cycle_nodes[cycle][neighbor]], *outflow)==true && used_arcs.find(*outflow)!=used_arcs.end())
-							{
-								cpc_indices.push_back(*outflow+start_arcs.size());
-								cpc_coefficients.push_back(1.0);
-							}
-						}
-					}
-				}
-				solver_pointer->addRow((int) cpc_indices.size(), &cpc_indices[0], &cpc_coefficients[0], COIN_DBL_MIN , cycle_nodes[cycle].size()-1);
-			}
-
-//			testing
-			solver_pointer->writeLp("lin_flow_prog", "lp");
-
-			// resolve the problem with the new constraints
-			solver_pointer->resolve();
-
-			// create a new model with the updated optimization problem and solve it
-			CbcModel new_model(*solver_pointer);
-			new_model.solver()->setHintParam(OsiDoReducePrint, true, OsiHintTry);
-
-			CbcHeuristicFPump heuristic_new(new_model);
-			new_model.addHeuristic(&heuristic_new);
+	return (constraint_indices.size()>0);
+}
 
-//			new_model.initialSolve();
-			new_model.branchAndBound();
+// Constructor
+CyclePreventionCutGenerator::CyclePreventionCutGenerator(const std::vector<std::vector<uint> >& flows_into_nodes,
+		const std::vector<std::vector<uint> >& flows_out_of_nodes, const std::vector<uint>& start_arcs, const int number_of_arcs)
+: flows_into_nodes_(flows_into_nodes), flows_out_of_nodes_(flows_out_of_nodes), start_arcs_(start_arcs), number_of_arcs_(number_of_arcs)
+{
+}
 
-			// retrieve new solution
-			solution = new_model.solver()->getColSolution();
+CglCutGenerator* CyclePreventionCutGenerator::clone() const
+{
+	return new CyclePreventionCutGenerator(*this);
+}
 
-		}
-	}while(cycle_free == false);
+// Function that is called by Cbc during the branch and bound. Only integer solutions are checked, because the cycle
+// detection relies on the arcs being either used or not. For each found cycle a globally valid cut is added.
+void CyclePreventionCutGenerator::generateCuts(const OsiSolverInterface& si, OsiCuts& cs, const CglTreeInfo info)
+{
+	const double* solution = si.getColSolution();
+	for(int col=0; col<si.getNumCols(); ++col)
+		if(si.isInteger(col)==true && std::abs(solution[col]-std::floor(solution[col]+0.5))>1e-4)
+			return;
+
+	std::vector<std::vector<int> > cpc_indices;
+	std::vector<double> cpc_upper_bounds;
+	if(FlowNetworkExplorator::computeCyclePreventionConstraints(solution, number_of_arcs_, flows_into_nodes_, flows_out_of_nodes_,
+			start_arcs_, cpc_indices, cpc_upper_bounds)==false)
+		return;
 
-	for(size_t res=0; res<number_of_variables; ++res)
+	for(size_t cycle=0; cycle<cpc_indices.size(); ++cycle)
 	{
-//		std::cout << solution[res] << std::endl;
-		C[res] = solution[res];
+		std::vector<double> cpc_coefficients(cpc_indices[cycle].size(), 1.0);
+		OsiRowCut cut;
+		cut.setRow((int) cpc_indices[cycle].size(), &cpc_indices[cycle][0], &cpc_coefficients[0]);
+		cut.setLb(-COIN_DBL_MAX);
+		cut.setUb(cpc_upper_bounds[cycle]);
+		cut.setGloballyValid(true);
+		cs.insert(cut);
 	}
 }
 
@@ -998,7 +858,8 @@ bool FlowNetworkExplorator::pointClose(const std::vector<cv::Point>& points, con
 void FlowNetworkExplorator::getExplorationPath(const cv::Mat& room_map, std::vector<geometry_msgs::Pose2D>& path,
 		const float map_resolution, const cv::Point starting_position, const cv::Point2d map_origin,
 		const int cell_size, const Eigen::Matrix<float, 2, 1>& robot_to_fov_middlepoint_vector, const float coverage_radius,
-		const bool plan_for_footprint, const double path_eps, const double curvature_factor, const double max_distance_factor)
+		const bool plan_for_footprint, const double path_eps, const double curvature_factor, const double max_distance_factor,
+		const bool use_cut_generator)
 {
 	// *********************** I. Find the main directions of the map and rotate it in this manner. ***********************
 	cv::Mat R;
@@ -1263,38 +1124,63 @@ void FlowNetworkExplorator::getExplorationPath(const cv::Mat& room_map, std::vec
 
 	// 2. visibility matrix, storing which call can be covered when going along the arc
 	//		remark: a cell counts as covered, when the center of each cell is in the coverage radius around the arc
-	cv::Mat V = cv::Mat(cell_centers.size(), number_of_candidates, CV_8U); // binary variables
+	//		remark: the cell centers lie on a regular grid, so a lookup table from grid coordinates to cell indices is used as
+	//				spatial hash, s.t. for each point of an arc only the cells in the coverage radius around it need to be checked
+	const double cover_distance = 1.1*coverage_radius;
+	const double cover_distance_squared = cover_distance*cover_distance;
+	cv::Mat cell_index_map = cv::Mat((max_y-min_y)/cell_size+1, (max_x-min_x)/cell_size+1, CV_32S, cv::Scalar(-1));
+	for(std::vector<cv::Point>::iterator cell=cell_centers.begin(); cell!=cell_centers.end(); ++cell)
+		cell_index_map.at<int>((cell->y-min_y)/cell_size, (cell->x-min_x)/cell_size) = (int)(cell-cell_centers.begin());
+	cv::Mat V = cv::Mat(cell_centers.size(), number_of_candidates, CV_8U, cv::Scalar(0)); // binary variables
 	for(std::vector<arcStruct>::iterator arc=arcs.begin(); arc!=arcs.end(); ++arc)
 	{
-		// use the pointClose function to check if a cell can be covered along the path
-		for(std::vector<cv::Point>::iterator cell=cell_centers.begin(); cell!=cell_centers.end(); ++cell)
+		const int arc_index = arc-arcs.begin();
+		for(std::vector<cv::Point>::const_iterator point=arc->edge_points.begin(); point!=arc->edge_points.end(); ++point)
 		{
-			if(pointClose(arc->edge_points, *cell, 1.1*coverage_radius) == true)
-				V.at<uchar>(cell-cell_centers.begin(), arc-arcs.begin()) = 1;
-			else
-				V.at<uchar>(cell-cell_centers.begin(), arc-arcs.begin()) = 0;
+			// range of grid cells that lie in the coverage radius around the current arc point
+			const int min_u = std::max(0, (int)std::ceil((point->x-cover_distance-min_x)/(double)cell_size));
+			const int max_u = std::min(cell_index_map.cols-1, (int)std::floor((point->x+cover_distance-min_x)/(double)cell_size));
+			const int min_v = std::max(0, (int)std::ceil((point->y-cover_distance-min_y)/(double)cell_size));
+			const int max_v = std::min(cell_index_map.rows-1, (int)std::floor((point->y+cover_distance-min_y)/(double)cell_size));
+			for(int v=min_v; v<=max_v; ++v)
+			{
+				for(int u=min_u; u<=max_u; ++u)
+				{
+					const int cell = cell_index_map.at<int>(v, u);
+					if(cell<0 || V.at<uchar>(cell, arc_index)==1)
+						continue;
+					const double dx = cell_centers[cell].x - point->x;
+					const double dy = cell_centers[cell].y - point->y;
+					if(dx*dx+dy*dy <= cover_distance_squared)
+						V.at<uchar>(cell, arc_index) = 1;
+				}
+			}
 		}
 	}
 
 	// 3. set of arcs (indices) that are going into and out of one node
+	//		remark: several edges may share the same position, so the arcs are assigned to the nodes by a lookup of the
+	//				positions instead of comparing each arc with each node
+	std::map<std::pair<int, int>, std::vector<uint> > nodes_at_position;
+	for(std::vector<cv::Point>::iterator edge=edges.begin(); edge!=edges.end(); ++edge)
+		nodes_at_position[std::make_pair(edge->x, edge->y)].push_back(edge-edges.begin());
 	std::vector<std::vector<uint> > flows_into_nodes(edges.size());
 	std::vector<std::vector<uint> > flows_out_of_nodes(edges.size());
 	int number_of_outflows = 0;
-	for(std::vector<cv::Point>::iterator edge=edges.begin(); edge!=edges.end(); ++edge)
+	for(std::vector<arcStruct>::iterator arc=arcs.begin(); arc!=arcs.end(); ++arc)
 	{
-		for(std::vector<arcStruct>::iterator arc=arcs.begin(); arc!=arcs.end(); ++arc)
+		const std::vector<uint>& end_nodes = nodes_at_position[std::make_pair(arc->end_point.x, arc->end_point.y)];
+		const std::vector<uint>& start_nodes = nodes_at_position[std::make_pair(arc->start_point.x, arc->start_point.y)];
+		// if the end point of the arc is the edge save it as incoming flow
+		for(std::vector<uint>::const_iterator node=end_nodes.begin(); node!=end_nodes.end(); ++node)
+			flows_into_nodes[*node].push_back(arc-arcs.begin());
+		// if the start point of the arc is the edge save it as outgoing flow
+		if(arc->start_point == arc->end_point)
+			continue;
+		for(std::vector<uint>::const_iterator node=start_nodes.begin(); node!=start_nodes.end(); ++node)
 		{
-			// if the start point of the arc is the edge save it as incoming flow
-			if(arc->end_point == *edge)
-			{
-				flows_into_nodes[edge-edges.begin()].push_back(arc-arcs.begin());
-			}
-			// if the end point of the arc is the edge save it as outgoing flow
-			else if(arc->start_point == *edge)
-			{
-				flows_out_of_nodes[edge-edges.begin()].push_back(arc-arcs.begin());
-				++number_of_outflows;
-			}
+			flows_out_of_nodes[*node].push_back(arc-arcs.begin());
+			++number_of_outflows;
 		}
 	}
 
@@ -1328,11 +1214,7 @@ void FlowNetworkExplorator::getExplorationPath(const cv::Mat& room_map, std::vec
 	bool all_cells_covered = true;
 	for(size_t row=0; row<V.rows; ++row)
 	{
-		int number_of_paths = 0;
-		for(size_t col=0; col<V.cols; ++col)
-			if(V.at<uchar>(row, col)==1)
-				++number_of_paths;
-		if(number_of_paths==0)
+		if(cv::countNonZero(V.row(row))==0)
 		{
 			std::cout << "!!!!!!!! EMPTY ROW OF VISIBILITY MATRIX !!!!!!!!!!!!!" << std::endl << "cell " << row << " not coverable" << std::endl;
 			all_cells_covered = false;
@@ -1362,7 +1244,7 @@ void FlowNetworkExplorator::getExplorationPath(const cv::Mat& room_map, std::vec
 #ifdef GUROBI_FOUND
 	solveGurobiOptimizationProblem(C, V, w, flows_into_nodes, flows_out_of_nodes, flows_out_of_nodes[start_index]);
 #else
-	solveLazyConstraintOptimizationProblem(C, V, w, flows_into_nodes, flows_out_of_nodes, flows_out_of_nodes[start_index]);
+	solveLazyConstraintOptimizationProblem(C, V, w, flows_into_nodes, flows_out_of_nodes, flows_out_of_nodes[start_index], use_cut_generator);
 #endif
 
 //	testing
@@ -1589,11 +1471,8 @@ void FlowNetworkExplorator::getExplorationPath(const cv::Mat& room_map, std::vec
 	std::cout << "got path" << std::endl;
 
 	// transform the calculated path back to the originally rotated map and create poses with an angle
-	std::vector<geometry_msgs::Pose2D> fov_poses;
-	std::vector<cv::Point2f> path_positions_2f(path_positions.size());
-	for (size_t i=0; i<path_positions.size(); ++i)
-		path_positions_2f[i] = cv::Point2f(path_positions[i].x, path_positions[i].y);
-	room_rotation.transformPathBackToOriginalRotation(path_positions_2f, fov_poses, R);
+	PathPostProcessor path_processor;
+	path_processor.setRotationBack(R);
 
 //	// 4. calculate a pose path out of the point path
 //	std::vector<geometry_msgs::Pose2D> fov_poses;
@@ -1616,36 +1495,20 @@ void FlowNetworkExplorator::getExplorationPath(const cv::Mat& room_map, std::vec
 //	}
 
 
-	// if the path should be planned for the robot footprint create the path and return here
+	// if the path should be planned for the robot footprint create the path directly in world coordinates and return here
 	if(plan_for_footprint == true)
 	{
-		for(std::vector<geometry_msgs::Pose2D>::iterator pose=fov_poses.begin(); pose != fov_poses.end(); ++pose)
-		{
-			geometry_msgs::Pose2D current_pose;
-			current_pose.x = (pose->x * map_resolution) + map_origin.x;
-			current_pose.y = (pose->y * map_resolution) + map_origin.y;
-			current_pose.theta = pose->theta;
-			path.push_back(current_pose);
-		}
+		path_processor.setWorldTransform(map_resolution, map_origin);
+		path_processor.process(path_positions, path);
 		return;
 	}
 
 	// *********************** V. Get the robot path out of the fov path. ***********************
-	// clean path from double occurrences of the same pose in a row
+	// clean path from double occurrences of the same pose in a row, the angles are taken from the dense path before downsampling
+	path_processor.setOrientationBeforeDownsampling(true);
+	path_processor.setDownsampling(5.);	// [pixel]
 	std::vector<geometry_msgs::Pose2D> fov_path;
-	fov_path.push_back(fov_poses[0]);
-	cv::Point last_added_point(fov_poses[0].x, fov_poses[0].y);
-	const double min_dist_squared = 5 * 5;	// [pixel]
-	for (size_t i=1; i<fov_poses.size(); ++i)
-	{
-		const cv::Point current_point(fov_poses[i].x, fov_poses[i].y);
-		cv::Point vector = current_point - last_added_point;
-		if (vector.x*vector.x+vector.y*vector.y > min_dist_squared || i==fov_poses.size()-1)
-		{
-			fov_path.push_back(fov_poses[i]);
-			last_added_point = current_point;
-		}
-	}
+	path_processor.process(path_positions, fov_path);
 
 	// go trough all computed fov poses and compute the corresponding robot pose
 	std::cout << "mapping path" << std::endl;
@@ -216,8 +216,18 @@ void GridPointExplorator::getExplorationPath(const cv::Mat& room_map, std::vecto
 		fov_middlepoint_path[point_index] = cv::Point2f(grid_points[optimal_order[point_index]].x, grid_points[optimal_order[point_index]].y);
 
 	// transform the calculated path back to the originally rotated map and create poses with an angle
+	PathPostProcessor path_processor;
+	path_processor.setRotationBack(R);
+
+	// if the path should be planned for the robot footprint create the path directly in world coordinates and return here
+	if(plan_for_footprint == true)
+	{
+		path_processor.setWorldTransform(map_resolution, map_origin);
+		path_processor.process(fov_middlepoint_path, path);
+		return;
+	}
 	std::vector<geometry_msgs::Pose2D> path_fov_poses;
-	room_rotation.transformPathBackToOriginalRotation(fov_middlepoint_path, path_fov_poses, R);
+	path_processor.process(fov_middlepoint_path, path_fov_poses);
 
 //	for(unsigned int point_index = 0; point_index < fov_middlepoint_path.size(); ++point_index)
 //	{
@@ -237,20 +247,6 @@ void GridPointExplorator::getExplorationPath(const cv::Mat& room_map, std::vecto
 //		path.push_back(navigation_goal);
 //	}
 
-	// if the path should be planned for the robot footprint create the path and return here
-	if(plan_for_footprint == true)
-	{
-		for(std::vector<geometry_msgs::Pose2D>::iterator pose=path_fov_poses.begin(); pose != path_fov_poses.end(); ++pose)
-		{
-			geometry_msgs::Pose2D current_pose;
-			current_pose.x = (pose->x * map_resolution) + map_origin.x;
-			current_pose.y = (pose->y * map_resolution) + map_origin.y;
-			current_pose.theta = pose->theta;
-			path.push_back(current_pose);
-		}
-		return;
-	}
-
 	// *********************** III. Get the robot path out of the fov path. ***********************
 	// go trough all computed fov poses and compute the corresponding robot pose
 	//mapPath(room_map, path, path_fov_poses, robot_to_fov_vector, map_resolution, map_origin, starting_position);
@@ -11,6 +11,7 @@ NeuralNetworkExplorator::NeuralNetworkExplorator()
 	E_ = 80; // E >> B, 80
 	mu_ = 1.03; // 1.03
 	delta_theta_weight_ = 0.15; // 0.15
+	update_threshold_ = 0.; // <= 0 updates the whole network after each step
 }
 
 // Function that calculates an exploration path trough the given map s.t. everything has been covered by the robot-footprint
@@ -63,163 +64,90 @@ void NeuralNetworkExplorator::getExplorationPath(const cv::Mat& room_map, std::v
 	}
 	cv::Mat inflated_rotated_room_map;
 	cv::erode(rotated_room_map, inflated_rotated_room_map, cv::Mat(), cv::Point(-1, -1), half_grid_spacing_as_int);
+	cv::Mat accessible_area_integral;
+	GridGenerator::computeAccessibleAreaIntegral(inflated_rotated_room_map, accessible_area_integral);
 
 	// ****************** II. Create the neural network ******************
-	// reset previously computed neurons
-	neurons_.clear();
-
-	// go trough the map and create the neurons
+	// go trough the map and create the neurons, neuron (row, column) is located at grid_origin + grid_spacing*(column, row)
+	const cv::Point grid_origin(min_room.x+half_grid_spacing_as_int, min_room.y+half_grid_spacing_as_int);
+	int number_of_rows = 0, number_of_columns = 0;
+	for(int y=grid_origin.y; y<max_room.y; y+=grid_spacing_as_int)
+		++number_of_rows;
+	for(int x=grid_origin.x; x<max_room.x; x+=grid_spacing_as_int)
+		++number_of_columns;
+	neurons_.initialize(number_of_rows, number_of_columns, grid_spacing_as_int, A_, B_, D_, E_, mu_, step_size_);
 	int number_of_free_neurons = 0;
-	for(int y=min_room.y+half_grid_spacing_as_int; y<max_room.y; y+=grid_spacing_as_int)
+	for(int row=0; row<number_of_rows; ++row)
 	{
-		// for the current row create a new set of neurons to span the network over time
-		std::vector<Neuron> current_network_row;
-		for(int x=min_room.x+half_grid_spacing_as_int; x<max_room.x; x+=grid_spacing_as_int)
+		for(int column=0; column<number_of_columns; ++column)
 		{
 			// create free neuron
-			cv::Point cell_center(x,y);
-			if (GridGenerator::completeCellTest(inflated_rotated_room_map, cell_center, grid_spacing_as_int) == true)
+			cv::Point cell_center(grid_origin.x+column*grid_spacing_as_int, grid_origin.y+row*grid_spacing_as_int);
+			if (GridGenerator::completeCellTest(inflated_rotated_room_map, cell_center, grid_spacing_as_int, &accessible_area_integral) == true)
 			//if(rotated_room_map.at<uchar>(y,x) == 255)
-			{
-				Neuron current_neuron(cell_center, A_, B_, D_, E_, mu_, step_size_, false);
-				current_network_row.push_back(current_neuron);
 				++number_of_free_neurons;
-			}
 			else // obstacle neuron
-			{
-				Neuron current_neuron(cell_center, A_, B_, D_, E_, mu_, step_size_, true);
-				current_network_row.push_back(current_neuron);
-			}
+				neurons_.markAsObstacle(row, column);
 		}
-
-		// insert the current row into the network
-		neurons_.push_back(current_network_row);
 	}
 
 	// todo: do not limit to direct neighbors but cycle through all neurons for finding the best next
-	// go trough the found neurons and get the direct neighbors of each
-	for(size_t row=0; row<neurons_.size(); ++row)
-	{
-		for(size_t column=0; column<neurons_[row].size(); ++column)
-		{
-			for(int dy=-1; dy<=1; ++dy)
-			{
-				// don't exceed the current row
-				if(row+dy < 0 || row+dy >= neurons_.size())
-					continue;
-
-				// get the neighbors left from the current neuron
-				if(column > 0)
-					neurons_[row][column].addNeighbor(&neurons_[row+dy][column-1]);
-
-				// get the neurons on the same column as the current neuron
-				if(dy != 0)
-					neurons_[row][column].addNeighbor(&neurons_[row+dy][column]);
-
-				// get the neurons right from the current neuron
-				if(column < neurons_[row].size()-1)
-					neurons_[row][column].addNeighbor(&neurons_[row+dy][column+1]);
-			}
-		}
-	}
-
-//	testing
-//	cv::Mat black_map = cv::Mat(rotated_room_map.rows, rotated_room_map.cols, rotated_room_map.type(), cv::Scalar(0));
-//	for(size_t i=0; i<neurons_.size(); ++i)
-//	{
-//		for(size_t j=0; j<neurons_[i].size(); ++j)
-//		{
-//			std::vector<Neuron*> neighbors;
-//			neurons_[i][j].getNeighbors(neighbors);
-//			for(size_t k=0; k<neighbors.size(); ++k)
-//			{
-//				cv::circle(black_map, neighbors[k]->getPosition(), 2, cv::Scalar(127), CV_FILLED);
-//			}
-//		}
-//	}
-//	cv::imshow("neighbors", black_map);
-//	cv::waitKey();
+	// the direct neighbors of each neuron, in the order they are checked when searching the next neuron
+	const int neighbor_offsets[8][2] = {{-1,-1}, {-1,0}, {-1,1}, {0,-1}, {0,1}, {1,-1}, {1,0}, {1,1}};
 
 	// ****************** III. Find the coverage path ******************
 	// mark the first non-obstacle neuron as starting node
-	Neuron* starting_neuron = 0;
-	bool found = false;
-	for(size_t row=0; row<neurons_.size(); ++row)
+	cv::Point starting_neuron(-1, -1);	// (column, row) of the neuron
+	for(int row=0; row<number_of_rows && starting_neuron.x<0; ++row)
 	{
-		for(size_t column=0; column<neurons_[row].size(); ++column)
+		for(int column=0; column<number_of_columns; ++column)
 		{
-			if(neurons_[row][column].isObstacle() == false && found == false)
+			if(neurons_.isObstacle(row, column) == false)
 			{
-				found = true;
-				starting_neuron = &neurons_[row][column];
+				starting_neuron = cv::Point(column, row);
 				break;
 			}
 		}
-
-		if(found == true)
-			break;
 	}
-	if (starting_neuron==0)
+	if (starting_neuron.x<0)
 	{
 		std::cout << "Warning: there are no accessible points in this room." << std::endl;
 		return;
 	}
-	starting_neuron->markAsVisited();
+	neurons_.markAsVisited(starting_neuron.y, starting_neuron.x);
 
 	// initial updates of the states to mark obstacles and unvisited free neurons as such
-	for(size_t init=1; init<=100; ++init)
-	{
-		for(size_t row=0; row<neurons_.size(); ++row)
-			for(size_t column=0; column<neurons_[row].size(); ++column)
-				neurons_[row][column].saveState();
-		for(size_t row=0; row<neurons_.size(); ++row)
-			for(size_t column=0; column<neurons_[row].size(); ++column)
-				neurons_[row][column].updateState();
-	}
-
-//	testing
-//	cv::Mat black_map = cv::Mat(rotated_room_map.rows, rotated_room_map.cols, CV_32F, cv::Scalar(0));
-//	for(size_t row=0; row<neurons_.size(); ++row)
-//	{
-//		for(size_t column=0; column<neurons_[row].size(); ++column)
-//		{
-//			std::cout << neurons_[row][column].getState(false) << " ";
-//			black_map.at<float>(row*fitting_radius_as_int, column*fitting_radius_as_int) = (float) 1000.0*neurons_[row][column].getState(false);
-//		}
-//		std::cout << std::endl;
-//	}
-//	std::cout << std::endl;
-//	cv::namedWindow("states", cv::WINDOW_NORMAL);
-//	cv::imshow("states", black_map);
-//	cv::resizeWindow("states", 600, 600);
-//	cv::waitKey();
+	neurons_.updateStates(100);
 
 	// iteratively choose the next neuron until all neurons have been visited or the algorithm is stuck in a
 	// limit cycle like path (i.e. the same neurons get visited over and over)
 	int visited_neurons = 1;
 	bool stuck_in_cycle = false;
 	std::vector<cv::Point> fov_coverage_path;
-	fov_coverage_path.push_back(cv::Point(starting_neuron->getPosition().x, starting_neuron->getPosition().y));
+	fov_coverage_path.push_back(grid_origin + grid_spacing_as_int*starting_neuron);
+	cv::Mat path_occurrences = cv::Mat::zeros(number_of_rows, number_of_columns, CV_32S); // number of times a neuron is in the path
+	path_occurrences.at<int>(starting_neuron.y, starting_neuron.x) = 1;
 	double previous_traveling_angle = 0.0; // save the travel direction to the current neuron to determine the next neuron
 	cv::Mat black_map = rotated_room_map.clone();
-	Neuron* previous_neuron = starting_neuron;
+	cv::Point previous_neuron = starting_neuron;
 	int loop_counter = 0;
 	do
 	{
-		//std::cout << "Point: " << previous_neuron->getPosition() << std::endl;
 		++loop_counter;
-
-		// get the current neighbors and choose the next out of them
-		std::vector<Neuron*> neighbors;
-		previous_neuron->getNeighbors(neighbors);
-		Neuron* next_neuron = 0;
+		const cv::Point previous_position = grid_origin + grid_spacing_as_int*previous_neuron;
 
 		// go through the neighbors and find the next one
+		cv::Point next_neuron(-1, -1);
 		double max_value = -1e10, travel_angle = 0.0, best_angle = 0.0;
-		for(size_t neighbor=0; neighbor<neighbors.size(); ++neighbor)
+		for(int neighbor=0; neighbor<8; ++neighbor)
 		{
+			const cv::Point neighbor_neuron(previous_neuron.x+neighbor_offsets[neighbor][1], previous_neuron.y+neighbor_offsets[neighbor][0]);
+			if(neighbor_neuron.x<0 || neighbor_neuron.x>=number_of_columns || neighbor_neuron.y<0 || neighbor_neuron.y>=number_of_rows)
+				continue;
+			const cv::Point neighbor_position = grid_origin + grid_spacing_as_int*neighbor_neuron;
+
 			// get travel angle to this neuron
-			travel_angle = std::atan2(neighbors[neighbor]->getPosition().y-previous_neuron->getPosition().y, neighbors[neighbor]->getPosition().x-previous_neuron->getPosition().x);
+			travel_angle = std::atan2(neighbor_position.y-previous_position.y, neighbor_position.x-previous_position.x);
 
 			// compute penalizing function y_j
 			double diff_angle = travel_angle - previous_traveling_angle;
@@ -230,19 +158,18 @@ void NeuralNetworkExplorator::getExplorationPath(const cv::Mat& room_map, std::v
 			double y = 1 - (std::abs(diff_angle)/PI);
 
 			// compute transition function value
-			//std::cout << " Neighbor: " << neighbors[neighbor]->getPosition() << "   " << neighbors[neighbor]->getState(false) << ", " << delta_theta_weight_ * y << std::endl;
-			double trans_fct_value = neighbors[neighbor]->getState(false) + delta_theta_weight_ * y;
+			double trans_fct_value = neurons_.getState(neighbor_neuron.y, neighbor_neuron.x) + delta_theta_weight_ * y;
 
 			// check if neighbor is next neuron to be visited
-			if(trans_fct_value > max_value && rotated_room_map.at<uchar>(neighbors[neighbor]->getPosition()) != 0)
+			if(trans_fct_value > max_value && rotated_room_map.at<uchar>(neighbor_position) != 0)
 			{
 				max_value = trans_fct_value;
-				next_neuron = neighbors[neighbor];
+				next_neuron = neighbor_neuron;
 				best_angle = travel_angle;
 			}
 		}
 		// catch errors
-		if (next_neuron == 0)
+		if (next_neuron.x < 0)
 		{
 			if (loop_counter <= 20)
 				continue;
@@ -252,23 +179,20 @@ void NeuralNetworkExplorator::getExplorationPath(const cv::Mat& room_map, std::v
 		loop_counter = 0;
 
 		// if the next neuron was previously uncleaned, increase number of visited neurons
-		if(next_neuron->visitedNeuron() == false)
+		if(neurons_.visitedNeuron(next_neuron.y, next_neuron.x) == false)
 			++visited_neurons;
 
 		// mark next neuron as visited
-		next_neuron->markAsVisited();
+		neurons_.markAsVisited(next_neuron.y, next_neuron.x);
 		previous_traveling_angle = best_angle;
 
 		// add neuron to path
-		const cv::Point current_pose(next_neuron->getPosition().x, next_neuron->getPosition().y);
+		const cv::Point current_pose = grid_origin + grid_spacing_as_int*next_neuron;
 		fov_coverage_path.push_back(current_pose);
 
-		// check the fov path for a limit cycle by searching the path for the next neuron, if it occurs too often
+		// check the fov path for a limit cycle by counting how often the next neuron is in the path, if it occurs too often
 		// and the previous/following neuron is always the same the algorithm probably is stuck in a cycle
-		int number_of_neuron_in_path = 0;
-		for(std::vector<cv::Point>::iterator pose=fov_coverage_path.begin(); pose!=fov_coverage_path.end(); ++pose)
-			if(*pose==current_pose)
-				++number_of_neuron_in_path;
+		const int number_of_neuron_in_path = ++path_occurrences.at<int>(next_neuron.y, next_neuron.x);
 
 		if(number_of_neuron_in_path >= 20)
 		{
@@ -295,22 +219,18 @@ void NeuralNetworkExplorator::getExplorationPath(const cv::Mat& room_map, std::v
 			}
 		}
 
-		// update the states of the network
-		for (int i=0; i<100; ++i)
-		{
-			for(size_t row=0; row<neurons_.size(); ++row)
-				for(size_t column=0; column<neurons_[row].size(); ++column)
-					neurons_[row][column].saveState();
-			for(size_t row=0; row<neurons_.size(); ++row)
-				for(size_t column=0; column<neurons_[row].size(); ++column)
-					neurons_[row][column].updateState();
-		}
+		// update the states of the network, only the neurons around the changes of this step need to be updated if a
+		// convergence threshold is given
+		if(update_threshold_ > 0.)
+			neurons_.updateStatesLocally(100, update_threshold_);
+		else
+			neurons_.updateStates(100);
 
 //		printing of the path computation
 		if(show_path_computation == true)
 		{
-			cv::circle(black_map, next_neuron->getPosition(), 2, cv::Scalar((visited_neurons*5)%250), CV_FILLED);
-			cv::line(black_map, previous_neuron->getPosition(), next_neuron->getPosition(), cv::Scalar(128), 1);
+			cv::circle(black_map, current_pose, 2, cv::Scalar((visited_neurons*5)%250), CV_FILLED);
+			cv::line(black_map, previous_position, current_pose, cv::Scalar(128), 1);
 			cv::imshow("next_neuron", black_map);
 			cv::waitKey();
 		}
@@ -320,11 +240,18 @@ void NeuralNetworkExplorator::getExplorationPath(const cv::Mat& room_map, std::v
 	} while (visited_neurons < number_of_free_neurons && stuck_in_cycle == false); //TODO: test terminal condition
 
 	// transform the calculated path back to the originally rotated map
+	PathPostProcessor path_processor;
+	path_processor.setRotationBack(R);
+
+	// if the path should be planned for the robot footprint create the path directly in world coordinates and return here
+	if(plan_for_footprint == true)
+	{
+		path_processor.setWorldTransform(map_resolution, map_origin);
+		path_processor.process(fov_coverage_path, path);
+		return;
+	}
 	std::vector<geometry_msgs::Pose2D> fov_poses;
-	std::vector<cv::Point2f> fov_coverage_path_2f(fov_coverage_path.size());
-	for (size_t i=0; i<fov_coverage_path.size(); ++i)
-		fov_coverage_path_2f[i] = cv::Point2f(fov_coverage_path[i].x, fov_coverage_path[i].y);
-	room_rotation.transformPathBackToOriginalRotation(fov_coverage_path_2f, fov_poses, R);
+	path_processor.process(fov_coverage_path, fov_poses);
 
 //	// go trough the found fov-path and compute the angles of the poses s.t. it points to the next pose that should be visited
 //	for(unsigned int point_index=0; point_index<fov_path.size(); ++point_index)
@@ -339,20 +266,6 @@ void NeuralNetworkExplorator::getExplorationPath(const cv::Mat& room_map, std::v
 //		fov_path[point_index].theta = angle;
 //	}
 
-	// if the path should be planned for the robot footprint create the path and return here
-	if(plan_for_footprint == true)
-	{
-		for(std::vector<geometry_msgs::Pose2D>::iterator pose=fov_poses.begin(); pose != fov_poses.end(); ++pose)
-		{
-			geometry_msgs::Pose2D current_pose;
-			current_pose.x = (pose->x * map_resolution) + map_origin.x;
-			current_pose.y = (pose->y * map_resolution) + map_origin.y;
-			current_pose.theta = pose->theta;
-			path.push_back(current_pose);
-		}
-		return;
-	}
-
 	// ****************** III. Map the found fov path to the robot path ******************
 	// go trough all computed fov poses and compute the corresponding robot pose
 	ROS_INFO("Starting to map from field of view pose to robot pose");
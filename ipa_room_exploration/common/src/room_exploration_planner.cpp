@@ -0,0 +1,495 @@
+/*!
+ *****************************************************************
+ * \file
+ *
+ * \note
+ * Copyright (c) 2026 \n
+ * Fraunhofer Institute for Manufacturing Engineering
+ * and Automation (IPA) \n\n
+ *
+ *****************************************************************
+ *
+ * \note
+ * Project name: Care-O-bot
+ * \note
+ * ROS stack name: autopnp
+ * \note
+ * ROS package name: ipa_room_exploration
+ *
+ * \brief
+ *
+ *
+ *****************************************************************
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer. \n
+ * - Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution. \n
+ * - Neither the name of the Fraunhofer Institute for Manufacturing
+ * Engineering and Automation (IPA) nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission. \n
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <cmath>
+
+
+#include <ipa_room_exploration/room_exploration_planner.h>
+
+#include <map>
+
+#include <ipa_room_exploration/voronoi.hpp>
+
+
+// the shared data of one batch planning call, the planning threads take the rooms one after another
+struct RoomExplorationPlanner::BatchJob
+{
+	cv::Mat segmented_map;		// the labeled map (CV_32SC1), read only during planning
+	std::vector<int> room_ids;	// labels of the rooms that shall be planned
+	std::vector<cv::Rect> room_bounding_boxes;	// bounding box of each room in segmented_map, empty if the room does not exist
+	std::vector<cv::Point2d> starting_positions;	// starting position of each room, in [meter]
+	cv::Point2d map_origin;		// in [meter]
+	float map_resolution;		// in [m/cell]
+	int planning_mode;
+	double grid_spacing_in_pixel;
+	Eigen::Matrix<float, 2, 1> fitting_circle_center_point_in_meter;
+	std::vector<Eigen::Matrix<float, 2, 1> > fov_corners_meter;
+	Eigen::Matrix<float, 2, 1> fov_origin;
+	double coverage_radius;
+	double robot_radius;
+	int cell_size;
+	RoomExplorationPlannerParameters parameters;	// copy of the parameters at the start of the batch, the threads only read this copy
+
+	std::vector<std::vector<geometry_msgs::Pose2D> > coverage_paths;	// the planned path of each room, each entry is written by one thread only
+	size_t next_room;			// index of the next room that has not been taken by a planning thread yet
+	boost::mutex mutex;			// protects next_room
+};
+
+// plans the coverage paths of several rooms of a segmented map in parallel
+int RoomExplorationPlanner::planRooms(const cv::Mat& segmented_map, const std::vector<int>& room_ids, const std::vector<cv::Point2d>& starting_positions,
+		const float map_resolution, const cv::Point2d& map_origin, const int planning_mode, const std::vector<geometry_msgs::Point32>& field_of_view,
+		const Eigen::Matrix<float, 2, 1>& fov_origin, const double coverage_radius, const double robot_radius,
+		const RoomExplorationPlannerParameters& parameters, const int number_of_planning_threads,
+		std::vector<std::vector<geometry_msgs::Pose2D> >& coverage_paths) const
+{
+	// ***************** I. do the preprocessing that all rooms share *****************
+	BatchJob job;
+	job.segmented_map = segmented_map;
+	job.room_ids = room_ids;
+	job.map_origin = map_origin;
+	job.map_resolution = map_resolution;
+	job.planning_mode = planning_mode;
+	job.fov_origin = fov_origin;
+	job.coverage_radius = coverage_radius;
+	job.robot_radius = robot_radius;
+	job.parameters = parameters;
+
+	// determine the bounding boxes of all requested rooms with one pass over the map
+	std::map<int, cv::Vec4i> room_extents;	// maps room_id to (min_x, min_y, max_x, max_y)
+	for (size_t i=0; i<job.room_ids.size(); ++i)
+		room_extents[job.room_ids[i]] = cv::Vec4i(job.segmented_map.cols, job.segmented_map.rows, -1, -1);
+	for (int v=0; v<job.segmented_map.rows; ++v)
+	{
+		const int* label_ptr = job.segmented_map.ptr<int>(v);
+		int last_label = 0;
+		std::map<int, cv::Vec4i>::iterator extent = room_extents.end();
+		for (int u=0; u<job.segmented_map.cols; ++u)
+		{
+			const int label = label_ptr[u];
+			if (label <= 0)
+				continue;
+			if (label != last_label)
+			{
+				extent = room_extents.find(label);
+				last_label = label;
+			}
+			if (extent == room_extents.end())
+				continue;
+			cv::Vec4i& e = extent->second;
+			e[0] = std::min(e[0], u);
+			e[1] = std::min(e[1], v);
+			e[2] = std::max(e[2], u);
+			e[3] = std::max(e[3], v);
+		}
+	}
+	const bool use_given_starting_positions = (starting_positions.size() == job.room_ids.size());
+	if (starting_positions.size() > 0 && use_given_starting_positions == false)
+		std::cout << "RoomExplorationPlanner::planRooms: Warning: the number of starting positions does not match the number of rooms, using the room centers instead." << std::endl;
+	job.room_bounding_boxes.resize(job.room_ids.size());
+	job.starting_positions.resize(job.room_ids.size());
+	for (size_t i=0; i<job.room_ids.size(); ++i)
+	{
+		const cv::Vec4i& e = room_extents[job.room_ids[i]];
+		if (e[2] >= e[0])
+			job.room_bounding_boxes[i] = cv::Rect(e[0], e[1], e[2]-e[0]+1, e[3]-e[1]+1);
+		if (use_given_starting_positions == true)
+			job.starting_positions[i] = starting_positions[i];
+		else
+			job.starting_positions[i] = cv::Point2d(job.map_origin.x + (e[0]+e[2])*0.5*job.map_resolution, job.map_origin.y + (e[1]+e[3])*0.5*job.map_resolution);
+	}
+
+	// the grid spacing is the same for all rooms
+	computeGridSpacing(job.planning_mode, field_of_view, job.coverage_radius, job.map_resolution, job.grid_spacing_in_pixel,
+			job.fitting_circle_center_point_in_meter, job.fov_corners_meter);
+	job.cell_size = (job.parameters.cell_size > 0 ? job.parameters.cell_size : std::floor(job.grid_spacing_in_pixel));
+
+	// ***************** II. plan the rooms in parallel, each thread takes the next unplanned room *****************
+	job.coverage_paths.resize(job.room_ids.size());
+	job.next_room = 0;
+	int number_of_threads = (number_of_planning_threads > 0 ? number_of_planning_threads : (int)boost::thread::hardware_concurrency());
+	number_of_threads = std::max(1, std::min(number_of_threads, (int)job.room_ids.size()));
+	std::cout << "planning " << job.room_ids.size() << " rooms with " << number_of_threads << " threads" << std::endl;
+	if (number_of_threads == 1)
+	{
+		planRoomsOfBatchJob(&job);
+	}
+	else
+	{
+		boost::thread_group planning_threads;
+		for (int t=0; t<number_of_threads; ++t)
+			planning_threads.create_thread(boost::bind(&RoomExplorationPlanner::planRoomsOfBatchJob, this, &job));
+		planning_threads.join_all();
+	}
+
+	// return the paths in the order of the requested rooms
+	coverage_paths.swap(job.coverage_paths);
+	int number_of_planned_rooms = 0;
+	for (size_t i=0; i<coverage_paths.size(); ++i)
+		if (coverage_paths[i].size() > 0)
+			++number_of_planned_rooms;
+	return number_of_planned_rooms;
+}
+
+// worker of the batch planning, takes rooms from the job until all are planned
+void RoomExplorationPlanner::planRoomsOfBatchJob(BatchJob* job) const
+{
+	ExplorationPlanners planners;	// the planner objects keep state while planning, so each thread has its own
+	while (true)
+	{
+		size_t room_index = 0;
+		{
+			boost::mutex::scoped_lock lock(job->mutex);
+			if (job->next_room >= job->room_ids.size())
+				return;
+			room_index = job->next_room;
+			++job->next_room;
+		}
+
+		const int room_id = job->room_ids[room_index];
+		const cv::Rect& bounding_box = job->room_bounding_boxes[room_index];
+		if (bounding_box.area() == 0)
+		{
+			std::cout << "RoomExplorationPlanner::planRoomsOfBatchJob: Warning: room " << room_id << " does not exist in the segmented map." << std::endl;
+			continue;
+		}
+
+		// cut out the room with a black margin, so the planners only process the room's surroundings instead of the whole map
+		const int margin = (int)std::ceil(job->grid_spacing_in_pixel) + 2;
+		const cv::Rect roi(bounding_box.x-margin, bounding_box.y-margin, bounding_box.width+2*margin, bounding_box.height+2*margin);
+		const cv::Rect map_roi = roi & cv::Rect(0, 0, job->segmented_map.cols, job->segmented_map.rows);
+		cv::Mat room_map = cv::Mat::zeros(roi.height, roi.width, CV_8UC1);
+		cv::Mat room_map_part = room_map(cv::Rect(map_roi.x-roi.x, map_roi.y-roi.y, map_roi.width, map_roi.height));
+		room_map_part.setTo(cv::Scalar(255), job->segmented_map(map_roi) == room_id);
+		const cv::Point2d room_map_origin(job->map_origin.x + roi.x*job->map_resolution, job->map_origin.y + roi.y*job->map_resolution);
+
+		const bool room_not_empty = preprocessRoomMap(room_map, job->parameters.map_correction_closing_neighborhood_size);
+		if (room_not_empty == false)
+		{
+			std::cout << "RoomExplorationPlanner::planRoomsOfBatchJob: Warning: room " << room_id << " is too small for generating exploration trajectories." << std::endl;
+			continue;
+		}
+
+		const cv::Point starting_position((job->starting_positions[room_index].x-room_map_origin.x)/job->map_resolution,
+				(job->starting_positions[room_index].y-room_map_origin.y)/job->map_resolution);
+		planCoveragePathMultiResolution(room_map, job->coverage_paths[room_index], job->map_resolution, starting_position, room_map_origin, job->planning_mode,
+				job->grid_spacing_in_pixel, job->fitting_circle_center_point_in_meter, job->fov_corners_meter, job->fov_origin, job->coverage_radius,
+				job->robot_radius, job->cell_size, job->parameters, planners);
+	}
+}
+
+// calls planCoveragePath with the map and sizes of one resolution level
+void RoomExplorationPlanner::CoveragePathPlanningFunction::operator()(const cv::Mat& room_map, std::vector<geometry_msgs::Pose2D>& path,
+		const float map_resolution, const cv::Point& starting_position, const cv::Point2d& map_origin, const double grid_spacing_in_pixel,
+		const int cell_size) const
+{
+	planner->planCoveragePath(room_map, path, map_resolution, starting_position, map_origin, planning_mode, grid_spacing_in_pixel,
+			*fitting_circle_center_point_in_meter, *fov_corners_meter, coverage_radius, robot_radius, cell_size, *parameters, *planners);
+}
+
+// plans on a downsampled map and refines at full resolution if parameters.multi_resolution_factor > 1, else plans directly with planCoveragePath
+void RoomExplorationPlanner::planCoveragePathMultiResolution(const cv::Mat& room_map, std::vector<geometry_msgs::Pose2D>& exploration_path, const float map_resolution,
+		const cv::Point& starting_position, const cv::Point2d& map_origin, const int planning_mode, const double grid_spacing_in_pixel,
+		const Eigen::Matrix<float, 2, 1>& fitting_circle_center_point_in_meter, const std::vector<Eigen::Matrix<float, 2, 1> >& fov_corners_meter,
+		const Eigen::Matrix<float, 2, 1>& fov_origin, const double coverage_radius, const double robot_radius, const int cell_size,
+		const RoomExplorationPlannerParameters& parameters, ExplorationPlanners& planners) const
+{
+	// the planner is called with the map, resolution, grid spacing and cell size of the respective resolution level
+	CoveragePathPlanningFunction plan;
+	plan.planner = this;
+	plan.parameters = &parameters;
+	plan.planning_mode = planning_mode;
+	plan.fitting_circle_center_point_in_meter = &fitting_circle_center_point_in_meter;
+	plan.fov_corners_meter = &fov_corners_meter;
+	plan.coverage_radius = coverage_radius;
+	plan.robot_radius = robot_radius;
+	plan.planners = &planners;
+	MultiResolutionCoveragePlanner multi_resolution_planner;
+	multi_resolution_planner.planPath(room_map, exploration_path, map_resolution, starting_position, map_origin, grid_spacing_in_pixel, cell_size,
+			parameters.multi_resolution_factor, fov_corners_meter, fov_origin, coverage_radius, (planning_mode==PLAN_FOR_FOOTPRINT),
+			parameters.multi_resolution_max_uncovered_ratio, plan);
+}
+
+// plans the coverage path through the preprocessed room_map with the configured algorithm
+void RoomExplorationPlanner::planCoveragePath(const cv::Mat& room_map, std::vector<geometry_msgs::Pose2D>& exploration_path, const float map_resolution,
+		const cv::Point& starting_position, const cv::Point2d& map_origin, const int planning_mode, const double grid_spacing_in_pixel,
+		const Eigen::Matrix<float, 2, 1>& fitting_circle_center_point_in_meter, const std::vector<Eigen::Matrix<float, 2, 1> >& fov_corners_meter,
+		const double coverage_radius, const double robot_radius, const int cell_size, const RoomExplorationPlannerParameters& parameters,
+		ExplorationPlanners& planners) const
+{
+	// todo: consider option to provide the inflated map or the robot radius to the functions instead of inflating with half cell size there
+	Eigen::Matrix<float, 2, 1> zero_vector;
+	zero_vector << 0, 0;
+	if (parameters.room_exploration_algorithm == 1) // use grid point explorator
+	{
+		// plan path
+		if(planning_mode == PLAN_FOR_FOV)
+			planners.grid_point_planner.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, std::floor(grid_spacing_in_pixel), false, fitting_circle_center_point_in_meter, parameters.tsp_solver, parameters.tsp_solver_timeout);
+		else
+			planners.grid_point_planner.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, std::floor(grid_spacing_in_pixel), true, zero_vector, parameters.tsp_solver, parameters.tsp_solver_timeout);
+	}
+	else if (parameters.room_exploration_algorithm == 2) // use boustrophedon explorator
+	{
+		// plan path
+		if(planning_mode == PLAN_FOR_FOV)
+			planners.boustrophedon_explorer.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, grid_spacing_in_pixel, parameters.grid_obstacle_offset, parameters.path_eps, parameters.cell_visiting_order, false, fitting_circle_center_point_in_meter, parameters.min_cell_area, parameters.max_deviation_from_track);
+		else
+			planners.boustrophedon_explorer.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, grid_spacing_in_pixel, parameters.grid_obstacle_offset, parameters.path_eps, parameters.cell_visiting_order, true, zero_vector, parameters.min_cell_area, parameters.max_deviation_from_track);
+	}
+	else if (parameters.room_exploration_algorithm == 3) // use neural network explorator
+	{
+		planners.neural_network_explorator.setParameters(parameters.A, parameters.B, parameters.D, parameters.E, parameters.mu, parameters.step_size, parameters.delta_theta_weight);
+		planners.neural_network_explorator.setNumberOfThreads(parameters.number_of_threads);
+		planners.neural_network_explorator.setUpdateThreshold(parameters.neural_network_update_threshold);
+		// plan path
+		if(planning_mode == PLAN_FOR_FOV)
+			planners.neural_network_explorator.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, grid_spacing_in_pixel, false, fitting_circle_center_point_in_meter, false);
+		else
+			planners.neural_network_explorator.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, grid_spacing_in_pixel, true, zero_vector, false);
+	}
+	else if (parameters.room_exploration_algorithm == 4) // use convexSPP explorator
+	{
+		// plan coverage path
+		if(planning_mode == PLAN_FOR_FOV)
+			planners.convex_SPP_explorator.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, cell_size, parameters.delta_theta, fov_corners_meter, fitting_circle_center_point_in_meter, 0., 7, false);
+		else
+			planners.convex_SPP_explorator.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, cell_size, parameters.delta_theta, fov_corners_meter, zero_vector, coverage_radius, 7, true);
+	}
+	else if (parameters.room_exploration_algorithm == 5) // use flow network explorator
+	{
+		if(planning_mode == PLAN_FOR_FOV)
+			planners.flow_network_explorator.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, cell_size, fitting_circle_center_point_in_meter, grid_spacing_in_pixel, false, parameters.path_eps, parameters.curvature_factor, parameters.max_distance_factor, parameters.use_cut_generator);
+		else
+			planners.flow_network_explorator.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, cell_size, zero_vector, grid_spacing_in_pixel, true, parameters.path_eps, parameters.curvature_factor, parameters.max_distance_factor, parameters.use_cut_generator);
+	}
+	else if (parameters.room_exploration_algorithm == 6) // use energy functional explorator
+	{
+		if(planning_mode == PLAN_FOR_FOV)
+			planners.energy_functional_explorator.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, grid_spacing_in_pixel, false, fitting_circle_center_point_in_meter);
+		else
+			planners.energy_functional_explorator.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, grid_spacing_in_pixel, true, zero_vector);
+	}
+	else if (parameters.room_exploration_algorithm == 7) // use voronoi explorator
+	{
+		// create a usable occupancy grid out of the given room map
+		std::vector<int8_t> room_gridmap(room_map.cols*room_map.rows);
+		for (int v=0; v<room_map.rows; ++v)
+			for (int u=0; u<room_map.cols; ++u)
+				room_gridmap[v*room_map.cols+u] = (room_map.at<uchar>(v,u)!=0 ? 0 : 100);
+
+		// do not find nearest pose to starting-position and start there because of issue in planner when starting position is provided
+		if(planning_mode==PLAN_FOR_FOV)
+		{
+//			cv::Mat distance_transform;
+//			cv::distanceTransform(room_map, distance_transform, CV_DIST_L2, CV_DIST_MASK_PRECISE);
+//			cv::Mat display = room_map.clone();
+//			// todoo: get max dist from map and parametrize loop
+//			for (int s=5; s<100; s+=10)
+//			{
+//				for (int v=0; v<distance_transform.rows; ++v)
+//				{
+//					for (int u=0; u<distance_transform.cols; ++u)
+//					{
+//						if (int(distance_transform.at<float>(v,u)) == s)
+//						{
+//							display.at<uchar>(v,u) = 0;
+//						}
+//					}
+//				}
+//			}
+//			cv::imshow("distance_transform", distance_transform);
+//			cv::imshow("trajectories", display);
+//			cv::waitKey();
+
+			// convert fov-radius to pixel integer
+			const int grid_spacing_as_int = (int)std::floor(grid_spacing_in_pixel);
+			std::cout << "grid spacing in pixel: " << grid_spacing_as_int << std::endl;
+
+			// create the object that plans the path, based on the room-map
+			VoronoiMap vm(room_gridmap.data(), room_map.cols, room_map.rows, grid_spacing_as_int, 2, true); // a perfect alignment of the paths cannot be assumed here (in contrast to footprint planning) because the well-aligned fov trajectory is mapped to robot locations that may not be on parallel tracks
+			// get the exploration path
+			std::vector<geometry_msgs::Pose2D> fov_path_uncleaned;
+			vm.setSingleRoom(true); //to force to consider all rooms
+			vm.generatePath(fov_path_uncleaned, cv::Mat(), starting_position.x, starting_position.y);	// start position in room center
+
+			// clean path from subsequent double occurrences of the same pose and convert to poses with angles
+			PathPostProcessor path_processor;
+			path_processor.setDownsampling(2.);	// [pixel]
+			std::vector<geometry_msgs::Pose2D> fov_path;
+			path_processor.process(fov_path_uncleaned, fov_path);
+
+			// map fov-path to robot-path
+			//cv::Point start_pos(fov_path.begin()->x, fov_path.begin()->y);
+			//mapPath(room_map, exploration_path, fov_path, fitting_circle_center_point_in_meter, map_resolution, map_origin, start_pos);
+			std::cout << "Starting to map from field of view pose to robot pose" << std::endl;
+			cv::Point robot_starting_position = (fov_path.size()>0 ? cv::Point(fov_path[0].x, fov_path[0].y) : starting_position);
+			cv::Mat inflated_room_map;
+			cv::erode(room_map, inflated_room_map, cv::Mat(), cv::Point(-1, -1), (int)std::floor(robot_radius/map_resolution));
+			mapPath(inflated_room_map, exploration_path, fov_path, fitting_circle_center_point_in_meter, map_resolution, map_origin, robot_starting_position);
+		}
+		else
+		{
+			// convert coverage-radius to pixel integer
+			//int coverage_diameter = (int)std::floor(2.*coverage_radius/map_resolution);
+			//std::cout << "coverage radius in pixel: " << coverage_diameter << std::endl;
+			const int grid_spacing_as_int = (int)std::floor(grid_spacing_in_pixel);
+			std::cout << "grid spacing in pixel: " << grid_spacing_as_int << std::endl;
+
+			// create the object that plans the path, based on the room-map
+			VoronoiMap vm(room_gridmap.data(), room_map.cols, room_map.rows, grid_spacing_as_int, 2, true);	//coverage_diameter-1); // diameter in pixel (full working width can be used here because tracks are planned in parallel motion)
+			// get the exploration path
+			std::vector<geometry_msgs::Pose2D> exploration_path_uncleaned;
+			vm.setSingleRoom(true); //to force to consider all rooms
+			vm.generatePath(exploration_path_uncleaned, cv::Mat(), starting_position.x, starting_position.y);	// start position in room center
+
+			// clean path from subsequent double occurrences of the same pose, convert to poses with angles and transform to global coordinates
+			PathPostProcessor path_processor;
+			path_processor.setDownsampling(3.5);	// [pixel]
+			path_processor.setWorldTransform(map_resolution, map_origin);
+			path_processor.process(exploration_path_uncleaned, exploration_path);
+		}
+	}
+	else if (parameters.room_exploration_algorithm == 8) // use boustrophedon variant explorator
+	{
+		// plan path
+		if(planning_mode == PLAN_FOR_FOV)
+			planners.boustrophedon_variant_explorer.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, grid_spacing_in_pixel, parameters.grid_obstacle_offset, parameters.path_eps, parameters.cell_visiting_order, false, fitting_circle_center_point_in_meter, parameters.min_cell_area, parameters.max_deviation_from_track);
+		else
+			planners.boustrophedon_variant_explorer.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, grid_spacing_in_pixel, parameters.grid_obstacle_offset, parameters.path_eps, parameters.cell_visiting_order, true, zero_vector, parameters.min_cell_area, parameters.max_deviation_from_track);
+	}
+}
+
+// applies the closing operation for map correction and removes the unconnected parts of the room
+bool RoomExplorationPlanner::preprocessRoomMap(cv::Mat& room_map, const int closing_neighborhood_size)
+{
+	// closing operation to neglect inaccessible areas and map errors/artifacts
+	cv::Mat temp;
+	cv::erode(room_map, temp, cv::Mat(), cv::Point(-1, -1), closing_neighborhood_size);
+	cv::dilate(temp, room_map, cv::Mat(), cv::Point(-1, -1), closing_neighborhood_size);
+
+	// remove unconnected, i.e. inaccessible, parts of the room (i.e. obstructed by furniture), only keep the room with the largest area
+	return removeUnconnectedRoomParts(room_map);
+}
+
+// computes the grid spacing that fits into the coverage radius or the field of view
+void RoomExplorationPlanner::computeGridSpacing(const int planning_mode, const std::vector<geometry_msgs::Point32>& field_of_view, const double coverage_radius,
+		const float map_resolution, double& grid_spacing_in_pixel, Eigen::Matrix<float, 2, 1>& fitting_circle_center_point_in_meter,
+		std::vector<Eigen::Matrix<float, 2, 1> >& fov_corners_meter)
+{
+	double grid_spacing_in_meter = 0.0;		// is the square grid cell side length that fits into the circle with the robot's coverage radius or fov coverage radius
+	float fitting_circle_radius_in_meter = 0;
+	fov_corners_meter.resize(4);
+	const double fov_resolution = 1000;		// in [cell/meter]
+	if(planning_mode == PLAN_FOR_FOV) // read out the given fov-vectors, if needed
+	{
+		// Get the size of one grid cell s.t. the grid can be completely covered by the field of view (fov) from all rotations around it.
+		for(int i = 0; i < 4; ++i)
+			fov_corners_meter[i] << field_of_view[i].x, field_of_view[i].y;
+		computeFOVCenterAndRadius(fov_corners_meter, fitting_circle_radius_in_meter, fitting_circle_center_point_in_meter, fov_resolution);
+		// get the edge length of the grid square that fits into the fitting_circle_radius
+		grid_spacing_in_meter = fitting_circle_radius_in_meter*std::sqrt(2);
+	}
+	else // if planning should be done for the footprint, read out the given coverage radius
+	{
+		grid_spacing_in_meter = coverage_radius*std::sqrt(2);
+	}
+	// map the grid size to an int in pixel coordinates, using floor method
+	grid_spacing_in_pixel = grid_spacing_in_meter/map_resolution;		// is the square grid cell side length that fits into the circle with the robot's coverage radius or fov coverage radius, multiply with sqrt(2) to receive the whole working width
+	std::cout << "grid size: " << grid_spacing_in_meter << " m   (" << grid_spacing_in_pixel << " px)" << std::endl;
+}
+
+// remove unconnected, i.e. inaccessible, parts of the room (i.e. obstructed by furniture), only keep the room with the largest area
+bool RoomExplorationPlanner::removeUnconnectedRoomParts(cv::Mat& room_map)
+{
+	// create new map with segments labeled by increasing labels from 1,2,3,...
+	cv::Mat room_map_int(room_map.rows, room_map.cols, CV_32SC1);
+	for (int v=0; v<room_map.rows; ++v)
+	{
+		for (int u=0; u<room_map.cols; ++u)
+		{
+			if (room_map.at<uchar>(v,u) == 255)
+				room_map_int.at<int32_t>(v,u) = -100;
+			else
+				room_map_int.at<int32_t>(v,u) = 0;
+		}
+	}
+
+	std::map<int, int> area_to_label_map;	// maps area=number of segment pixels (keys) to the respective label (value)
+	int label = 1;
+	for (int v=0; v<room_map_int.rows; ++v)
+	{
+		for (int u=0; u<room_map_int.cols; ++u)
+		{
+			if (room_map_int.at<int32_t>(v,u) == -100)
+			{
+				const int area = cv::floodFill(room_map_int, cv::Point(u,v), cv::Scalar(label), 0, 0, 0, 8 | cv::FLOODFILL_FIXED_RANGE);
+				area_to_label_map[area] = label;
+				++label;
+			}
+		}
+	}
+	// abort if area_to_label_map.size() is empty
+	if (area_to_label_map.size() == 0)
+		return false;
+
+	// remove all room pixels from room_map which are not accessible
+	const int label_of_biggest_room = area_to_label_map.rbegin()->second;
+	std::cout << "label_of_biggest_room=" << label_of_biggest_room << std::endl;
+	for (int v=0; v<room_map.rows; ++v)
+		for (int u=0; u<room_map.cols; ++u)
+			if (room_map_int.at<int32_t>(v,u) != label_of_biggest_room)
+				room_map.at<uchar>(v,u) = 0;
+
+	return true;
+}
@@ -60,6 +60,9 @@
 
 #include <ipa_room_exploration/room_rotator.h>
 
+std::map<boost::uint64_t, RoomRotator::MainDirectionCacheEntry> RoomRotator::main_direction_cache_;
+boost::mutex RoomRotator::main_direction_cache_mutex_;
+
 void RoomRotator::rotateRoom(const cv::Mat& room_map, cv::Mat& rotated_room_map, const cv::Mat& R, const cv::Rect& bounding_rect)
 {
 	// rotate the image
@@ -108,32 +111,57 @@ double RoomRotator::computeRoomRotationMatrix(const cv::Mat& room_map, cv::Mat&
 	return rotation_angle;
 }
 
+// computes a hash of the map content, its size and the map resolution (64 bit FNV-1a)
+boost::uint64_t RoomRotator::computeMapHash(const cv::Mat& room_map, const double map_resolution)
+{
+	const boost::uint64_t fnv_prime = 1099511628211ULL;
+	boost::uint64_t hash = 14695981039346656037ULL;
+	const int header[3] = {room_map.rows, room_map.cols, room_map.type()};
+	const unsigned char* header_bytes = (const unsigned char*)header;
+	for (size_t i=0; i<sizeof(header); ++i)
+		hash = (hash ^ header_bytes[i]) * fnv_prime;
+	const unsigned char* resolution_bytes = (const unsigned char*)&map_resolution;
+	for (size_t i=0; i<sizeof(map_resolution); ++i)
+		hash = (hash ^ resolution_bytes[i]) * fnv_prime;
+	const size_t row_bytes = room_map.cols*room_map.elemSize();
+	for (int v=0; v<room_map.rows; ++v)
+	{
+		const unsigned char* row = room_map.ptr<unsigned char>(v);
+		for (size_t i=0; i<row_bytes; ++i)
+			hash = (hash ^ row[i]) * fnv_prime;
+	}
+	return hash;
+}
+
 // computes the major direction of the walls from a map (preferably one room)
 // the map (room_map, CV_8UC1) is black (0) at impassable areas and white (255) on drivable areas
+// The line segments of the walls are found with a single probabilistic Hough transform with a minimal line length of 0.2m and a
+// maximal gap of 1.5 times this length. The line directions are collected in a histogram weighted by their length, which lets long
+// walls dominate over short segments of clutter. Each line is split linearly between the two closest bins, so that directions at a bin
+// border are not divided into two weak bins. The main direction is the length weighted mean of the line directions within one bin width
+// around the center of the maximum bin. Results are cached for each map.
 double RoomRotator::computeRoomMainDirection(const cv::Mat& room_map, const double map_resolution)
 {
+	const boost::uint64_t map_hash = computeMapHash(room_map, map_resolution);
+	{
+		boost::mutex::scoped_lock lock(main_direction_cache_mutex_);
+		std::map<boost::uint64_t, MainDirectionCacheEntry>::const_iterator cached_direction = main_direction_cache_.find(map_hash);
+		if (cached_direction != main_direction_cache_.end() && cached_direction->second.rows == room_map.rows
+				&& cached_direction->second.cols == room_map.cols && cached_direction->second.map_resolution == map_resolution)
+			return cached_direction->second.main_direction;
+	}
+
 	const double map_resolution_inverse = 1./map_resolution;
 
 	// compute Hough transform on edge image of the map
 	cv::Mat edge_map;
 	cv::Canny(room_map, edge_map, 50, 150, 3);
 	std::vector<cv::Vec4i> lines;
-	double min_line_length = 1.0;	// in [m]
-	for (; min_line_length > 0.1; min_line_length -= 0.2)
-	{
-		cv::HoughLinesP(edge_map, lines, 1, CV_PI/180, min_line_length*map_resolution_inverse, min_line_length*map_resolution_inverse, 1.5*min_line_length*map_resolution_inverse);
-		cv::Mat room_hough = edge_map.clone();
-		for (size_t i=0; i<lines.size(); ++i)
-		{
-			cv::Point p1(lines[i][0], lines[i][1]), p2(lines[i][2], lines[i][3]);
-			cv::line(room_hough, p1, p2, cv::Scalar(128), 2);
-		}
-		//cv::imshow("room_hough", room_hough);
-		if (lines.size() >= 4)
-			break;
-	}
-	// setup a histogram on the line directions weighted by their length to determine the major direction
-	Histogram<double> direction_histogram(0, CV_PI, 36);
+	const double min_line_length = 0.2;	// in [m]
+	cv::HoughLinesP(edge_map, lines, 1, CV_PI/180, min_line_length*map_resolution_inverse, min_line_length*map_resolution_inverse, 1.5*min_line_length*map_resolution_inverse);
+
+	// compute the direction and length of each line
+	std::vector<double> line_directions, line_lengths;
 	for (size_t i=0; i<lines.size(); ++i)
 	{
 		double dx = lines[i][2] - lines[i][0];
@@ -143,72 +171,86 @@ double RoomRotator::computeRoomMainDirection(const cv::Mat& room_map, const doub
 			double current_direction = std::atan2(dy, dx);
 			while (current_direction < 0.)
 				current_direction += CV_PI;
-			while (current_direction > CV_PI)
+			while (current_direction >= CV_PI)
 				current_direction -= CV_PI;
-			direction_histogram.addData(current_direction, sqrt(dy*dy+dx*dx));
-			//std::cout << " dx=" << dx << "   dy=" << dy << "   dir=" << current_direction << "   len=" << sqrt(dy*dy+dx*dx) << std::endl;
+			line_directions.push_back(current_direction);
+			line_lengths.push_back(sqrt(dy*dy+dx*dx));
+		}
+	}
+
+	// setup a histogram on the line directions weighted by their length to determine the major direction
+	const int number_of_bins = 36;
+	const double bin_width = CV_PI/number_of_bins;
+	std::vector<double> direction_histogram(number_of_bins, 0.);
+	for (size_t i=0; i<line_directions.size(); ++i)
+	{
+		// split the weight between the two bins whose centers are closest to the direction
+		const double bin_position = line_directions[i]/bin_width - 0.5;
+		const int lower_bin = (int)std::floor(bin_position);
+		const double upper_weight = bin_position - lower_bin;
+		direction_histogram[(lower_bin+number_of_bins)%number_of_bins] += (1.-upper_weight)*line_lengths[i];
+		direction_histogram[(lower_bin+1)%number_of_bins] += upper_weight*line_lengths[i];
+	}
+	const int max_bin = std::max_element(direction_histogram.begin(), direction_histogram.end()) - direction_histogram.begin();
+
+	// refine the direction with the weighted mean of the line directions around the maximum bin, the directions are periodic with pi
+	const double max_bin_center = (max_bin+0.5)*bin_width;
+	double offset_sum = 0., weight_sum = 0.;
+	for (size_t i=0; i<line_directions.size(); ++i)
+	{
+		double offset = line_directions[i] - max_bin_center;
+		while (offset < -0.5*CV_PI)
+			offset += CV_PI;
+		while (offset >= 0.5*CV_PI)
+			offset -= CV_PI;
+		if (std::abs(offset) <= bin_width)
+		{
+			offset_sum += offset*line_lengths[i];
+			weight_sum += line_lengths[i];
 		}
 	}
-	return direction_histogram.getMaxBinPreciseVal();
+	double main_direction = (weight_sum > 0. ? max_bin_center + offset_sum/weight_sum : 0.);
+	while (main_direction < 0.)
+		main_direction += CV_PI;
+	while (main_direction >= CV_PI)
+		main_direction -= CV_PI;
+
+	// store the result, the cache is cleared when it grows too large
+	{
+		boost::mutex::scoped_lock lock(main_direction_cache_mutex_);
+		if (main_direction_cache_.size() >= 1000)
+			main_direction_cache_.clear();
+		MainDirectionCacheEntry& entry = main_direction_cache_[map_hash];
+		entry.rows = room_map.rows;
+		entry.cols = room_map.cols;
+		entry.map_resolution = map_resolution;
+		entry.main_direction = main_direction;
+	}
+	return main_direction;
 }
 
 void RoomRotator::transformPathBackToOriginalRotation(const std::vector<cv::Point2f>& fov_middlepoint_path, std::vector<geometry_msgs::Pose2D>& path_fov_poses, const cv::Mat& R)
 {
 	path_fov_poses.clear();
 
-	// transform the calculated path back to the originally rotated map
-	cv::Mat R_inv;
-	cv::invertAffineTransform(R, R_inv);
-	std::vector<cv::Point2f> fov_middlepoint_path_transformed;
-	cv::transform(fov_middlepoint_path, fov_middlepoint_path_transformed, R_inv);
-
-	// create poses with an angle
-	transformPointPathToPosePath(fov_middlepoint_path_transformed, path_fov_poses);
+	// transform the calculated path back to the originally rotated map and create poses with an angle
+	PathPostProcessor path_processor;
+	path_processor.setRotationBack(R);
+	path_processor.process(fov_middlepoint_path, path_fov_poses);
 }
 
 void RoomRotator::transformPointPathToPosePath(const std::vector<cv::Point2f>& point_path, std::vector<geometry_msgs::Pose2D>& pose_path)
 {
 	// create poses with an angle
-	for(size_t point_index = 0; point_index < point_path.size(); ++point_index)
-	{
-		// get the vector from the previous to the current point
-		const cv::Point2f& current_point = point_path[point_index];
-
-		// add the next navigation goal to the path
-		geometry_msgs::Pose2D current_pose;
-		current_pose.x = current_point.x;
-		current_pose.y = current_point.y;
-		current_pose.theta = 0.;
-		cv::Point2f vector(0,0);
-		if (point_index > 0)
-		{
-			// compute the direction as the line from the previous point to the current point
-			vector = current_point - point_path[point_index-1];
-		}
-		else if (point_path.size() >= 2)
-		{
-			// for the first point take the direction between first and second point
-			vector = point_path[point_index+1] - current_point;
-		}
-		// only sample different points
-		if (vector.x!=0 || vector.y!=0)
-		{
-			current_pose.theta = std::atan2(vector.y, vector.x);
-			pose_path.push_back(current_pose);
-		}
-	}
+	PathPostProcessor path_processor;
+	path_processor.process(point_path, pose_path);
 }
 
 void RoomRotator::transformPointPathToPosePath(std::vector<geometry_msgs::Pose2D>& pose_path)
 {
-	// create point vector
-	std::vector<cv::Point2f> point_path;
-	for (size_t i=0; i<pose_path.size(); ++i)
-		point_path.push_back(cv::Point2f(pose_path[i].x, pose_path[i].y));
-
 	// create poses with an angle
-	pose_path.clear();
-	transformPointPathToPosePath(point_path, pose_path);
+	PathPostProcessor path_processor;
+	path_processor.process(pose_path);
 }
 
 void RoomRotator::getMinMaxCoordinates(const cv::Mat& map, cv::Point& min_room, cv::Point& max_room)
@@ -84,10 +84,37 @@
 
 #define PI 3.14159265359
 
+// Precomputed accessibility information of a room map. For every pixel it stores the distance to the closest accessible pixel,
+// which pixel this is and to which connected accessible area it belongs, so these questions can be answered with a lookup.
+struct AccessibilityField
+{
+	cv::Mat distance_to_accessible_area;	// CV_32F, distance of each pixel to the closest accessible pixel, 0 for accessible pixels
+	cv::Mat nearest_accessible_pixel_label;	// CV_32S, label of the closest accessible pixel, i.e. its index in accessible_pixels
+	std::vector<cv::Point> accessible_pixels;	// position of each accessible pixel label
+	cv::Mat area_labels;					// CV_32S, label of the connected accessible area for each accessible pixel, 0 for inaccessible pixels
+
+	// computes the field for the given map, accessible pixels have the value 255
+	void compute(const cv::Mat& room_map);
+
+	// returns the accessible pixel that is closest to the given point (which has to be inside the map)
+	cv::Point nearestAccessiblePixel(const cv::Point& point) const;
+
+	// returns the label of the connected accessible area that contains the closest accessible pixel to the given point
+	int areaLabel(const cv::Point& point) const;
+
+	// returns true if the given point is inside the map and accessible
+	bool isAccessible(const cv::Point& point) const;
+
+	// returns false if there is certainly no accessible pixel within the given radius around the given point
+	bool hasAccessiblePixelWithin(const cv::Point& point, const double radius) const;
+};
+
 // Function that provides the functionality that a given field of view (fov) path gets mapped to a robot path by using the given parameters.
 // To do so simply a vector operation is applied. If the computed robot pose is not in the free space, another accessible
 // point is generated by finding it on the radius around the fov middlepoint s.t. the distance to the last robot position
-// is minimized.
+// is minimized. The accessibility of the computed robot poses is read from a precomputed AccessibilityField, so the perimeter
+// around the fov middlepoint is only searched for the poses whose computed robot pose is not accessible. Fov poses without
+// any accessible pixel within the fov radius are identified with the AccessibilityField and skipped without searching the map.
 // Important: the room map needs to be an unsigned char single channel image, if inaccessible areas should be excluded, provide the inflated map
 // robot_to_fov_vector in [m]
 // returns robot_path in [m,m,rad]
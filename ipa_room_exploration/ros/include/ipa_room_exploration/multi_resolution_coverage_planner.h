@@ -0,0 +1,293 @@
+/*!
+ *****************************************************************
+ * \file
+ *
+ * \note
+ * Copyright (c) 2026 \n
+ * Fraunhofer Institute for Manufacturing Engineering
+ * and Automation (IPA) \n\n
+ *
+ *****************************************************************
+ *
+ * \note
+ * Project name: Care-O-bot
+ * \note
+ * ROS stack name: autopnp
+ * \note
+ * ROS package name: ipa_room_exploration
+ *
+ * \brief
+ *
+ *
+ *****************************************************************
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer. \n
+ * - Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution. \n
+ * - Neither the name of the Fraunhofer Institute for Manufacturing
+ * Engineering and Automation (IPA) nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission. \n
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <iostream>
+
+#include <opencv2/opencv.hpp>
+#include <Eigen/Dense>
+
+#include <boost/function.hpp>
+
+#include <geometry_msgs/Pose2D.h>
+
+#include <ipa_room_exploration/online_coverage_grid.h>
+
+
+// Coarse-to-fine driver for the coverage planners. The room is planned on a map that is downsampled by an integer factor, the path
+// is lifted to the full resolution map and afterwards the coverage of the path is checked on the full resolution map. Uncovered
+// patches (e.g. narrow parts near obstacles that vanished in the coarse map) are planned locally at full resolution and spliced
+// into the path. If the remaining uncovered area still exceeds the allowed ratio, the room is planned on the full resolution map.
+// The planner is wrapped by a function object, so any of the *Explorator classes can be used without changes.
+class MultiResolutionCoveragePlanner
+{
+public:
+	// plans a coverage path through room_map (CV_8UC1, 255 = free), the path is returned in [m,m,rad]
+	// map_resolution in [m/pixel], starting_position in [pixel], map_origin in [m], grid_spacing_in_pixel and cell_size in [pixel]
+	typedef boost::function<void (const cv::Mat& room_map, std::vector<geometry_msgs::Pose2D>& path, const float map_resolution,
+			const cv::Point& starting_position, const cv::Point2d& map_origin, const double grid_spacing_in_pixel, const int cell_size)> PlanningFunction;
+
+protected:
+	// a coarse pixel is free only if all pixels of its block in the full resolution map are free
+	void downsampleMap(const cv::Mat& room_map, cv::Mat& coarse_map, const int factor) const
+	{
+		coarse_map = cv::Mat::zeros((room_map.rows+factor-1)/factor, (room_map.cols+factor-1)/factor, CV_8UC1);
+		for (int v=0; v<coarse_map.rows; ++v)
+		{
+			for (int u=0; u<coarse_map.cols; ++u)
+			{
+				if (v*factor+factor > room_map.rows || u*factor+factor > room_map.cols)
+					continue;	// incomplete blocks at the border stay obstacles
+				bool free = true;
+				for (int dv=0; dv<factor && free==true; ++dv)
+				{
+					const uchar* row = room_map.ptr<uchar>(v*factor+dv) + u*factor;
+					for (int du=0; du<factor; ++du)
+						if (row[du] != 255)
+						{
+							free = false;
+							break;
+						}
+				}
+				if (free == true)
+					coarse_map.at<uchar>(v,u) = 255;
+			}
+		}
+	}
+
+	// moves each pose that lies on an obstacle of the full resolution map to the closest free pixel within search_radius
+	void liftPath(const cv::Mat& room_map, std::vector<geometry_msgs::Pose2D>& path, const float map_resolution,
+			const cv::Point2d& map_origin, const int search_radius) const
+	{
+		const cv::Rect map_rect(0, 0, room_map.cols, room_map.rows);
+		for (size_t i=0; i<path.size(); ++i)
+		{
+			const cv::Point p((path[i].x-map_origin.x)/map_resolution, (path[i].y-map_origin.y)/map_resolution);
+			if (map_rect.contains(p)==true && room_map.at<uchar>(p)==255)
+				continue;
+			int best_distance_squared = search_radius*search_radius + 1;
+			cv::Point best_point(-1, -1);
+			for (int dv=-search_radius; dv<=search_radius; ++dv)
+			{
+				for (int du=-search_radius; du<=search_radius; ++du)
+				{
+					const cv::Point q(p.x+du, p.y+dv);
+					const int distance_squared = du*du + dv*dv;
+					if (distance_squared<best_distance_squared && map_rect.contains(q)==true && room_map.at<uchar>(q)==255)
+					{
+						best_distance_squared = distance_squared;
+						best_point = q;
+					}
+				}
+			}
+			if (best_point.x >= 0)
+			{
+				path[i].x = best_point.x*map_resolution + map_origin.x;
+				path[i].y = best_point.y*map_resolution + map_origin.y;
+			}
+		}
+	}
+
+	// draws the coverage of the path into a coverage map of room_map and returns the pixels of each 8-connected uncovered patch with at
+	// least min_patch_area pixels, returns the number of uncovered pixels in these patches
+	int findUncoveredPatches(const cv::Mat& room_map, const std::vector<geometry_msgs::Pose2D>& path, const float map_resolution,
+			const cv::Point2d& map_origin, const std::vector<Eigen::Matrix<float, 2, 1> >& fov_corners_meter, const Eigen::Matrix<float, 2, 1>& fov_origin,
+			const double coverage_radius, const bool plan_for_footprint, const double min_patch_area, std::vector<std::vector<cv::Point> >& patches) const
+	{
+		OnlineCoverageGrid coverage_grid(room_map, map_resolution, map_origin, fov_corners_meter, fov_origin, coverage_radius, plan_for_footprint);
+		for (size_t i=0; i<path.size(); ++i)
+			coverage_grid.addRobotPose(path[i]);
+		cv::Mat uncovered_map = (coverage_grid.getCoverageMap() == 255);
+
+		// label the uncovered components, the pixel count of a component also holds for thin strips and excludes covered holes
+		cv::Mat labels, stats, centroids;
+		const int number_components = cv::connectedComponentsWithStats(uncovered_map, labels, stats, centroids, 8, CV_32S);
+		std::vector<int> patch_index(number_components, -1);	// label 0 is the covered or occupied background
+		patches.clear();
+		int uncovered_area = 0;
+		for (int label=1; label<number_components; ++label)
+		{
+			const int area = stats.at<int>(label, cv::CC_STAT_AREA);
+			if (area < min_patch_area)
+				continue;
+			patch_index[label] = (int)patches.size();
+			patches.push_back(std::vector<cv::Point>());
+			patches.back().reserve(area);
+			uncovered_area += area;
+		}
+		if (patches.size() == 0)
+			return 0;
+		for (int v=0; v<labels.rows; ++v)
+		{
+			const int* row = labels.ptr<int>(v);
+			for (int u=0; u<labels.cols; ++u)
+				if (patch_index[row[u]] >= 0)
+					patches[patch_index[row[u]]].push_back(cv::Point(u,v));
+		}
+		return uncovered_area;
+	}
+
+	// plans the patch (its pixels as returned by findUncoveredPatches) at full resolution within its surroundings and inserts the
+	// patch path after the closest pose of path
+	void refinePatch(const cv::Mat& room_map, const std::vector<cv::Point>& patch, std::vector<geometry_msgs::Pose2D>& path,
+			const float map_resolution, const cv::Point2d& map_origin, const double grid_spacing_in_pixel, const int cell_size,
+			const PlanningFunction& plan) const
+	{
+		// cut out the patch grown by one grid spacing with a black margin
+		const int growth = (int)std::ceil(grid_spacing_in_pixel);
+		const int margin = growth + 2;
+		const cv::Rect bounding_box = cv::boundingRect(patch);
+		const cv::Rect roi = cv::Rect(bounding_box.x-margin, bounding_box.y-margin, bounding_box.width+2*margin, bounding_box.height+2*margin)
+				& cv::Rect(0, 0, room_map.cols, room_map.rows);
+		cv::Mat patch_mask = cv::Mat::zeros(roi.height, roi.width, CV_8UC1);
+		for (size_t j=0; j<patch.size(); ++j)
+			patch_mask.at<uchar>(patch[j]-roi.tl()) = 255;
+		cv::dilate(patch_mask, patch_mask, cv::Mat(), cv::Point(-1,-1), growth);
+		cv::Mat patch_map = cv::Mat::zeros(roi.height, roi.width, CV_8UC1);
+		room_map(roi).copyTo(patch_map, patch_mask);
+		patch_map.row(0).setTo(cv::Scalar(0));
+		patch_map.row(patch_map.rows-1).setTo(cv::Scalar(0));
+		patch_map.col(0).setTo(cv::Scalar(0));
+		patch_map.col(patch_map.cols-1).setTo(cv::Scalar(0));
+
+		// start at the patch pixel that is closest to the path and insert the patch path after the pose it is closest to
+		std::vector<cv::Point2d> path_pixels(path.size());
+		for (size_t i=0; i<path.size(); ++i)
+			path_pixels[i] = cv::Point2d((path[i].x-map_origin.x)/map_resolution, (path[i].y-map_origin.y)/map_resolution);
+		cv::Point starting_position = patch[0];
+		double min_distance_squared = 1e30;
+		size_t closest_pose = path.size();
+		for (size_t j=0; j<patch.size(); ++j)
+		{
+			for (size_t i=0; i<path_pixels.size(); ++i)
+			{
+				const double dx = path_pixels[i].x - patch[j].x;
+				const double dy = path_pixels[i].y - patch[j].y;
+				if (dx*dx+dy*dy < min_distance_squared)
+				{
+					min_distance_squared = dx*dx+dy*dy;
+					starting_position = patch[j];
+					closest_pose = i;
+				}
+			}
+		}
+
+		std::vector<geometry_msgs::Pose2D> patch_path;
+		const cv::Point2d patch_origin(map_origin.x + roi.x*map_resolution, map_origin.y + roi.y*map_resolution);
+		plan(patch_map, patch_path, map_resolution, starting_position-roi.tl(), patch_origin, grid_spacing_in_pixel, cell_size);
+		if (patch_path.size() == 0)
+			return;
+		path.insert((closest_pose<path.size() ? path.begin()+closest_pose+1 : path.end()), patch_path.begin(), patch_path.end());
+	}
+
+public:
+	MultiResolutionCoveragePlanner()
+	{
+	}
+
+	// plans the coverage path of room_map with plan on a map downsampled by factor and refines it at full resolution (see class description)
+	// room_map: CV_8UC1 map of the room, 255 = free
+	// path: the resulting coverage path in [m,m,rad]
+	// fov_corners_meter: field of view polygon in robot coordinates in [m], used for checking the coverage in field of view mode
+	// fov_origin: mounting position of the sensor spanning the field of view in robot coordinates in [m], the covered pixels must be
+	//             visible from it
+	// coverage_radius: radius of the footprint coverage in [m], used for checking the coverage in footprint mode
+	// max_uncovered_ratio: maximum ratio of the free area that may stay uncovered in connected patches of at least a quarter grid cell,
+	//                      otherwise the room is planned at full resolution
+	void planPath(const cv::Mat& room_map, std::vector<geometry_msgs::Pose2D>& path, const float map_resolution,
+			const cv::Point& starting_position, const cv::Point2d& map_origin, const double grid_spacing_in_pixel, const int cell_size,
+			const int factor, const std::vector<Eigen::Matrix<float, 2, 1> >& fov_corners_meter, const Eigen::Matrix<float, 2, 1>& fov_origin,
+			const double coverage_radius, const bool plan_for_footprint, const double max_uncovered_ratio, const PlanningFunction& plan) const
+	{
+		path.clear();
+		if (factor <= 1 || grid_spacing_in_pixel/factor < 2.)
+		{
+			plan(room_map, path, map_resolution, starting_position, map_origin, grid_spacing_in_pixel, cell_size);
+			return;
+		}
+
+		// I. plan on the downsampled map, the coarse pixel centers coincide with the centers of their blocks
+		cv::Mat coarse_map;
+		downsampleMap(room_map, coarse_map, factor);
+		const float coarse_map_resolution = map_resolution*factor;
+		const cv::Point2d coarse_map_origin(map_origin.x + 0.5*(factor-1)*map_resolution, map_origin.y + 0.5*(factor-1)*map_resolution);
+		const cv::Point coarse_starting_position(std::min(starting_position.x/factor, coarse_map.cols-1), std::min(starting_position.y/factor, coarse_map.rows-1));
+		plan(coarse_map, path, coarse_map_resolution, coarse_starting_position, coarse_map_origin, grid_spacing_in_pixel/factor, std::max(1, cell_size/factor));
+		std::cout << "MultiResolutionCoveragePlanner::planPath: coarse path with " << path.size() << " poses on a map downsampled by " << factor << std::endl;
+
+		// II. lift the path to the full resolution map
+		liftPath(room_map, path, map_resolution, map_origin, factor);
+
+		// III. refine the uncovered patches at full resolution
+		const double min_patch_area = 0.25*grid_spacing_in_pixel*grid_spacing_in_pixel;
+		std::vector<std::vector<cv::Point> > patches;
+		findUncoveredPatches(room_map, path, map_resolution, map_origin, fov_corners_meter, fov_origin, coverage_radius, plan_for_footprint, min_patch_area, patches);
+		for (size_t i=0; i<patches.size(); ++i)
+			refinePatch(room_map, patches[i], path, map_resolution, map_origin, grid_spacing_in_pixel, cell_size, plan);
+		std::cout << "MultiResolutionCoveragePlanner::planPath: refined " << patches.size() << " uncovered patches, path has " << path.size() << " poses" << std::endl;
+
+		// IV. coverage guarantee check, fall back to planning at full resolution if too much of the room remains uncovered
+		const int uncovered_area = findUncoveredPatches(room_map, path, map_resolution, map_origin, fov_corners_meter, fov_origin, coverage_radius,
+				plan_for_footprint, min_patch_area, patches);
+		const int free_area = cv::countNonZero(room_map == 255);
+		if (path.size()==0 || uncovered_area > max_uncovered_ratio*free_area)
+		{
+			std::cout << "MultiResolutionCoveragePlanner::planPath: " << uncovered_area << " of " << free_area
+					<< " pixels remain uncovered, planning at full resolution" << std::endl;
+			path.clear();
+			plan(room_map, path, map_resolution, starting_position, map_origin, grid_spacing_in_pixel, cell_size);
+		}
+	}
+};
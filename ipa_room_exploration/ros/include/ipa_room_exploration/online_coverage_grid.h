@@ -0,0 +1,224 @@
+/*!
+ *****************************************************************
+ * \file
+ *
+ * \note
+ * Copyright (c) 2026 \n
+ * Fraunhofer Institute for Manufacturing Engineering
+ * and Automation (IPA) \n\n
+ *
+ *****************************************************************
+ *
+ * \note
+ * Project name: Care-O-bot
+ * \note
+ * ROS stack name: autopnp
+ * \note
+ * ROS package name: ipa_room_exploration
+ *
+ * \brief
+ *
+ *
+ *****************************************************************
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer. \n
+ * - Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution. \n
+ * - Neither the name of the Fraunhofer Institute for Manufacturing
+ * Engineering and Automation (IPA) nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission. \n
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <cmath>
+
+#include <opencv2/opencv.hpp>
+#include <Eigen/Dense>
+
+#include <geometry_msgs/Pose2D.h>
+
+
+// Rolling coverage map that is updated with the tracked robot poses during the execution of a coverage path. It uses the same
+// encoding as the coverage map of the CoverageCheckServer (0 = obstacle, 255 = free and not covered yet, 127 = covered), so it
+// can replace the coverage check of the whole trajectory after the execution. Each update only touches the bounding box of the
+// area covered at the respective pose.
+class OnlineCoverageGrid
+{
+protected:
+	cv::Mat coverage_map_;		// CV_8UC1 map of the room in [pixel], 0 = obstacle, 255 = free, 127 = covered
+	float map_resolution_;		// in [m/pixel]
+	cv::Point2d map_origin_;	// in [m]
+	std::vector<Eigen::Matrix<float, 2, 1> > field_of_view_;	// field of view polygon in robot coordinates, in [m]
+	Eigen::Matrix<float, 2, 1> fov_origin_;	// origin of the field of view (the sensor location) in robot coordinates, in [m]
+	int coverage_radius_pixel_;	// radius of the footprint coverage in [pixel]
+	bool check_for_footprint_;	// if true the covered area is the circle with coverage_radius around the robot, else the visible part of the field of view
+
+	bool has_last_pose_;		// true after the first call of addRobotPose
+	cv::Point last_pose_pixel_;	// last pose that was drawn into the map, in [pixel]
+	double last_pose_theta_;	// in [rad]
+
+	inline cv::Point worldToPixel(const float x, const float y) const
+	{
+		const float map_resolution_inverse = 1./map_resolution_;
+		return cv::Point((x-map_origin_.x)*map_resolution_inverse, (y-map_origin_.y)*map_resolution_inverse);
+	}
+
+	inline cv::Point clampImageCoordinates(const cv::Point& p) const
+	{
+		return cv::Point(std::min(std::max(p.x, 0), coverage_map_.cols-1), std::min(std::max(p.y, 0), coverage_map_.rows-1));
+	}
+
+	// calls visitor(u,v) for each free pixel that is covered by the robot at pose (given in [m,m,rad]), i.e. the pixels inside the
+	// coverage circle for footprint coverage or the pixels inside the field of view that are visible from the fov origin
+	template <typename Visitor>
+	void visitCoveredPixels(const geometry_msgs::Pose2D& pose, Visitor& visitor) const
+	{
+		if (check_for_footprint_ == true)
+		{
+			const cv::Point center = worldToPixel(pose.x, pose.y);
+			const int r = coverage_radius_pixel_;
+			for (int v=std::max(0, center.y-r); v<=std::min(coverage_map_.rows-1, center.y+r); ++v)
+			{
+				const uchar* map_row = coverage_map_.ptr<uchar>(v);
+				const int dv = v-center.y;
+				for (int u=std::max(0, center.x-r); u<=std::min(coverage_map_.cols-1, center.x+r); ++u)
+				{
+					const int du = u-center.x;
+					if (map_row[u]!=0 && du*du+dv*dv<=r*r)
+						visitor(u, v);
+				}
+			}
+			return;
+		}
+
+		// transform the field of view into the map, like the CoverageCheckServer does
+		const float sin_theta = std::sin(pose.theta);
+		const float cos_theta = std::cos(pose.theta);
+		Eigen::Matrix<float, 2, 2> R;
+		R << cos_theta, -sin_theta, sin_theta, cos_theta;
+		Eigen::Matrix<float, 2, 1> pose_as_matrix;
+		pose_as_matrix << pose.x, pose.y;
+		std::vector<cv::Point> fov_polygon(field_of_view_.size());
+		for (size_t i=0; i<field_of_view_.size(); ++i)
+		{
+			const Eigen::Matrix<float, 2, 1> p = pose_as_matrix + R * field_of_view_[i];
+			fov_polygon[i] = clampImageCoordinates(worldToPixel(p(0,0), p(1,0)));
+		}
+		const Eigen::Matrix<float, 2, 1> o = pose_as_matrix + R * fov_origin_;
+		const cv::Point fov_origin_pixel = clampImageCoordinates(worldToPixel(o(0,0), o(1,0)));
+
+		// rasterize the field of view only within its bounding box
+		const cv::Rect bbox = cv::boundingRect(fov_polygon);
+		cv::Mat fov_mask = cv::Mat::zeros(bbox.height, bbox.width, CV_8UC1);
+		std::vector<std::vector<cv::Point> > contours(1, fov_polygon);
+		cv::fillPoly(fov_mask, contours, cv::Scalar(255), 8, 0, -bbox.tl());
+		for (int v=0; v<fov_mask.rows; ++v)
+		{
+			const uchar* mask_row = fov_mask.ptr<uchar>(v);
+			for (int u=0; u<fov_mask.cols; ++u)
+			{
+				if (mask_row[u]==0)
+					continue;
+				const cv::Point current_point(bbox.x+u, bbox.y+v);
+				if (coverage_map_.at<uchar>(current_point)==0)
+					continue;
+
+				// verify visibility on the line from the fov origin to the current point
+				bool point_visible = true;
+				cv::LineIterator ray_points(coverage_map_, fov_origin_pixel, current_point, 8, false);
+				for (int point=0; point<ray_points.count; ++point, ++ray_points)
+				{
+					if (**ray_points == 0)
+					{
+						point_visible = false;
+						break;
+					}
+				}
+				if (point_visible == true)
+					visitor(current_point.x, current_point.y);
+			}
+		}
+	}
+
+	struct CoverageDrawer
+	{
+		cv::Mat& map;
+		CoverageDrawer(cv::Mat& map_) : map(map_) {}
+		void operator()(const int u, const int v) { map.at<uchar>(v,u) = 127; }
+	};
+
+	struct CoverageCounter
+	{
+		const cv::Mat& map;
+		int covered, total;
+		CoverageCounter(const cv::Mat& map_) : map(map_), covered(0), total(0) {}
+		void operator()(const int u, const int v) { ++total; if (map.at<uchar>(v,u)==127) ++covered; }
+	};
+
+public:
+	// room_map: CV_8UC1 map of the room, free space is 255, obstacles 0
+	// map_resolution in [m/pixel], map_origin in [m], field_of_view and fov_origin in robot coordinates in [m], coverage_radius in [m]
+	OnlineCoverageGrid(const cv::Mat& room_map, const float map_resolution, const cv::Point2d& map_origin,
+			const std::vector<Eigen::Matrix<float, 2, 1> >& field_of_view, const Eigen::Matrix<float, 2, 1>& fov_origin,
+			const double coverage_radius, const bool check_for_footprint)
+	: map_resolution_(map_resolution), map_origin_(map_origin), field_of_view_(field_of_view), fov_origin_(fov_origin),
+	  coverage_radius_pixel_(coverage_radius/map_resolution), check_for_footprint_(check_for_footprint), has_last_pose_(false),
+	  last_pose_theta_(0.)
+	{
+		cv::threshold(room_map, coverage_map_, 127, 255, cv::THRESH_BINARY);
+	}
+
+	// marks the area that is covered by the robot at pose (in [m,m,rad]), poses that do not differ from the last added pose are skipped
+	void addRobotPose(const geometry_msgs::Pose2D& pose)
+	{
+		const cv::Point pose_pixel = worldToPixel(pose.x, pose.y);
+		if (has_last_pose_==true && pose_pixel==last_pose_pixel_ && (check_for_footprint_==true || std::fabs(pose.theta-last_pose_theta_)<0.02))
+			return;
+		has_last_pose_ = true;
+		last_pose_pixel_ = pose_pixel;
+		last_pose_theta_ = pose.theta;
+
+		CoverageDrawer drawer(coverage_map_);
+		visitCoveredPixels(pose, drawer);
+	}
+
+	// returns the fraction of the area that the robot would cover at pose (in [m,m,rad]) which has already been covered,
+	// 1 if there is nothing to cover at this pose
+	double getCoveredRatio(const geometry_msgs::Pose2D& pose) const
+	{
+		CoverageCounter counter(coverage_map_);
+		visitCoveredPixels(pose, counter);
+		if (counter.total == 0)
+			return 1.;
+		return (double)counter.covered/(double)counter.total;
+	}
+
+	// the current coverage map, 0 = obstacle, 255 = free and not covered yet, 127 = covered
+	const cv::Mat& getCoverageMap() const
+	{
+		return coverage_map_;
+	}
+};
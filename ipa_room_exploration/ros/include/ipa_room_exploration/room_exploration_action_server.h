@@ -82,8 +82,11 @@
 #include <vector>
 #include <algorithm>
 #include <cmath>
+// Boost
+#include <boost/thread.hpp>
 // services and actions
 #include <ipa_building_msgs/RoomExplorationAction.h>
+#include <ipa_building_msgs/RoomExplorationBatchAction.h>
 #include <cob_map_accessibility_analysis/CheckPerimeterAccessibility.h>
 #include <ipa_building_msgs/CheckCoverage.h>
 // messages
@@ -105,9 +108,12 @@
 #include <ipa_room_exploration/flow_network_explorator.h>
 #include <ipa_room_exploration/fov_to_robot_mapper.h>
 #include <ipa_room_exploration/energy_functional_explorator.h>
-#include <ipa_room_exploration/voronoi.hpp>
 #include <ipa_room_exploration/room_rotator.h>
+#include <ipa_room_exploration/path_post_processor.h>
 #include <ipa_room_exploration/coverage_check_server.h>
+#include <ipa_room_exploration/online_coverage_grid.h>
+#include <ipa_room_exploration/multi_resolution_coverage_planner.h>
+#include <ipa_room_exploration/room_exploration_planner.h>
 
 
 #define PI 3.14159265359
@@ -122,30 +128,19 @@ protected:
 
 	ros::Publisher path_pub_; // a publisher sending the path as a nav_msgs::Path before executing
 
-	GridPointExplorator grid_point_planner; // object that uses the grid point method to plan a path trough a room
-	BoustrophedonExplorer boustrophedon_explorer_; // object that uses the boustrophedon exploration method to plan a path trough the room
-	NeuralNetworkExplorator neural_network_explorator_; // object that uses the neural network method to create an exploration path
-	convexSPPExplorator convex_SPP_explorator_; // object that uses the convex spp exploration methd to create an exploration path
-	FlowNetworkExplorator flow_network_explorator_; // object that uses the flow network exploration method to create an exploration path
-	EnergyFunctionalExplorator energy_functional_explorator_; // object that uses the energy functional exploration method to create an exploration path
-	BoustrophedonVariantExplorer boustrophedon_variant_explorer_; // object that uses the boustrophedon variant exploration method to plan a path trough the room
+	RoomExplorationPlanner room_exploration_planner_;	// plans the coverage paths of the single room and the batch action
+	ExplorationPlanners planners_; // planner objects used by the single room action
+
+	nav_msgs::OccupancyGrid::ConstPtr latest_global_costmap_;	// latest global costmap received during the execution of a path, empty if none was received yet
+	boost::mutex global_costmap_mutex_;	// protects latest_global_costmap_, which is written by the subscriber callback
 
 	// parameters
-	int room_exploration_algorithm_;	// variable to specify which algorithm is going to be used to plan a path
-										// 1: grid point explorator
-										// 2: boustrophedon explorator
-										// 3: neural network explorator
-										// 4: convexSPP explorator
-										// 5: flowNetwork explorator
-										// 6: energyFunctional explorator
-										// 7: Voronoi explorator
-										// 8: boustrophedon variant explorator
+	RoomExplorationPlannerParameters planner_parameters_;	// algorithm and planner parameters, each planning call works on a copy
+	boost::mutex planner_parameters_mutex_;	// protects planner_parameters_ and number_of_planning_threads_, which are written by the dynamic reconfigure callback
 	bool display_trajectory_;		// display final trajectory plan step by step
 
-	// parameters on map correction
-	int map_correction_closing_neighborhood_size_;	// Applies a closing operation to neglect inaccessible areas and map errors/artifacts if the
-													// map_correction_closing_neighborhood_size parameter is larger than 0.
-													// The parameter then specifies the iterations (or neighborhood size) of that closing operation.
+	// parameters of the batch action
+	int number_of_planning_threads_;	// number of rooms that are planned in parallel by the batch action, <= 0 uses one thread per available cpu core
 
 	// parameters specific to the navigation of the robot along the computed coverage trajectory
 	bool return_path_;				// boolean used to determine if the server should return the computed coverage path in the response message
@@ -159,47 +154,15 @@ protected:
 									// execution of the coverage path, due to uncertainties or dynamic obstacles
 	double left_sections_min_area_; // variable to determine the minimal area that not seen sections must have before they
 									// are revisited after one run through the room
+	bool online_coverage_execution_;	// tracks the coverage during the execution, skips goals whose coverage area is already covered and checks
+										// the reachability of the next goals in batches against the latest global costmap
+	double skip_covered_goals_ratio_;	// fraction of the coverage area of a goal that must already be covered to skip the goal
+	int reachability_batch_size_;	// number of upcoming goals that are checked for reachability against one costmap snapshot, <= 0 turns the check off
 	std::string global_costmap_topic_;	// name of the global costmap topic
 	std::string coverage_check_service_name_;	// name of the service to call for a coverage check of the driven trajectory
 	std::string map_frame_;			// string that carries the name of the map frame, used for tracking of the robot
 	std::string camera_frame_;				// string that carries the name of the camera frame, that is in the same kinematic chain as the map_frame and shows the camera pose
 
-	// parameters specific to the grid point explorator
-	int tsp_solver_;	// indicates which TSP solver should be used
-						//   1 = Nearest Neighbor
-						//   2 = Genetic solver
-						//   3 = Concorde solver
-	int64_t tsp_solver_timeout_;	// a sophisticated solver like Concorde or Genetic can be interrupted if it does not find a solution within this time, in [s], and then falls back to the nearest neighbor solver
-
-	// parameters specific for the boustrophedon explorator
-	double min_cell_area_;			// minimal area a cell can have, when using the boustrophedon explorator
-	double path_eps_;		// the distance between points when generating a path
-	double grid_obstacle_offset_;	// in [m], the additional offset of the grid to obstacles, i.e. allows to displace the grid by more than the standard half_grid_size from obstacles
-	int max_deviation_from_track_;	// in [pixel], maximal allowed shift off the ideal boustrophedon track to both sides for avoiding obstacles on track
-									// setting max_deviation_from_track=grid_spacing is usually a good choice
-									// for negative values (e.g. max_deviation_from_track: -1) max_deviation_from_track is automatically set to grid_spacing
-	int cell_visiting_order_;		// cell visiting order
-									//   1 = optimal visiting order of the cells determined as TSP problem
-									//   2 = alternative ordering from left to right (measured on y-coordinates of the cells), visits the cells in a more obvious fashion to the human observer (though it is not optimal)
-
-
-	// parameters specific for the neural network explorator, see "A Neural Network Approach to Complete Coverage Path Planning" from Simon X. Yang and Chaomin Luo
-	double step_size_; // step size for integrating the state dynamics
-	int A_; // decaying parameter that pulls the activity of a neuron closer to zero, larger value means faster decreasing
-	int B_; // increasing parameter that tries to increase the activity of a neuron when it's not too big already, higher value means a higher desired value and a faster increasing at the beginning
-	int D_; // decreasing parameter when the neuron is labeled as obstacle, higher value means faster decreasing
-	int E_; // external input parameter of one neuron that is used in the dynamics corresponding to if it is an obstacle or uncleaned/cleaned, E>>B
-	double mu_; // parameter to set the importance of the states of neighboring neurons to the dynamics, higher value means higher influence
-	double delta_theta_weight_; // parameter to set the importance of the traveleing direction from the previous step and the next step, a higher value means that the robot should turn less
-
-	// parameters specific for the convexSPP explorator
-	int cell_size_;				// size of one cell that is used to discretize the free space
-	double delta_theta_;			// sampling angle when creating possible sensing poses in the convexSPP explorator
-
-	// parameters specific for the flowNetwork explorator
-	double curvature_factor_; // double that shows the factor, an arc can be longer than a straight arc when using the flowNetwork explorator
-	double max_distance_factor_; // double that shows how much an arc can be longer than the maximal distance of the room, which is determined by the min/max coordinates that are set in the goal
-
 
 	// callback function for dynamic reconfigure
 	void dynamic_reconfigure_callback(ipa_room_exploration::RoomExplorationConfig &config, uint32_t level);
@@ -207,16 +170,21 @@ protected:
 	// this is the execution function used by action server
 	void exploreRoom(const ipa_building_msgs::RoomExplorationGoalConstPtr &goal);
 
-	// remove unconnected, i.e. inaccessible, parts of the room (i.e. obstructed by furniture), only keep the room with the largest area
-	bool removeUnconnectedRoomParts(cv::Mat& room_map);
+	// this is the execution function used by the batch action server, it plans the coverage paths of several rooms of a segmented map in parallel
+	void exploreRooms(const ipa_building_msgs::RoomExplorationBatchGoalConstPtr &goal);
 
-	// clean path from subsequent double occurrences of the same pose
-	// min_dist_squared is the squared minimum distance between two points on the trajectory, in [pixel] (i.e. grid cells)
-	void downsampleTrajectory(const std::vector<geometry_msgs::Pose2D>& path_uncleaned, std::vector<geometry_msgs::Pose2D>& path, const double min_dist_squared);
+	// stores the latest global costmap for the reachability checks during the execution
+	void globalCostmapCallback(const nav_msgs::OccupancyGrid::ConstPtr& global_costmap);
 
+	// checks which of the goals exploration_path[first_goal, first_goal+number_of_goals) are connected to the current robot position
+	// through the free space of the latest global costmap, with one flood fill for the whole batch
+	// all goals count as reachable if no costmap or no robot pose is available yet
+	void computeGoalReachability(const std::vector<geometry_msgs::Pose2D>& exploration_path, const size_t first_goal, const size_t number_of_goals,
+			const std::vector<geometry_msgs::Pose2D>& robot_poses, std::vector<bool>& goal_reachable);
 
 	// excute the planned trajectory and drive to unexplored areas after moving along the computed path
-	void navigateExplorationPath(const std::vector<geometry_msgs::Pose2D>& exploration_path, const std::vector<geometry_msgs::Point32>& field_of_view,
+	// room_map is the preprocessed map of the room that was used for planning (used for tracking the coverage online)
+	void navigateExplorationPath(const std::vector<geometry_msgs::Pose2D>& exploration_path, const cv::Mat& room_map, const std::vector<geometry_msgs::Point32>& field_of_view,
 			const geometry_msgs::Point32& field_of_view_origin, const double coverage_radius, const double distance_robot_fov_middlepoint,
 			const float map_resolution, const geometry_msgs::Pose& map_origin, const double grid_spacing_in_pixel, const double map_height);
 
@@ -280,6 +248,7 @@ protected:
 	//
 	ros::NodeHandle node_handle_;
 	actionlib::SimpleActionServer<ipa_building_msgs::RoomExplorationAction> room_exploration_server_;
+	actionlib::SimpleActionServer<ipa_building_msgs::RoomExplorationBatchAction> room_exploration_batch_server_;
 	dynamic_reconfigure::Server<ipa_room_exploration::RoomExplorationConfig> room_exploration_dynamic_reconfigure_server_;
 
 public:
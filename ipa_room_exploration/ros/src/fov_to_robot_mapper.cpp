@@ -59,10 +59,88 @@
 
 #include <ipa_room_exploration/fov_to_robot_mapper.h>
 
+// Computes the distance and the label of the closest accessible pixel for each pixel of the map with one distance transform on the
+// inverted map, and labels the connected accessible areas (8-neighborhood) with a flood fill.
+void AccessibilityField::compute(const cv::Mat& room_map)
+{
+	// accessible pixels are the zero pixels of the inverted map, each of them gets its own label
+	cv::Mat inaccessible_area = (room_map != 255);
+	cv::distanceTransform(inaccessible_area, distance_to_accessible_area, nearest_accessible_pixel_label, CV_DIST_L2, 5, cv::DIST_LABEL_PIXEL);
+
+	// store the position of each accessible pixel label and label the connected accessible areas, starting at 256 to not mix
+	// up the labels with the accessible value 255
+	accessible_pixels.clear();
+	room_map.convertTo(area_labels, CV_32SC1);
+	area_labels.setTo(0, inaccessible_area);
+	int area_label = 256;
+	for (int v=0; v<room_map.rows; ++v)
+	{
+		for (int u=0; u<room_map.cols; ++u)
+		{
+			if (room_map.at<uchar>(v,u) != 255)
+				continue;
+
+			const int pixel_label = nearest_accessible_pixel_label.at<int>(v,u);
+			if (pixel_label >= (int)accessible_pixels.size())
+				accessible_pixels.resize(pixel_label+1, cv::Point(-1,-1));
+			accessible_pixels[pixel_label] = cv::Point(u,v);
+
+			if (area_labels.at<int>(v,u) == 255)
+			{
+				cv::floodFill(area_labels, cv::Point(u,v), cv::Scalar(area_label), 0, cv::Scalar(), cv::Scalar(), 8);
+				++area_label;
+			}
+		}
+	}
+}
+
+// returns the accessible pixel that is closest to the given point, or (-1,-1) if there is no accessible pixel
+cv::Point AccessibilityField::nearestAccessiblePixel(const cv::Point& point) const
+{
+	if (accessible_pixels.size() == 0)
+		return cv::Point(-1,-1);
+	const int pixel_label = nearest_accessible_pixel_label.at<int>(point);
+	if (pixel_label < 0 || pixel_label >= (int)accessible_pixels.size())
+		return cv::Point(-1,-1);
+	return accessible_pixels[pixel_label];
+}
+
+// returns the label of the connected accessible area that contains the closest accessible pixel to the given point, points outside
+// the map are moved to the closest map pixel, 0 is returned if there is no accessible pixel
+int AccessibilityField::areaLabel(const cv::Point& point) const
+{
+	const cv::Point map_point(std::min(std::max(point.x, 0), area_labels.cols-1), std::min(std::max(point.y, 0), area_labels.rows-1));
+	const cv::Point accessible_pixel = nearestAccessiblePixel(map_point);
+	if (accessible_pixel.x < 0)
+		return 0;
+	return area_labels.at<int>(accessible_pixel);
+}
+
+// returns true if the given point is inside the map and accessible
+bool AccessibilityField::isAccessible(const cv::Point& point) const
+{
+	if (point.x < 0 || point.x >= area_labels.cols || point.y < 0 || point.y >= area_labels.rows)
+		return false;
+	return area_labels.at<int>(point) != 0;
+}
+
+// returns false if there is certainly no accessible pixel within the given radius around the given point, the distance transform
+// with labels only supports the 5x5 mask, so a small margin for its approximation error is added
+bool AccessibilityField::hasAccessiblePixelWithin(const cv::Point& point, const double radius) const
+{
+	if (accessible_pixels.size() == 0)
+		return false;
+	if (point.x < 0 || point.x >= distance_to_accessible_area.cols || point.y < 0 || point.y >= distance_to_accessible_area.rows)
+		return true;
+	return distance_to_accessible_area.at<float>(point) <= 1.05*radius + 2.;
+}
+
 // Function that provides the functionality that a given fov path gets mapped to a robot path by using the given parameters.
 // To do so simply a vector operation is applied. If the computed robot pose is not in the free space, another accessible
 // point is generated by finding it on the radius around the fov middlepoint s.t. the distance to the last robot position
-// is minimized.
+// is minimized. The accessibility of the computed robot poses is read from a precomputed AccessibilityField, so the perimeter
+// around the fov middlepoint is only searched for the poses whose computed robot pose is not accessible. Fov poses without
+// any accessible pixel within the fov radius are identified with the AccessibilityField and skipped without searching the map.
 // Important: the room map needs to be an unsigned char single channel image, if inaccessible areas should be excluded, provide the inflated map
 // robot_to_fov_vector in [m]
 void mapPath(const cv::Mat& room_map, std::vector<geometry_msgs::Pose2D>& robot_path,
@@ -71,10 +149,13 @@ void mapPath(const cv::Mat& room_map, std::vector<geometry_msgs::Pose2D>& robot_
 {
 	// initialize helper classes
 	MapAccessibilityAnalysis map_accessibility;
-	AStarPlanner path_planner;
 	const double map_resolution_inv = 1.0/map_resolution;
 
-	// initialize the robot position in accessible space to enable the Astar planner to find a path from the beginning
+	// precompute the distances to the accessible area and its connected components once for all poses
+	AccessibilityField accessibility_field;
+	accessibility_field.compute(room_map);
+
+	// initialize the robot position in accessible space to enable the search for reachable positions from the beginning
 	cv::Point robot_pos(starting_point.x, starting_point.y);
 //	std::vector<MapAccessibilityAnalysis::Pose> accessible_start_poses_on_perimeter;
 //	map_accessibility.checkPerimeter(accessible_start_poses_on_perimeter, fov_center, fov_radius_pixel, PI/64., room_map, false, robot_pos);
@@ -88,101 +169,23 @@ void mapPath(const cv::Mat& room_map, std::vector<geometry_msgs::Pose2D>& robot_
 	std::cout << "fov_radius_pixel: " << fov_radius_pixel << "      robot_to_fov_vector: " << robot_to_fov_vector(0,0) << ", " << robot_to_fov_vector(1,0) << std::endl;
 
 	// go trough the given poses and calculate accessible robot poses
-	// first try with A*, if this fails, call map_accessibility_analysis and finally try a directly computed pose shift
-	int found_with_astar = 0, found_with_map_acc = 0, found_with_shift = 0, not_found = 0;
+	// first try a directly computed pose shift, if this pose is not accessible, try with map_accessibility_analysis and finally
+	// search the closest accessible position around the fov center
+	int found_with_local_search = 0, found_with_map_acc = 0, found_with_shift = 0, not_found = 0;
 	for(std::vector<geometry_msgs::Pose2D>::const_iterator pose=fov_path.begin(); pose!=fov_path.end(); ++pose)
 	{
 		bool found_pose = false;
 
-		// 1. try with map_accessibility_analysis
-		// compute accessible locations on perimeter around target fov center
-		MapAccessibilityAnalysis::Pose fov_center(pose->x, pose->y, pose->theta);
-		std::vector<MapAccessibilityAnalysis::Pose> accessible_poses_on_perimeter;
-		map_accessibility.checkPerimeter(accessible_poses_on_perimeter, fov_center, fov_radius_pixel, PI/64., room_map, false, robot_pos);
-
-		//std::cout << "  fov_center: " << fov_center.x << ", " << fov_center.y << ", " << fov_center.orientation << "           accessible_poses_on_perimeter.size: " << accessible_poses_on_perimeter.size() << std::endl;
-
-		if(accessible_poses_on_perimeter.size()!=0)
+		// 0. if no accessible pixel is within the fov radius around the fov center, none of the following steps can find a pose
+		const cv::Point fov_position(pose->x, pose->y);
+		if (accessibility_field.hasAccessiblePixelWithin(fov_position, fov_radius_pixel) == false)
 		{
-			// todo: also consider complete visibility of the fov_center (or whole cell) as a selection criterion
-			// todo: extend with a complete consideration of the exact robot footprint
-			// go trough the found accessible positions and take the one that minimizes the angle between approach vector and robot heading direction at the target position
-			// and which lies in the half circle around fov_center which is "behind" the fov_center pose's orientation
-//			double max_cos_alpha = -10;
-			std::map<double, MapAccessibilityAnalysis::Pose, std::greater<double> > cos_alpha_to_perimeter_pose_mapping;		// maps (positive) cos_alpha to their perimeter poses
-			MapAccessibilityAnalysis::Pose best_pose;
-			//std::cout << "Perimeter: \n robot_pos = " << robot_pos.x << ", " << robot_pos.y << "     fov_center = " << fov_center.x << ", " << fov_center.y << "\n";
-			for(std::vector<MapAccessibilityAnalysis::Pose>::iterator perimeter_pose = accessible_poses_on_perimeter.begin(); perimeter_pose != accessible_poses_on_perimeter.end(); ++perimeter_pose)
-			{
-				// exclude positions that are ahead of the moving direction
-				//cv::Point2d heading = cv::Point2d(fov_center.x, fov_center.y) - cv::Point2d(perimeter_pose->x, perimeter_pose->y);
-				//const double heading_norm = sqrt((double)heading.x*heading.x+heading.y*heading.y);
-				perimeter_pose->orientation -= fov_to_front_offset_angle; // robot heading correction of off-center fov
-				const cv::Point2d perimeter_heading = cv::Point2d(cos(perimeter_pose->orientation), sin(perimeter_pose->orientation));
-				const double perimeter_heading_norm = 1.;
-				const cv::Point2d fov_center_heading = cv::Point2d(cos(fov_center.orientation), sin(fov_center.orientation));
-				const double fov_center_heading_norm = 1.;
-				const double cos_alpha = (fov_center_heading.x*perimeter_heading.x+fov_center_heading.y*perimeter_heading.y)/(fov_center_heading_norm*perimeter_heading_norm);
-				//std::cout << "  cos_alpha: " << cos_alpha << std::endl;
-//				if (cos_alpha < 0)
-//					continue;
-				if (cos_alpha >= 0.)
-					cos_alpha_to_perimeter_pose_mapping[cos_alpha] = *perimeter_pose;		// rank by cos(angle) between approach direction and viewing direction
-
-				// rank by cos(angle) between approach direction and viewing direction
-				//cv::Point2d approach = cv::Point2d(perimeter_pose->x, perimeter_pose->y) - cv::Point2d(robot_pos.x, robot_pos.y);
-				//const double approach_norm = sqrt(approach.x*approach.x+approach.y*approach.y);
-//				double cos_alpha = 1.;		// only remains 1.0 if robot_pose and perimeter_pose are identical
-//				if (fov_center_heading.x!=0 || fov_center_heading.y!=0)	// compute the cos(angle) between approach direction and viewing direction
-//					cos_alpha = (fov_center_heading.x*perimeter_heading.x + fov_center_heading.y*perimeter_heading.y)/(fov_center_heading_norm*perimeter_heading_norm);
-				//std::cout << " - perimeter_pose = " << perimeter_pose->x << ", " << perimeter_pose->y << "     cos_alpha = " << cos_alpha << "   max_cos_alpha = " << max_cos_alpha << std::endl;
-//				if(cos_alpha>max_cos_alpha)
-//				{
-//					max_cos_alpha = cos_alpha;
-//					best_pose = *perimeter_pose;
-//					found_pose = true;
-//				}
-			}
-//			std::cout << "  cos_alpha_to_perimeter_pose_mapping.size: " << cos_alpha_to_perimeter_pose_mapping.size() << std::endl;
-			if (cos_alpha_to_perimeter_pose_mapping.size() > 0)
-			{
-				// rank by cos(angle) between approach direction and viewing direction
-				double max_cos_alpha = cos_alpha_to_perimeter_pose_mapping.begin()->first;
-				double closest_dist = std::numeric_limits<double>::max();
-				for (std::map<double, MapAccessibilityAnalysis::Pose, std::greater<double> >::iterator it=cos_alpha_to_perimeter_pose_mapping.begin(); it!=cos_alpha_to_perimeter_pose_mapping.end(); ++it)
-				{
-//					std::cout << "    cos_alpha: " << it->first << std::endl;
-					// only consider the best fitting angles
-					if (it->first < 0.95*max_cos_alpha)
-						break;
-					// from those select the position with shortest approach path from current position
-					const double dist = cv::norm(robot_pos-cv::Point(it->second.x, it->second.y));
-					if (dist < closest_dist)
-					{
-						closest_dist = dist;
-						best_pose = it->second;
-						found_pose = true;
-					}
-				}
-//				std::cout << "    closest_dist: " << closest_dist << "    best_pose: " << best_pose.x << ", " << best_pose.y << ", " << best_pose.orientation << std::endl;
-			}
-
-			// add pose to path and set robot position to it
-			if (found_pose == true)
-			{
-				geometry_msgs::Pose2D best_pose_msg;
-				best_pose_msg.x = best_pose.x*map_resolution + map_origin.x;
-				best_pose_msg.y = best_pose.y*map_resolution + map_origin.y;
-				best_pose_msg.theta = best_pose.orientation;
-				robot_path.push_back(best_pose_msg);
-				robot_pos = cv::Point(cvRound(best_pose.x), cvRound(best_pose.y));
-				//std::cout << " best_pose = " << best_pose.x << ", " << best_pose.y << "      max_cos_alpha = " << max_cos_alpha << std::endl;
-				++found_with_map_acc;
-			}
+			++not_found;
+			std::cout << "  not found." << std::endl;
+			continue;
 		}
 
-		// 2. if no accessible pose was found, try with a directly computed pose shift
-		if (found_pose==false)
+		// 1. try with a directly computed pose shift, the robot pose behind the fov center is accessible for most poses
 		{
 			// get the rotation matrix
 			const float sin_theta = std::sin(pose->theta);
@@ -195,11 +198,11 @@ void mapPath(const cv::Mat& room_map, std::vector<geometry_msgs::Pose2D>& robot_
 			Eigen::Matrix<float, 2, 1> robot_position;
 			robot_position << pose->x-v_rel_rot(0,0), pose->y-v_rel_rot(1,0);
 
-			// check the accessibility of the found point
-			geometry_msgs::Pose2D current_pose;
-			if(robot_position(0,0) >= 0 && robot_position(1,0) >= 0 && robot_position(0,0) < room_map.cols &&
-					robot_position(1,0) < room_map.rows && room_map.at<uchar>((int)robot_position(1,0), (int)robot_position(0,0)) == 255) // position accessible
+			// check the accessibility of the found point with the precomputed accessibility field
+			if(robot_position(0,0) >= 0 && robot_position(1,0) >= 0 &&
+					accessibility_field.isAccessible(cv::Point((int)robot_position(0,0), (int)robot_position(1,0))) == true) // position accessible
 			{
+				geometry_msgs::Pose2D current_pose;
 				current_pose.x = (robot_position(0,0) * map_resolution) + map_origin.x;
 				current_pose.y = (robot_position(1,0) * map_resolution) + map_origin.y;
 				current_pose.theta = pose->theta;
@@ -213,23 +216,122 @@ void mapPath(const cv::Mat& room_map, std::vector<geometry_msgs::Pose2D>& robot_
 			}
 		}
 
+		// 2. if the shifted pose is not accessible, try with map_accessibility_analysis (rare fallback)
 		if (found_pose==false)
 		{
-			// 3. if still no accessible position was found, try with computing the A* path from robot position to fov_center and stop at the right distance
-			// get vector from current position to desired fov position
-			cv::Point fov_position(pose->x, pose->y);
-			std::vector<cv::Point> astar_path;
-			path_planner.planPath(room_map, robot_pos, fov_position, 1.0, 0.0, map_resolution, 0, &astar_path);
+			// compute accessible locations on perimeter around target fov center
+			MapAccessibilityAnalysis::Pose fov_center(pose->x, pose->y, pose->theta);
+			std::vector<MapAccessibilityAnalysis::Pose> accessible_poses_on_perimeter;
+			map_accessibility.checkPerimeter(accessible_poses_on_perimeter, fov_center, fov_radius_pixel, PI/64., room_map, false, robot_pos);
+
+			//std::cout << "  fov_center: " << fov_center.x << ", " << fov_center.y << ", " << fov_center.orientation << "           accessible_poses_on_perimeter.size: " << accessible_poses_on_perimeter.size() << std::endl;
+
+			if(accessible_poses_on_perimeter.size()!=0)
+			{
+				// todo: also consider complete visibility of the fov_center (or whole cell) as a selection criterion
+				// todo: extend with a complete consideration of the exact robot footprint
+				// go trough the found accessible positions and take the one that minimizes the angle between approach vector and robot heading direction at the target position
+				// and which lies in the half circle around fov_center which is "behind" the fov_center pose's orientation
+//				double max_cos_alpha = -10;
+				std::map<double, MapAccessibilityAnalysis::Pose, std::greater<double> > cos_alpha_to_perimeter_pose_mapping;		// maps (positive) cos_alpha to their perimeter poses
+				MapAccessibilityAnalysis::Pose best_pose;
+				//std::cout << "Perimeter: \n robot_pos = " << robot_pos.x << ", " << robot_pos.y << "     fov_center = " << fov_center.x << ", " << fov_center.y << "\n";
+				for(std::vector<MapAccessibilityAnalysis::Pose>::iterator perimeter_pose = accessible_poses_on_perimeter.begin(); perimeter_pose != accessible_poses_on_perimeter.end(); ++perimeter_pose)
+				{
+					// exclude positions that are ahead of the moving direction
+					//cv::Point2d heading = cv::Point2d(fov_center.x, fov_center.y) - cv::Point2d(perimeter_pose->x, perimeter_pose->y);
+					//const double heading_norm = sqrt((double)heading.x*heading.x+heading.y*heading.y);
+					perimeter_pose->orientation -= fov_to_front_offset_angle; // robot heading correction of off-center fov
+					const cv::Point2d perimeter_heading = cv::Point2d(cos(perimeter_pose->orientation), sin(perimeter_pose->orientation));
+					const double perimeter_heading_norm = 1.;
+					const cv::Point2d fov_center_heading = cv::Point2d(cos(fov_center.orientation), sin(fov_center.orientation));
+					const double fov_center_heading_norm = 1.;
+					const double cos_alpha = (fov_center_heading.x*perimeter_heading.x+fov_center_heading.y*perimeter_heading.y)/(fov_center_heading_norm*perimeter_heading_norm);
+					//std::cout << "  cos_alpha: " << cos_alpha << std::endl;
+//					if (cos_alpha < 0)
+//						continue;
+					if (cos_alpha >= 0.)
+						cos_alpha_to_perimeter_pose_mapping[cos_alpha] = *perimeter_pose;		// rank by cos(angle) between approach direction and viewing direction
 
-			// find the point on the astar path that is on the viewing circle around the fov middlepoint
+					// rank by cos(angle) between approach direction and viewing direction
+					//cv::Point2d approach = cv::Point2d(perimeter_pose->x, perimeter_pose->y) - cv::Point2d(robot_pos.x, robot_pos.y);
+					//const double approach_norm = sqrt(approach.x*approach.x+approach.y*approach.y);
+//					double cos_alpha = 1.;		// only remains 1.0 if robot_pose and perimeter_pose are identical
+//					if (fov_center_heading.x!=0 || fov_center_heading.y!=0)	// compute the cos(angle) between approach direction and viewing direction
+//						cos_alpha = (fov_center_heading.x*perimeter_heading.x + fov_center_heading.y*perimeter_heading.y)/(fov_center_heading_norm*perimeter_heading_norm);
+					//std::cout << " - perimeter_pose = " << perimeter_pose->x << ", " << perimeter_pose->y << "     cos_alpha = " << cos_alpha << "   max_cos_alpha = " << max_cos_alpha << std::endl;
+//					if(cos_alpha>max_cos_alpha)
+//					{
+//						max_cos_alpha = cos_alpha;
+//						best_pose = *perimeter_pose;
+//						found_pose = true;
+//					}
+				}
+//				std::cout << "  cos_alpha_to_perimeter_pose_mapping.size: " << cos_alpha_to_perimeter_pose_mapping.size() << std::endl;
+				if (cos_alpha_to_perimeter_pose_mapping.size() > 0)
+				{
+					// rank by cos(angle) between approach direction and viewing direction
+					double max_cos_alpha = cos_alpha_to_perimeter_pose_mapping.begin()->first;
+					double closest_dist = std::numeric_limits<double>::max();
+					for (std::map<double, MapAccessibilityAnalysis::Pose, std::greater<double> >::iterator it=cos_alpha_to_perimeter_pose_mapping.begin(); it!=cos_alpha_to_perimeter_pose_mapping.end(); ++it)
+					{
+//						std::cout << "    cos_alpha: " << it->first << std::endl;
+						// only consider the best fitting angles
+						if (it->first < 0.95*max_cos_alpha)
+							break;
+						// from those select the position with shortest approach path from current position
+						const double dist = cv::norm(robot_pos-cv::Point(it->second.x, it->second.y));
+						if (dist < closest_dist)
+						{
+							closest_dist = dist;
+							best_pose = it->second;
+							found_pose = true;
+						}
+					}
+//					std::cout << "    closest_dist: " << closest_dist << "    best_pose: " << best_pose.x << ", " << best_pose.y << ", " << best_pose.orientation << std::endl;
+				}
+
+				// add pose to path and set robot position to it
+				if (found_pose == true)
+				{
+					geometry_msgs::Pose2D best_pose_msg;
+					best_pose_msg.x = best_pose.x*map_resolution + map_origin.x;
+					best_pose_msg.y = best_pose.y*map_resolution + map_origin.y;
+					best_pose_msg.theta = best_pose.orientation;
+					robot_path.push_back(best_pose_msg);
+					robot_pos = cv::Point(cvRound(best_pose.x), cvRound(best_pose.y));
+					//std::cout << " best_pose = " << best_pose.x << ", " << best_pose.y << "      max_cos_alpha = " << max_cos_alpha << std::endl;
+					++found_with_map_acc;
+				}
+			}
+		}
+
+		if (found_pose==false)
+		{
+			// 3. if still no accessible position was found, take the accessible position within the fov radius around the fov center
+			// that is closest to the current robot position and belongs to the same connected area, i.e. can be reached by the robot
+			const int robot_area_label = accessibility_field.areaLabel(robot_pos);
+			const int search_radius = fov_radius_pixel;
+			const double fov_radius_pixel_sqr = fov_radius_pixel*fov_radius_pixel;
 			cv::Point accessible_position;
-			for(std::vector<cv::Point>::iterator point=astar_path.begin(); point!=astar_path.end(); ++point)
+			double min_distance_sqr = std::numeric_limits<double>::max();
+			for (int v=std::max(0, fov_position.y-search_radius); robot_area_label!=0 && v<=std::min(room_map.rows-1, fov_position.y+search_radius); ++v)
 			{
-				if(cv::norm(*point-fov_position) <= fov_radius_pixel)
+				const int* area_labels_ptr = accessibility_field.area_labels.ptr<int>(v);
+				for (int u=std::max(0, fov_position.x-search_radius); u<=std::min(room_map.cols-1, fov_position.x+search_radius); ++u)
 				{
-					accessible_position = *point;
-					found_pose = true;
-					break;
+					if (area_labels_ptr[u] != robot_area_label)
+						continue;
+					const double dx = u-fov_position.x, dy = v-fov_position.y;
+					if (dx*dx+dy*dy > fov_radius_pixel_sqr)
+						continue;
+					const double rx = u-robot_pos.x, ry = v-robot_pos.y;
+					if (rx*rx+ry*ry < min_distance_sqr)
+					{
+						min_distance_sqr = rx*rx+ry*ry;
+						accessible_position = cv::Point(u,v);
+						found_pose = true;
+					}
 				}
 			}
 
@@ -244,7 +346,7 @@ void mapPath(const cv::Mat& room_map, std::vector<geometry_msgs::Pose2D>& robot_
 				robot_path.push_back(current_pose);
 				// set robot position to computed pose s.t. further planning is possible
 				robot_pos = accessible_position;
-				++found_with_astar;
+				++found_with_local_search;
 			}
 		}
 
@@ -266,7 +368,7 @@ void mapPath(const cv::Mat& room_map, std::vector<geometry_msgs::Pose2D>& robot_
 //			std::cout << "  robot_pos: " << robot_path.back().x << ", " << robot_path.back().y << ", " << robot_path.back().theta << std::endl;
 	}
 	std::cout << "Found with map_accessibility: " << found_with_map_acc << ",   with shift: " << found_with_shift
-			<< ",   with A*: " << found_with_astar << ",   not found: " << not_found << std::endl;
+			<< ",   with local search: " << found_with_local_search << ",   not found: " << not_found << std::endl;
 }
 
 
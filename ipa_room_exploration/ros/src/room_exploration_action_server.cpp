@@ -63,20 +63,28 @@
 // constructor
 RoomExplorationServer::RoomExplorationServer(ros::NodeHandle nh, std::string name_of_the_action) :
 	node_handle_(nh),
-	room_exploration_server_(node_handle_, name_of_the_action, boost::bind(&RoomExplorationServer::exploreRoom, this, _1), false)
+	room_exploration_server_(node_handle_, name_of_the_action, boost::bind(&RoomExplorationServer::exploreRoom, this, _1), false),
+	room_exploration_batch_server_(node_handle_, name_of_the_action+"_batch", boost::bind(&RoomExplorationServer::exploreRooms, this, _1), false)
 {
 	// dynamic reconfigure
 	room_exploration_dynamic_reconfigure_server_.setCallback(boost::bind(&RoomExplorationServer::dynamic_reconfigure_callback, this, _1, _2));
 
 	// Parameters
 	std::cout << "\n--------------------------\nRoom Exploration Parameters:\n--------------------------\n";
-	node_handle_.param("room_exploration_algorithm", room_exploration_algorithm_, 1);
-	std::cout << "room_exploration/room_exploration_algorithm = " << room_exploration_algorithm_ << std::endl;
+	node_handle_.param("room_exploration_algorithm", planner_parameters_.room_exploration_algorithm, 1);
+	std::cout << "room_exploration/room_exploration_algorithm = " << planner_parameters_.room_exploration_algorithm << std::endl;
 	node_handle_.param("display_trajectory", display_trajectory_, false);
 	std::cout << "room_exploration/display_trajectory = " << display_trajectory_ << std::endl;
 
-	node_handle_.param("map_correction_closing_neighborhood_size", map_correction_closing_neighborhood_size_, 2);
-	std::cout << "room_exploration/map_correction_closing_neighborhood_size = " << map_correction_closing_neighborhood_size_ << std::endl;
+	node_handle_.param("map_correction_closing_neighborhood_size", planner_parameters_.map_correction_closing_neighborhood_size, 2);
+	std::cout << "room_exploration/map_correction_closing_neighborhood_size = " << planner_parameters_.map_correction_closing_neighborhood_size << std::endl;
+
+	node_handle_.param("multi_resolution_factor", planner_parameters_.multi_resolution_factor, 1);
+	std::cout << "room_exploration/multi_resolution_factor = " << planner_parameters_.multi_resolution_factor << std::endl;
+	node_handle_.param("multi_resolution_max_uncovered_ratio", planner_parameters_.multi_resolution_max_uncovered_ratio, 0.05);
+	std::cout << "room_exploration/multi_resolution_max_uncovered_ratio = " << planner_parameters_.multi_resolution_max_uncovered_ratio << std::endl;
+	node_handle_.param("number_of_planning_threads", number_of_planning_threads_, 0);
+	std::cout << "room_exploration/number_of_planning_threads = " << number_of_planning_threads_ << std::endl;
 
 	node_handle_.param("return_path", return_path_, true);
 	std::cout << "room_exploration/return_path = " << return_path_ << std::endl;
@@ -92,6 +100,12 @@ RoomExplorationServer::RoomExplorationServer(ros::NodeHandle nh, std::string nam
 	std::cout << "room_exploration/revisit_areas = " << revisit_areas_ << std::endl;
 	node_handle_.param("left_sections_min_area", left_sections_min_area_, 0.01);
 	std::cout << "room_exploration/left_sections_min_area_ = " << left_sections_min_area_ << std::endl;
+	node_handle_.param("online_coverage_execution", online_coverage_execution_, false);
+	std::cout << "room_exploration/online_coverage_execution = " << online_coverage_execution_ << std::endl;
+	node_handle_.param("skip_covered_goals_ratio", skip_covered_goals_ratio_, 0.95);
+	std::cout << "room_exploration/skip_covered_goals_ratio = " << skip_covered_goals_ratio_ << std::endl;
+	node_handle_.param("reachability_batch_size", reachability_batch_size_, 20);
+	std::cout << "room_exploration/reachability_batch_size = " << reachability_batch_size_ << std::endl;
 	global_costmap_topic_ = "/move_base/global_costmap/costmap";
 	node_handle_.param<std::string>("global_costmap_topic", global_costmap_topic_);
 	std::cout << "room_exploration/global_costmap_topic = " << global_costmap_topic_ << std::endl;
@@ -105,85 +119,91 @@ RoomExplorationServer::RoomExplorationServer(ros::NodeHandle nh, std::string nam
 	std::cout << "room_exploration/camera_frame = " << camera_frame_ << std::endl;
 
 
-	if (room_exploration_algorithm_ == 1)
+	if (planner_parameters_.room_exploration_algorithm == 1)
 		ROS_INFO("You have chosen the grid exploration method.");
-	else if(room_exploration_algorithm_ == 2)
+	else if(planner_parameters_.room_exploration_algorithm == 2)
 		ROS_INFO("You have chosen the boustrophedon exploration method.");
-	else if(room_exploration_algorithm_ == 3)
+	else if(planner_parameters_.room_exploration_algorithm == 3)
 		ROS_INFO("You have chosen the neural network exploration method.");
-	else if(room_exploration_algorithm_ == 4)
+	else if(planner_parameters_.room_exploration_algorithm == 4)
 		ROS_INFO("You have chosen the convexSPP exploration method.");
-	else if(room_exploration_algorithm_ == 5)
+	else if(planner_parameters_.room_exploration_algorithm == 5)
 		ROS_INFO("You have chosen the flow network exploration method.");
-	else if(room_exploration_algorithm_ == 6)
+	else if(planner_parameters_.room_exploration_algorithm == 6)
 		ROS_INFO("You have chosen the energy functional exploration method.");
-	else if(room_exploration_algorithm_ == 7)
+	else if(planner_parameters_.room_exploration_algorithm == 7)
 		ROS_INFO("You have chosen the voronoi exploration method.");
-	else if(room_exploration_algorithm_ == 8)
+	else if(planner_parameters_.room_exploration_algorithm == 8)
 		ROS_INFO("You have chosen the boustrophedon variant exploration method.");
 
-	if (room_exploration_algorithm_ == 1) // get grid point exploration parameters
+	if (planner_parameters_.room_exploration_algorithm == 1) // get grid point exploration parameters
 	{
-		node_handle_.param("tsp_solver", tsp_solver_, (int)TSP_CONCORDE);
-		std::cout << "room_exploration/tsp_solver = " << tsp_solver_ << std::endl;
+		node_handle_.param("tsp_solver", planner_parameters_.tsp_solver, (int)TSP_CONCORDE);
+		std::cout << "room_exploration/tsp_solver = " << planner_parameters_.tsp_solver << std::endl;
 		int timeout=0;
 		node_handle_.param("tsp_solver_timeout", timeout, 600);
-		tsp_solver_timeout_ = timeout;
-		std::cout << "room_exploration/tsp_solver_timeout = " << tsp_solver_timeout_ << std::endl;
+		planner_parameters_.tsp_solver_timeout = timeout;
+		std::cout << "room_exploration/tsp_solver_timeout = " << planner_parameters_.tsp_solver_timeout << std::endl;
 
 	}
-	else if ((room_exploration_algorithm_ == 2) || (room_exploration_algorithm_ == 8)) // set boustrophedon (variant) exploration parameters
+	else if ((planner_parameters_.room_exploration_algorithm == 2) || (planner_parameters_.room_exploration_algorithm == 8)) // set boustrophedon (variant) exploration parameters
 	{
-		node_handle_.param("min_cell_area", min_cell_area_, 10.0);
-		std::cout << "room_exploration/min_cell_area_ = " << min_cell_area_ << std::endl;
-		node_handle_.param("path_eps", path_eps_, 2.0);
-		std::cout << "room_exploration/path_eps_ = " << path_eps_ << std::endl;
-		node_handle_.param("grid_obstacle_offset", grid_obstacle_offset_, 0.0);
-		std::cout << "room_exploration/grid_obstacle_offset_ = " << grid_obstacle_offset_ << std::endl;
-		node_handle_.param("max_deviation_from_track", max_deviation_from_track_, -1);
-		std::cout << "room_exploration/max_deviation_from_track_ = " << max_deviation_from_track_ << std::endl;
-		node_handle_.param("cell_visiting_order", cell_visiting_order_, 1);
-		std::cout << "room_exploration/cell_visiting_order = " << cell_visiting_order_ << std::endl;
+		node_handle_.param("min_cell_area", planner_parameters_.min_cell_area, 10.0);
+		std::cout << "room_exploration/min_cell_area_ = " << planner_parameters_.min_cell_area << std::endl;
+		node_handle_.param("path_eps", planner_parameters_.path_eps, 2.0);
+		std::cout << "room_exploration/path_eps_ = " << planner_parameters_.path_eps << std::endl;
+		node_handle_.param("grid_obstacle_offset", planner_parameters_.grid_obstacle_offset, 0.0);
+		std::cout << "room_exploration/grid_obstacle_offset_ = " << planner_parameters_.grid_obstacle_offset << std::endl;
+		node_handle_.param("max_deviation_from_track", planner_parameters_.max_deviation_from_track, -1);
+		std::cout << "room_exploration/max_deviation_from_track_ = " << planner_parameters_.max_deviation_from_track << std::endl;
+		node_handle_.param("cell_visiting_order", planner_parameters_.cell_visiting_order, 1);
+		std::cout << "room_exploration/cell_visiting_order = " << planner_parameters_.cell_visiting_order << std::endl;
 	}
-	else if (room_exploration_algorithm_ == 3) // set neural network explorator parameters
+	else if (planner_parameters_.room_exploration_algorithm == 3) // set neural network explorator parameters
 	{
-		node_handle_.param("step_size", step_size_, 0.008);
-		std::cout << "room_exploration/step_size_ = " << step_size_ << std::endl;
-		node_handle_.param("A", A_, 17);
-		std::cout << "room_exploration/A_ = " << A_ << std::endl;
-		node_handle_.param("B", B_, 5);
-		std::cout << "room_exploration/B_ = " << B_ << std::endl;
-		node_handle_.param("D", D_, 7);
-		std::cout << "room_exploration/D_ = " << D_ << std::endl;
-		node_handle_.param("E", E_, 80);
-		std::cout << "room_exploration/E_ = " << E_ << std::endl;
-		node_handle_.param("mu", mu_, 1.03);
-		std::cout << "room_exploration/mu_ = " << mu_ << std::endl;
-		node_handle_.param("delta_theta_weight", delta_theta_weight_, 0.15);
-		std::cout << "room_exploration/delta_theta_weight_ = " << delta_theta_weight_ << std::endl;
+		node_handle_.param("step_size", planner_parameters_.step_size, 0.008);
+		std::cout << "room_exploration/step_size_ = " << planner_parameters_.step_size << std::endl;
+		node_handle_.param("A", planner_parameters_.A, 17);
+		std::cout << "room_exploration/A_ = " << planner_parameters_.A << std::endl;
+		node_handle_.param("B", planner_parameters_.B, 5);
+		std::cout << "room_exploration/B_ = " << planner_parameters_.B << std::endl;
+		node_handle_.param("D", planner_parameters_.D, 7);
+		std::cout << "room_exploration/D_ = " << planner_parameters_.D << std::endl;
+		node_handle_.param("E", planner_parameters_.E, 80);
+		std::cout << "room_exploration/E_ = " << planner_parameters_.E << std::endl;
+		node_handle_.param("mu", planner_parameters_.mu, 1.03);
+		std::cout << "room_exploration/mu_ = " << planner_parameters_.mu << std::endl;
+		node_handle_.param("delta_theta_weight", planner_parameters_.delta_theta_weight, 0.15);
+		std::cout << "room_exploration/delta_theta_weight_ = " << planner_parameters_.delta_theta_weight << std::endl;
+		node_handle_.param("number_of_threads", planner_parameters_.number_of_threads, 1);
+		std::cout << "room_exploration/number_of_threads_ = " << planner_parameters_.number_of_threads << std::endl;
+		node_handle_.param("neural_network_update_threshold", planner_parameters_.neural_network_update_threshold, 0.0);
+		std::cout << "room_exploration/neural_network_update_threshold_ = " << planner_parameters_.neural_network_update_threshold << std::endl;
 	}
-	else if (room_exploration_algorithm_ == 4) // set convexSPP explorator parameters
+	else if (planner_parameters_.room_exploration_algorithm == 4) // set convexSPP explorator parameters
 	{
-		node_handle_.param("cell_size", cell_size_, 0);
-		std::cout << "room_exploration/cell_size_ = " << cell_size_ << std::endl;
-		node_handle_.param("delta_theta", delta_theta_, 1.570796);
-		std::cout << "room_exploration/delta_theta = " << delta_theta_ << std::endl;
+		node_handle_.param("cell_size", planner_parameters_.cell_size, 0);
+		std::cout << "room_exploration/cell_size_ = " << planner_parameters_.cell_size << std::endl;
+		node_handle_.param("delta_theta", planner_parameters_.delta_theta, 1.570796);
+		std::cout << "room_exploration/delta_theta = " << planner_parameters_.delta_theta << std::endl;
 	}
-	else if (room_exploration_algorithm_ == 5) // set flowNetwork explorator parameters
+	else if (planner_parameters_.room_exploration_algorithm == 5) // set flowNetwork explorator parameters
 	{
-		node_handle_.param("curvature_factor", curvature_factor_, 1.1);
-		std::cout << "room_exploration/curvature_factor = " << curvature_factor_ << std::endl;
-		node_handle_.param("max_distance_factor", max_distance_factor_, 1.0);
-		std::cout << "room_exploration/max_distance_factor_ = " << max_distance_factor_ << std::endl;
-		node_handle_.param("cell_size", cell_size_, 0);
-		std::cout << "room_exploration/cell_size_ = " << cell_size_ << std::endl;
-		node_handle_.param("path_eps", path_eps_, 3.0);
-		std::cout << "room_exploration/path_eps_ = " << path_eps_ << std::endl;
+		node_handle_.param("curvature_factor", planner_parameters_.curvature_factor, 1.1);
+		std::cout << "room_exploration/curvature_factor = " << planner_parameters_.curvature_factor << std::endl;
+		node_handle_.param("max_distance_factor", planner_parameters_.max_distance_factor, 1.0);
+		std::cout << "room_exploration/max_distance_factor_ = " << planner_parameters_.max_distance_factor << std::endl;
+		node_handle_.param("use_cut_generator", planner_parameters_.use_cut_generator, true);
+		std::cout << "room_exploration/use_cut_generator = " << planner_parameters_.use_cut_generator << std::endl;
+		node_handle_.param("cell_size", planner_parameters_.cell_size, 0);
+		std::cout << "room_exploration/cell_size_ = " << planner_parameters_.cell_size << std::endl;
+		node_handle_.param("path_eps", planner_parameters_.path_eps, 3.0);
+		std::cout << "room_exploration/path_eps_ = " << planner_parameters_.path_eps << std::endl;
 	}
-	else if (room_exploration_algorithm_ == 6) // set energyfunctional explorator parameters
+	else if (planner_parameters_.room_exploration_algorithm == 6) // set energyfunctional explorator parameters
 	{
 	}
-	else if (room_exploration_algorithm_ == 7) // set voronoi explorator parameters
+	else if (planner_parameters_.room_exploration_algorithm == 7) // set voronoi explorator parameters
 	{
 	}
 
@@ -197,8 +217,9 @@ RoomExplorationServer::RoomExplorationServer(ros::NodeHandle nh, std::string nam
 
 	path_pub_ = node_handle_.advertise<nav_msgs::Path>("coverage_path", 2);
 
-	//Start action server
+	//Start action servers
 	room_exploration_server_.start();
+	room_exploration_batch_server_.start();
 
 	ROS_INFO("Action server for room exploration has been initialized......");
 }
@@ -207,15 +228,25 @@ RoomExplorationServer::RoomExplorationServer(ros::NodeHandle nh, std::string nam
 // Callback function for dynamic reconfigure.
 void RoomExplorationServer::dynamic_reconfigure_callback(ipa_room_exploration::RoomExplorationConfig &config, uint32_t level)
 {
+	// the planning of a running action works on its own copy of the planner parameters
+	boost::mutex::scoped_lock lock(planner_parameters_mutex_);
+
 	// set segmentation algorithm
 	std::cout << "######################################################################################" << std::endl;
 	std::cout << "Dynamic reconfigure request:" << std::endl;
 
-	room_exploration_algorithm_ = config.room_exploration_algorithm;
-	std::cout << "room_exploration/path_planning_algorithm_ = " << room_exploration_algorithm_ << std::endl;
+	planner_parameters_.room_exploration_algorithm = config.room_exploration_algorithm;
+	std::cout << "room_exploration/path_planning_algorithm_ = " << planner_parameters_.room_exploration_algorithm << std::endl;
 
-	map_correction_closing_neighborhood_size_ = config.map_correction_closing_neighborhood_size;
-	std::cout << "room_exploration/map_correction_closing_neighborhood_size_ = " << map_correction_closing_neighborhood_size_ << std::endl;
+	planner_parameters_.map_correction_closing_neighborhood_size = config.map_correction_closing_neighborhood_size;
+	std::cout << "room_exploration/map_correction_closing_neighborhood_size_ = " << planner_parameters_.map_correction_closing_neighborhood_size << std::endl;
+
+	planner_parameters_.multi_resolution_factor = config.multi_resolution_factor;
+	std::cout << "room_exploration/multi_resolution_factor_ = " << planner_parameters_.multi_resolution_factor << std::endl;
+	planner_parameters_.multi_resolution_max_uncovered_ratio = config.multi_resolution_max_uncovered_ratio;
+	std::cout << "room_exploration/multi_resolution_max_uncovered_ratio_ = " << planner_parameters_.multi_resolution_max_uncovered_ratio << std::endl;
+	number_of_planning_threads_ = config.number_of_planning_threads;
+	std::cout << "room_exploration/number_of_planning_threads_ = " << number_of_planning_threads_ << std::endl;
 
 	return_path_ = config.return_path;
 	std::cout << "room_exploration/return_path_ = " << return_path_ << std::endl;
@@ -231,6 +262,12 @@ void RoomExplorationServer::dynamic_reconfigure_callback(ipa_room_exploration::R
 	std::cout << "room_exploration/revisit_areas_ = " << revisit_areas_ << std::endl;
 	left_sections_min_area_ = config.left_sections_min_area;
 	std::cout << "room_exploration/left_sections_min_area = " << left_sections_min_area_ << std::endl;
+	online_coverage_execution_ = config.online_coverage_execution;
+	std::cout << "room_exploration/online_coverage_execution_ = " << online_coverage_execution_ << std::endl;
+	skip_covered_goals_ratio_ = config.skip_covered_goals_ratio;
+	std::cout << "room_exploration/skip_covered_goals_ratio_ = " << skip_covered_goals_ratio_ << std::endl;
+	reachability_batch_size_ = config.reachability_batch_size;
+	std::cout << "room_exploration/reachability_batch_size_ = " << reachability_batch_size_ << std::endl;
 	global_costmap_topic_ = config.global_costmap_topic;
 	std::cout << "room_exploration/global_costmap_topic_ = " << global_costmap_topic_ << std::endl;
 	coverage_check_service_name_ = config.coverage_check_service_name;
@@ -241,65 +278,71 @@ void RoomExplorationServer::dynamic_reconfigure_callback(ipa_room_exploration::R
 	std::cout << "room_exploration/camera_frame_ = " << camera_frame_ << std::endl;
 
 	// set parameters regarding the chosen algorithm
-	if (room_exploration_algorithm_ == 1) // set grid point exploration parameters
+	if (planner_parameters_.room_exploration_algorithm == 1) // set grid point exploration parameters
 	{
-		tsp_solver_ = config.tsp_solver;
-		std::cout << "room_exploration/tsp_solver_ = " << tsp_solver_ << std::endl;
-		tsp_solver_timeout_ = config.tsp_solver_timeout;
-		std::cout << "room_exploration/tsp_solver_timeout_ = " << tsp_solver_timeout_ << std::endl;
+		planner_parameters_.tsp_solver = config.tsp_solver;
+		std::cout << "room_exploration/tsp_solver_ = " << planner_parameters_.tsp_solver << std::endl;
+		planner_parameters_.tsp_solver_timeout = config.tsp_solver_timeout;
+		std::cout << "room_exploration/tsp_solver_timeout_ = " << planner_parameters_.tsp_solver_timeout << std::endl;
 	}
-	else if ((room_exploration_algorithm_ == 2) || (room_exploration_algorithm_ == 8)) // set boustrophedon (variant) exploration parameters
+	else if ((planner_parameters_.room_exploration_algorithm == 2) || (planner_parameters_.room_exploration_algorithm == 8)) // set boustrophedon (variant) exploration parameters
 	{
-		min_cell_area_ = config.min_cell_area;
-		std::cout << "room_exploration/min_cell_area_ = " << min_cell_area_ << std::endl;
-		path_eps_ = config.path_eps;
-		std::cout << "room_exploration/path_eps_ = " << path_eps_ << std::endl;
-		grid_obstacle_offset_ = config.grid_obstacle_offset;
-		std::cout << "room_exploration/grid_obstacle_offset_ = " << grid_obstacle_offset_ << std::endl;
-		max_deviation_from_track_ = config.max_deviation_from_track;
-		std::cout << "room_exploration/max_deviation_from_track_ = " << max_deviation_from_track_ << std::endl;
-		cell_visiting_order_ = config.cell_visiting_order;
-		std::cout << "room_exploration/cell_visiting_order = " << cell_visiting_order_ << std::endl;
+		planner_parameters_.min_cell_area = config.min_cell_area;
+		std::cout << "room_exploration/min_cell_area_ = " << planner_parameters_.min_cell_area << std::endl;
+		planner_parameters_.path_eps = config.path_eps;
+		std::cout << "room_exploration/path_eps_ = " << planner_parameters_.path_eps << std::endl;
+		planner_parameters_.grid_obstacle_offset = config.grid_obstacle_offset;
+		std::cout << "room_exploration/grid_obstacle_offset_ = " << planner_parameters_.grid_obstacle_offset << std::endl;
+		planner_parameters_.max_deviation_from_track = config.max_deviation_from_track;
+		std::cout << "room_exploration/max_deviation_from_track_ = " << planner_parameters_.max_deviation_from_track << std::endl;
+		planner_parameters_.cell_visiting_order = config.cell_visiting_order;
+		std::cout << "room_exploration/cell_visiting_order = " << planner_parameters_.cell_visiting_order << std::endl;
 	}
-	else if (room_exploration_algorithm_ == 3) // set neural network explorator parameters
+	else if (planner_parameters_.room_exploration_algorithm == 3) // set neural network explorator parameters
 	{
-		step_size_ = config.step_size;
-		std::cout << "room_exploration/step_size_ = " << step_size_ << std::endl;
-		A_ = config.A;
-		std::cout << "room_exploration/A_ = " << A_ << std::endl;
-		B_ = config.B;
-		std::cout << "room_exploration/B_ = " << B_ << std::endl;
-		D_ = config.D;
-		std::cout << "room_exploration/D_ = " << D_ << std::endl;
-		E_ = config.E;
-		std::cout << "room_exploration/E_ = " << E_ << std::endl;
-		mu_ = config.mu;
-		std::cout << "room_exploration/mu_ = " << mu_ << std::endl;
-		delta_theta_weight_ = config.delta_theta_weight;
-		std::cout << "room_exploration/delta_theta_weight_ = " << delta_theta_weight_ << std::endl;
+		planner_parameters_.step_size = config.step_size;
+		std::cout << "room_exploration/step_size_ = " << planner_parameters_.step_size << std::endl;
+		planner_parameters_.A = config.A;
+		std::cout << "room_exploration/A_ = " << planner_parameters_.A << std::endl;
+		planner_parameters_.B = config.B;
+		std::cout << "room_exploration/B_ = " << planner_parameters_.B << std::endl;
+		planner_parameters_.D = config.D;
+		std::cout << "room_exploration/D_ = " << planner_parameters_.D << std::endl;
+		planner_parameters_.E = config.E;
+		std::cout << "room_exploration/E_ = " << planner_parameters_.E << std::endl;
+		planner_parameters_.mu = config.mu;
+		std::cout << "room_exploration/mu_ = " << planner_parameters_.mu << std::endl;
+		planner_parameters_.delta_theta_weight = config.delta_theta_weight;
+		std::cout << "room_exploration/delta_theta_weight_ = " << planner_parameters_.delta_theta_weight << std::endl;
+		planner_parameters_.number_of_threads = config.number_of_threads;
+		std::cout << "room_exploration/number_of_threads_ = " << planner_parameters_.number_of_threads << std::endl;
+		planner_parameters_.neural_network_update_threshold = config.neural_network_update_threshold;
+		std::cout << "room_exploration/neural_network_update_threshold_ = " << planner_parameters_.neural_network_update_threshold << std::endl;
 	}
-	else if (room_exploration_algorithm_ == 4) // set convexSPP explorator parameters
+	else if (planner_parameters_.room_exploration_algorithm == 4) // set convexSPP explorator parameters
 	{
-		cell_size_ = config.cell_size;
-		std::cout << "room_exploration/cell_size_ = " << cell_size_ << std::endl;
-		delta_theta_ = config.delta_theta;
-		std::cout << "room_exploration/delta_theta_ = " << delta_theta_ << std::endl;
+		planner_parameters_.cell_size = config.cell_size;
+		std::cout << "room_exploration/cell_size_ = " << planner_parameters_.cell_size << std::endl;
+		planner_parameters_.delta_theta = config.delta_theta;
+		std::cout << "room_exploration/delta_theta_ = " << planner_parameters_.delta_theta << std::endl;
 	}
-	else if (room_exploration_algorithm_ == 5) // set flowNetwork explorator parameters
+	else if (planner_parameters_.room_exploration_algorithm == 5) // set flowNetwork explorator parameters
 	{
-		curvature_factor_ = config.curvature_factor;
-		std::cout << "room_exploration/delta_theta_ = " << delta_theta_ << std::endl;
-		max_distance_factor_ = config.max_distance_factor;
-		std::cout << "room_exploration/max_distance_factor_ = " << max_distance_factor_ << std::endl;
-		cell_size_ = config.cell_size;
-		std::cout << "room_exploration/cell_size_ = " << cell_size_ << std::endl;
-		path_eps_ = config.path_eps;
-		std::cout << "room_exploration/path_eps_ = " << path_eps_ << std::endl;
+		planner_parameters_.curvature_factor = config.curvature_factor;
+		std::cout << "room_exploration/delta_theta_ = " << planner_parameters_.delta_theta << std::endl;
+		planner_parameters_.max_distance_factor = config.max_distance_factor;
+		std::cout << "room_exploration/max_distance_factor_ = " << planner_parameters_.max_distance_factor << std::endl;
+		planner_parameters_.use_cut_generator = config.use_cut_generator;
+		std::cout << "room_exploration/use_cut_generator_ = " << planner_parameters_.use_cut_generator << std::endl;
+		planner_parameters_.cell_size = config.cell_size;
+		std::cout << "room_exploration/cell_size_ = " << planner_parameters_.cell_size << std::endl;
+		planner_parameters_.path_eps = config.path_eps;
+		std::cout << "room_exploration/path_eps_ = " << planner_parameters_.path_eps << std::endl;
 	}
-	else if (room_exploration_algorithm_ == 6) // set energyFunctional explorator parameters
+	else if (planner_parameters_.room_exploration_algorithm == 6) // set energyFunctional explorator parameters
 	{
 	}
-	else if (room_exploration_algorithm_ == 7) // set voronoi explorator parameters
+	else if (planner_parameters_.room_exploration_algorithm == 7) // set voronoi explorator parameters
 	{
 	}
 
@@ -318,6 +361,13 @@ void RoomExplorationServer::exploreRoom(const ipa_building_msgs::RoomExploration
 {
 	ROS_INFO("*****Room Exploration action server*****");
 
+	// the planner parameters are copied once, so that a dynamic reconfigure request does not change them during the planning
+	RoomExplorationPlannerParameters planner_parameters;
+	{
+		boost::mutex::scoped_lock lock(planner_parameters_mutex_);
+		planner_parameters = planner_parameters_;
+	}
+
 	// ***************** I. read the given parameters out of the goal *****************
 	// todo: this is only correct if the map is not rotated
 	const cv::Point2d map_origin(goal->map_origin.position.x, goal->map_origin.position.y);
@@ -352,13 +402,8 @@ void RoomExplorationServer::exploreRoom(const ipa_building_msgs::RoomExploration
 				area_px++;
 	std::cout << "### room area = " << area_px*map_resolution*map_resolution << " m^2" << std::endl;
 
-	// closing operation to neglect inaccessible areas and map errors/artifacts
-	cv::Mat temp;
-	cv::erode(room_map, temp, cv::Mat(), cv::Point(-1, -1), map_correction_closing_neighborhood_size_);
-	cv::dilate(temp, room_map, cv::Mat(), cv::Point(-1, -1), map_correction_closing_neighborhood_size_);
-
-	// remove unconnected, i.e. inaccessible, parts of the room (i.e. obstructed by furniture), only keep the room with the largest area
-	const bool room_not_empty = removeUnconnectedRoomParts(room_map);
+	// closing operation to neglect inaccessible areas and map errors/artifacts, and removal of unconnected, i.e. inaccessible, parts of the room
+	const bool room_not_empty = RoomExplorationPlanner::preprocessRoomMap(room_map, planner_parameters.map_correction_closing_neighborhood_size);
 	if (room_not_empty == false)
 	{
 		std::cout << "RoomExplorationServer::exploreRoom: Warning: the requested room is too small for generating exploration trajectories." << std::endl;
@@ -368,180 +413,21 @@ void RoomExplorationServer::exploreRoom(const ipa_building_msgs::RoomExploration
 	}
 
 	// get the grid size, to check the areas that should be revisited later
-	double grid_spacing_in_meter = 0.0;		// is the square grid cell side length that fits into the circle with the robot's coverage radius or fov coverage radius
-	float fitting_circle_radius_in_meter = 0;
+	double grid_spacing_in_pixel = 0.;		// is the square grid cell side length that fits into the circle with the robot's coverage radius or fov coverage radius
 	Eigen::Matrix<float, 2, 1> fitting_circle_center_point_in_meter;	// this is also considered the center of the field of view, because around this point the maximum radius incircle can be found that is still inside the fov
 	std::vector<Eigen::Matrix<float, 2, 1> > fov_corners_meter(4);
-	const double fov_resolution = 1000;		// in [cell/meter]
-	if(planning_mode_ == PLAN_FOR_FOV) // read out the given fov-vectors, if needed
-	{
-		// Get the size of one grid cell s.t. the grid can be completely covered by the field of view (fov) from all rotations around it.
-		for(int i = 0; i < 4; ++i)
-			fov_corners_meter[i] << goal->field_of_view[i].x, goal->field_of_view[i].y;
-		computeFOVCenterAndRadius(fov_corners_meter, fitting_circle_radius_in_meter, fitting_circle_center_point_in_meter, fov_resolution);
-		// get the edge length of the grid square that fits into the fitting_circle_radius
-		grid_spacing_in_meter = fitting_circle_radius_in_meter*std::sqrt(2);
-	}
-	else // if planning should be done for the footprint, read out the given coverage radius
-	{
-		grid_spacing_in_meter = goal->coverage_radius*std::sqrt(2);
-	}
-	// map the grid size to an int in pixel coordinates, using floor method
-	const double grid_spacing_in_pixel = grid_spacing_in_meter/map_resolution;		// is the square grid cell side length that fits into the circle with the robot's coverage radius or fov coverage radius, multiply with sqrt(2) to receive the whole working width
-	std::cout << "grid size: " << grid_spacing_in_meter << " m   (" << grid_spacing_in_pixel << " px)" << std::endl;
-	// set the cell_size_ for #4 convexSPP explorator or #5 flowNetwork explorator if it is not provided
-	if (cell_size_ <= 0)
-		cell_size_ = std::floor(grid_spacing_in_pixel);
+	RoomExplorationPlanner::computeGridSpacing(planning_mode_, goal->field_of_view, goal->coverage_radius, map_resolution, grid_spacing_in_pixel, fitting_circle_center_point_in_meter, fov_corners_meter);
+	Eigen::Matrix<float, 2, 1> fov_origin;		// mounting position of the sensor spanning the field of view
+	fov_origin << goal->field_of_view_origin.x, goal->field_of_view_origin.y;
+	// set the cell_size for #4 convexSPP explorator or #5 flowNetwork explorator if it is not provided
+	const int cell_size = (planner_parameters.cell_size > 0 ? planner_parameters.cell_size : std::floor(grid_spacing_in_pixel));
 
 
 	// ***************** II. plan the path using the wanted planner *****************
-	// todo: consider option to provide the inflated map or the robot radius to the functions instead of inflating with half cell size there
-	Eigen::Matrix<float, 2, 1> zero_vector;
-	zero_vector << 0, 0;
 	std::vector<geometry_msgs::Pose2D> exploration_path;
-	if (room_exploration_algorithm_ == 1) // use grid point explorator
-	{
-		// plan path
-		if(planning_mode_ == PLAN_FOR_FOV)
-			grid_point_planner.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, std::floor(grid_spacing_in_pixel), false, fitting_circle_center_point_in_meter, tsp_solver_, tsp_solver_timeout_);
-		else
-			grid_point_planner.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, std::floor(grid_spacing_in_pixel), true, zero_vector, tsp_solver_, tsp_solver_timeout_);
-	}
-	else if (room_exploration_algorithm_ == 2) // use boustrophedon explorator
-	{
-		// plan path
-		if(planning_mode_ == PLAN_FOR_FOV)
-			boustrophedon_explorer_.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, grid_spacing_in_pixel, grid_obstacle_offset_, path_eps_, cell_visiting_order_, false, fitting_circle_center_point_in_meter, min_cell_area_, max_deviation_from_track_);
-		else
-			boustrophedon_explorer_.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, grid_spacing_in_pixel, grid_obstacle_offset_, path_eps_, cell_visiting_order_, true, zero_vector, min_cell_area_, max_deviation_from_track_);
-	}
-	else if (room_exploration_algorithm_ == 3) // use neural network explorator
-	{
-		neural_network_explorator_.setParameters(A_, B_, D_, E_, mu_, step_size_, delta_theta_weight_);
-		// plan path
-		if(planning_mode_ == PLAN_FOR_FOV)
-			neural_network_explorator_.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, grid_spacing_in_pixel, false, fitting_circle_center_point_in_meter, false);
-		else
-			neural_network_explorator_.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, grid_spacing_in_pixel, true, zero_vector, false);
-	}
-	else if (room_exploration_algorithm_ == 4) // use convexSPP explorator
-	{
-		// plan coverage path
-		if(planning_mode_ == PLAN_FOR_FOV)
-			convex_SPP_explorator_.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, cell_size_, delta_theta_, fov_corners_meter, fitting_circle_center_point_in_meter, 0., 7, false);
-		else
-			convex_SPP_explorator_.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, cell_size_, delta_theta_, fov_corners_meter, zero_vector, goal->coverage_radius, 7, true);
-	}
-	else if (room_exploration_algorithm_ == 5) // use flow network explorator
-	{
-		if(planning_mode_ == PLAN_FOR_FOV)
-			flow_network_explorator_.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, cell_size_, fitting_circle_center_point_in_meter, grid_spacing_in_pixel, false, path_eps_, curvature_factor_, max_distance_factor_);
-		else
-			flow_network_explorator_.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, cell_size_, zero_vector, grid_spacing_in_pixel, true, path_eps_, curvature_factor_, max_distance_factor_);
-	}
-	else if (room_exploration_algorithm_ == 6) // use energy functional explorator
-	{
-		if(planning_mode_ == PLAN_FOR_FOV)
-			energy_functional_explorator_.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, grid_spacing_in_pixel, false, fitting_circle_center_point_in_meter);
-		else
-			energy_functional_explorator_.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, grid_spacing_in_pixel, true, zero_vector);
-	}
-	else if (room_exploration_algorithm_ == 7) // use voronoi explorator
-	{
-		// create a usable occupancyGrid map out of the given room map
-		nav_msgs::OccupancyGrid room_gridmap;
-		matToMap(room_gridmap, room_map);
-
-		// do not find nearest pose to starting-position and start there because of issue in planner when starting position is provided
-		if(planning_mode_==PLAN_FOR_FOV)
-		{
-//			cv::Mat distance_transform;
-//			cv::distanceTransform(room_map, distance_transform, CV_DIST_L2, CV_DIST_MASK_PRECISE);
-//			cv::Mat display = room_map.clone();
-//			// todoo: get max dist from map and parametrize loop
-//			for (int s=5; s<100; s+=10)
-//			{
-//				for (int v=0; v<distance_transform.rows; ++v)
-//				{
-//					for (int u=0; u<distance_transform.cols; ++u)
-//					{
-//						if (int(distance_transform.at<float>(v,u)) == s)
-//						{
-//							display.at<uchar>(v,u) = 0;
-//						}
-//					}
-//				}
-//			}
-//			cv::imshow("distance_transform", distance_transform);
-//			cv::imshow("trajectories", display);
-//			cv::waitKey();
-
-			// convert fov-radius to pixel integer
-			const int grid_spacing_as_int = (int)std::floor(grid_spacing_in_pixel);
-			std::cout << "grid spacing in pixel: " << grid_spacing_as_int << std::endl;
-
-			// create the object that plans the path, based on the room-map
-			VoronoiMap vm(room_gridmap.data.data(), room_gridmap.info.width, room_gridmap.info.height, grid_spacing_as_int, 2, true); // a perfect alignment of the paths cannot be assumed here (in contrast to footprint planning) because the well-aligned fov trajectory is mapped to robot locations that may not be on parallel tracks
-			// get the exploration path
-			std::vector<geometry_msgs::Pose2D> fov_path_uncleaned;
-			vm.setSingleRoom(true); //to force to consider all rooms
-			vm.generatePath(fov_path_uncleaned, cv::Mat(), starting_position.x, starting_position.y);	// start position in room center
-
-			// clean path from subsequent double occurrences of the same pose
-			std::vector<geometry_msgs::Pose2D> fov_path;
-			downsampleTrajectory(fov_path_uncleaned, fov_path, 2.*2.); //5*5);
-
-			// convert to poses with angles
-			RoomRotator room_rotation;
-			room_rotation.transformPointPathToPosePath(fov_path);
-
-			// map fov-path to robot-path
-			//cv::Point start_pos(fov_path.begin()->x, fov_path.begin()->y);
-			//mapPath(room_map, exploration_path, fov_path, fitting_circle_center_point_in_meter, map_resolution, map_origin, start_pos);
-			ROS_INFO("Starting to map from field of view pose to robot pose");
-			cv::Point robot_starting_position = (fov_path.size()>0 ? cv::Point(fov_path[0].x, fov_path[0].y) : starting_position);
-			cv::Mat inflated_room_map;
-			cv::erode(room_map, inflated_room_map, cv::Mat(), cv::Point(-1, -1), (int)std::floor(goal->robot_radius/map_resolution));
-			mapPath(inflated_room_map, exploration_path, fov_path, fitting_circle_center_point_in_meter, map_resolution, map_origin, robot_starting_position);
-		}
-		else
-		{
-			// convert coverage-radius to pixel integer
-			//int coverage_diameter = (int)std::floor(2.*goal->coverage_radius/map_resolution);
-			//std::cout << "coverage radius in pixel: " << coverage_diameter << std::endl;
-			const int grid_spacing_as_int = (int)std::floor(grid_spacing_in_pixel);
-			std::cout << "grid spacing in pixel: " << grid_spacing_as_int << std::endl;
-
-			// create the object that plans the path, based on the room-map
-			VoronoiMap vm(room_gridmap.data.data(), room_gridmap.info.width, room_gridmap.info.height, grid_spacing_as_int, 2, true);	//coverage_diameter-1); // diameter in pixel (full working width can be used here because tracks are planned in parallel motion)
-			// get the exploration path
-			std::vector<geometry_msgs::Pose2D> exploration_path_uncleaned;
-			vm.setSingleRoom(true); //to force to consider all rooms
-			vm.generatePath(exploration_path_uncleaned, cv::Mat(), starting_position.x, starting_position.y);	// start position in room center
-
-			// clean path from subsequent double occurrences of the same pose
-			downsampleTrajectory(exploration_path_uncleaned, exploration_path, 3.5*3.5); //3.5*3.5);
-
-			// convert to poses with angles
-			RoomRotator room_rotation;
-			room_rotation.transformPointPathToPosePath(exploration_path);
-
-			// transform to global coordinates
-			for(size_t pos=0; pos<exploration_path.size(); ++pos)
-			{
-				exploration_path[pos].x = (exploration_path[pos].x * map_resolution) + map_origin.x;
-				exploration_path[pos].y = (exploration_path[pos].y * map_resolution) + map_origin.y;
-			}
-		}
-	}
-	else if (room_exploration_algorithm_ == 8) // use boustrophedon variant explorator
-	{
-		// plan path
-		if(planning_mode_ == PLAN_FOR_FOV)
-			boustrophedon_variant_explorer_.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, grid_spacing_in_pixel, grid_obstacle_offset_, path_eps_, cell_visiting_order_, false, fitting_circle_center_point_in_meter, min_cell_area_, max_deviation_from_track_);
-		else
-			boustrophedon_variant_explorer_.getExplorationPath(room_map, exploration_path, map_resolution, starting_position, map_origin, grid_spacing_in_pixel, grid_obstacle_offset_, path_eps_, cell_visiting_order_, true, zero_vector, min_cell_area_, max_deviation_from_track_);
-	}
+	room_exploration_planner_.planCoveragePathMultiResolution(room_map, exploration_path, map_resolution, starting_position, map_origin, planning_mode_,
+			grid_spacing_in_pixel, fitting_circle_center_point_in_meter, fov_corners_meter, fov_origin, goal->coverage_radius, goal->robot_radius, cell_size,
+			planner_parameters, planners_);
 
 	// display finally planned path
 	if (display_trajectory_ == true)
@@ -618,7 +504,7 @@ void RoomExplorationServer::exploreRoom(const ipa_building_msgs::RoomExploration
 	// [optionally] execute the path
 	if(execute_path_ == true)
 	{
-		navigateExplorationPath(exploration_path, goal->field_of_view, goal->field_of_view_origin, goal->coverage_radius, fitting_circle_center_point_in_meter.norm(),
+		navigateExplorationPath(exploration_path, room_map, goal->field_of_view, goal->field_of_view_origin, goal->coverage_radius, fitting_circle_center_point_in_meter.norm(),
 					map_resolution, goal->map_origin, grid_spacing_in_pixel, room_map.rows * map_resolution);
 		ROS_INFO("Explored room.");
 	}
@@ -628,80 +514,163 @@ void RoomExplorationServer::exploreRoom(const ipa_building_msgs::RoomExploration
 	return;
 }
 
-	// remove unconnected, i.e. inaccessible, parts of the room (i.e. obstructed by furniture), only keep the room with the largest area
-bool RoomExplorationServer::removeUnconnectedRoomParts(cv::Mat& room_map)
+// Function executed by Call of the batch action.
+void RoomExplorationServer::exploreRooms(const ipa_building_msgs::RoomExplorationBatchGoalConstPtr &goal)
 {
-	// create new map with segments labeled by increasing labels from 1,2,3,...
-	cv::Mat room_map_int(room_map.rows, room_map.cols, CV_32SC1);
-	for (int v=0; v<room_map.rows; ++v)
+	ROS_INFO("*****Room Exploration batch action server*****");
+
+	// the planner parameters are copied once, so that all rooms of the batch are planned with the same algorithm and parameters
+	RoomExplorationPlannerParameters planner_parameters;
+	int number_of_planning_threads = 0;
 	{
-		for (int u=0; u<room_map.cols; ++u)
-		{
-			if (room_map.at<uchar>(v,u) == 255)
-				room_map_int.at<int32_t>(v,u) = -100;
-			else
-				room_map_int.at<int32_t>(v,u) = 0;
-		}
+		boost::mutex::scoped_lock lock(planner_parameters_mutex_);
+		planner_parameters = planner_parameters_;
+		number_of_planning_threads = number_of_planning_threads_;
 	}
 
-	std::map<int, int> area_to_label_map;	// maps area=number of segment pixels (keys) to the respective label (value)
-	int label = 1;
-	for (int v=0; v<room_map_int.rows; ++v)
+	// ***************** I. read the given parameters out of the goal *****************
+	const cv::Point2d map_origin(goal->map_origin.position.x, goal->map_origin.position.y);
+	const float map_resolution = goal->map_resolution;	// in [m/cell]
+	const std::vector<int> room_ids(goal->room_ids.begin(), goal->room_ids.end());
+	std::cout << "map origin: " << map_origin << " m       map resolution: " << map_resolution << " m/cell" << std::endl;
+	std::cout << "number of requested rooms: " << room_ids.size() << std::endl;
+
+	cv_bridge::CvImagePtr cv_ptr_obj;
+	cv_ptr_obj = cv_bridge::toCvCopy(goal->segmented_map, sensor_msgs::image_encodings::TYPE_32SC1);
+	const cv::Mat segmented_map = cv_ptr_obj->image;
+
+	std::vector<cv::Point2d> starting_positions(goal->starting_positions.size());
+	for (size_t i=0; i<goal->starting_positions.size(); ++i)
+		starting_positions[i] = cv::Point2d(goal->starting_positions[i].x, goal->starting_positions[i].y);
+	Eigen::Matrix<float, 2, 1> fov_origin;		// mounting position of the sensor spanning the field of view
+	fov_origin << goal->field_of_view_origin.x, goal->field_of_view_origin.y;
+
+	// ***************** II. plan the rooms in parallel *****************
+	std::vector<std::vector<geometry_msgs::Pose2D> > coverage_paths;
+	const int number_of_planned_rooms = room_exploration_planner_.planRooms(segmented_map, room_ids, starting_positions, map_resolution, map_origin,
+			goal->planning_mode, goal->field_of_view, fov_origin, goal->coverage_radius, goal->robot_radius, planner_parameters,
+			number_of_planning_threads, coverage_paths);
+
+	ROS_INFO("Room exploration batch planning finished.");
+
+	// return the paths in the order of the requested rooms
+	ipa_building_msgs::RoomExplorationBatchResult action_result;
+	action_result.room_coverage_paths.resize(room_ids.size());
+	for (size_t i=0; i<room_ids.size(); ++i)
 	{
-		for (int u=0; u<room_map_int.cols; ++u)
-		{
-			if (room_map_int.at<int32_t>(v,u) == -100)
-			{
-				const int area = cv::floodFill(room_map_int, cv::Point(u,v), cv::Scalar(label), 0, 0, 0, 8 | cv::FLOODFILL_FIXED_RANGE);
-				area_to_label_map[area] = label;
-				++label;
-			}
-		}
+		action_result.room_coverage_paths[i].room_id = room_ids[i];
+		action_result.room_coverage_paths[i].coverage_path = coverage_paths[i];
 	}
-	// abort if area_to_label_map.size() is empty
-	if (area_to_label_map.size() == 0)
-		return false;
+	std::cout << "planned " << number_of_planned_rooms << " of " << room_ids.size() << " rooms" << std::endl;
+	if (number_of_planned_rooms == 0)
+	{
+		room_exploration_batch_server_.setAborted(action_result);
+		return;
+	}
+	room_exploration_batch_server_.setSucceeded(action_result);
+}
 
-	// remove all room pixels from room_map which are not accessible
-	const int label_of_biggest_room = area_to_label_map.rbegin()->second;
-	std::cout << "label_of_biggest_room=" << label_of_biggest_room << std::endl;
-	for (int v=0; v<room_map.rows; ++v)
-		for (int u=0; u<room_map.cols; ++u)
-			if (room_map_int.at<int32_t>(v,u) != label_of_biggest_room)
-				room_map.at<uchar>(v,u) = 0;
 
-	return true;
+void RoomExplorationServer::globalCostmapCallback(const nav_msgs::OccupancyGrid::ConstPtr& global_costmap)
+{
+	boost::mutex::scoped_lock lock(global_costmap_mutex_);
+	latest_global_costmap_ = global_costmap;
 }
 
 
-void RoomExplorationServer::downsampleTrajectory(const std::vector<geometry_msgs::Pose2D>& path_uncleaned, std::vector<geometry_msgs::Pose2D>& path, const double min_dist_squared)
+void RoomExplorationServer::computeGoalReachability(const std::vector<geometry_msgs::Pose2D>& exploration_path, const size_t first_goal,
+		const size_t number_of_goals, const std::vector<geometry_msgs::Pose2D>& robot_poses, std::vector<bool>& goal_reachable)
 {
-	// clean path from subsequent double occurrences of the same pose
-	path.push_back(path_uncleaned[0]);
-	cv::Point last_added_point(path_uncleaned[0].x, path_uncleaned[0].y);
-	for (size_t i=1; i<path_uncleaned.size(); ++i)
+	goal_reachable.assign(number_of_goals, true);
+
+	// take a snapshot of the latest costmap, the message itself is never modified so keeping the pointer is sufficient
+	nav_msgs::OccupancyGrid::ConstPtr global_costmap;
+	{
+		boost::mutex::scoped_lock lock(global_costmap_mutex_);
+		global_costmap = latest_global_costmap_;
+	}
+	if (!global_costmap || robot_poses.size() == 0)
+		return;
+
+	// free space of the costmap, only lethal cells (100) are blocked, unknown cells (-1) are considered free
+	const int width = global_costmap->info.width;
+	const int height = global_costmap->info.height;
+	const double costmap_resolution = global_costmap->info.resolution;
+	const cv::Point2d costmap_origin(global_costmap->info.origin.position.x, global_costmap->info.origin.position.y);
+	if (width == 0 || height == 0 || costmap_resolution <= 0.)
+		return;
+	cv::Mat free_space(height, width, CV_8UC1);
+	for (int v=0; v<height; ++v)
+	{
+		uchar* free_space_row = free_space.ptr<uchar>(v);
+		const signed char* costmap_row = &global_costmap->data[v*width];
+		for (int u=0; u<width; ++u)
+			free_space_row[u] = (costmap_row[u] < 100 ? 255 : 0);
+	}
+
+	// one flood fill from the robot position marks all free cells that are connected to it
+	const cv::Rect costmap_rect(0, 0, width, height);
+	const cv::Point robot_cell((robot_poses.back().x-costmap_origin.x)/costmap_resolution, (robot_poses.back().y-costmap_origin.y)/costmap_resolution);
+	if (costmap_rect.contains(robot_cell) == false || free_space.at<uchar>(robot_cell) != 255)
+		return;
+	cv::floodFill(free_space, robot_cell, cv::Scalar(127));
+
+	// goals outside the costmap cannot be judged and stay reachable
+	int number_of_unreachable_goals = 0;
+	for (size_t i=0; i<number_of_goals; ++i)
 	{
-		const cv::Point current_point(path_uncleaned[i].x, path_uncleaned[i].y);
-		cv::Point vector = current_point - last_added_point;
-		if (vector.x*vector.x+vector.y*vector.y > min_dist_squared || i==path_uncleaned.size()-1)
+		const geometry_msgs::Pose2D& goal = exploration_path[first_goal+i];
+		const cv::Point goal_cell((goal.x-costmap_origin.x)/costmap_resolution, (goal.y-costmap_origin.y)/costmap_resolution);
+		if (costmap_rect.contains(goal_cell) == true && free_space.at<uchar>(goal_cell) != 127)
 		{
-			path.push_back(path_uncleaned[i]);
-			last_added_point = current_point;
+			goal_reachable[i] = false;
+			++number_of_unreachable_goals;
 		}
 	}
+	std::cout << "checked reachability of goals " << first_goal << " to " << first_goal+number_of_goals-1 << ": " << number_of_unreachable_goals << " unreachable" << std::endl;
 }
 
 
-void RoomExplorationServer::navigateExplorationPath(const std::vector<geometry_msgs::Pose2D>& exploration_path,
+void RoomExplorationServer::navigateExplorationPath(const std::vector<geometry_msgs::Pose2D>& exploration_path, const cv::Mat& room_map,
 		const std::vector<geometry_msgs::Point32>& field_of_view, const geometry_msgs::Point32& field_of_view_origin,
 		const double coverage_radius, const double distance_robot_fov_middlepoint, const float map_resolution,
 		const geometry_msgs::Pose& map_origin, const double grid_spacing_in_pixel, const double map_height)
 {
+	//   --> convert field of view to Eigen format
+	std::vector<Eigen::Matrix<float, 2, 1> > fov;
+	for(size_t i = 0; i < field_of_view.size(); ++i)
+	{
+		Eigen::Matrix<float, 2, 1> current_vector;
+		current_vector << field_of_view[i].x, field_of_view[i].y;
+		fov.push_back(current_vector);
+	}
+	//   --> convert field of view origin to Eigen format
+	Eigen::Matrix<float, 2, 1> fov_origin;
+	fov_origin <<field_of_view_origin.x, field_of_view_origin.y;
+
+	// rolling coverage map that is updated with the tracked robot poses, and the costmap subscription for the reachability checks
+	OnlineCoverageGrid coverage_grid(room_map, map_resolution, cv::Point2d(map_origin.position.x, map_origin.position.y), fov, fov_origin,
+			coverage_radius, (planning_mode_==PLAN_FOR_FOOTPRINT));
+	size_t number_of_tracked_robot_poses = 0;	// number of robot poses that have already been added to coverage_grid
+	ros::Subscriber global_costmap_sub;
+	if (online_coverage_execution_ == true)
+	{
+		{
+			boost::mutex::scoped_lock lock(global_costmap_mutex_);
+			latest_global_costmap_.reset();
+		}
+		global_costmap_sub = node_handle_.subscribe(global_costmap_topic_, 1, &RoomExplorationServer::globalCostmapCallback, this);
+	}
+	std::vector<bool> goal_reachable;		// reachability of the goals of the current batch
+	size_t reachability_batch_begin = 0;	// index of the first goal of the current batch
+	int number_of_skipped_covered_goals = 0, number_of_skipped_unreachable_goals = 0;
+
 	// ***************** III. Navigate trough all points and save the robot poses to check what regions have been seen *****************
 	// 1. publish navigation goals
 	std::vector<geometry_msgs::Pose2D> robot_poses;
 	geometry_msgs::Pose2D last_pose;
 	geometry_msgs::Pose2D pose;
+	bool published_goal = false;
 	for(size_t map_oriented_pose = 0; map_oriented_pose < exploration_path.size(); ++map_oriented_pose)
 	{
 		// check if the path should be continued or not
@@ -723,12 +692,43 @@ void RoomExplorationServer::navigateExplorationPath(const std::vector<geometry_m
 
 		// if no interrupt is wanted, publish the navigation goal
 		pose = exploration_path[map_oriented_pose];
+
+		if (online_coverage_execution_ == true)
+		{
+			// add the robot poses tracked on the way to the previous goal to the coverage map
+			for (; number_of_tracked_robot_poses<robot_poses.size(); ++number_of_tracked_robot_poses)
+				coverage_grid.addRobotPose(robot_poses[number_of_tracked_robot_poses]);
+
+			// skip goals whose coverage area has already been covered on the way
+			if (coverage_grid.getCoveredRatio(pose) >= skip_covered_goals_ratio_)
+			{
+				++number_of_skipped_covered_goals;
+				continue;
+			}
+
+			// check the reachability of the next batch of goals against the latest costmap
+			if (reachability_batch_size_ > 0)
+			{
+				if (map_oriented_pose >= reachability_batch_begin+goal_reachable.size())
+				{
+					reachability_batch_begin = map_oriented_pose;
+					computeGoalReachability(exploration_path, reachability_batch_begin,
+							std::min((size_t)reachability_batch_size_, exploration_path.size()-reachability_batch_begin), robot_poses, goal_reachable);
+				}
+				if (goal_reachable[map_oriented_pose-reachability_batch_begin] == false)
+				{
+					++number_of_skipped_unreachable_goals;
+					continue;
+				}
+			}
+		}
+
 		// todo: convert map to image properly, then this coordinate correction here becomes obsolete
 		//pose.y = map_height - (pose.y - map_origin.position.y) + map_origin.position.y;
 		double temp_goal_eps = 0;
 		if (use_dyn_goal_eps_)
 		{
-		if (map_oriented_pose != 0)
+		if (published_goal == true)
 		{
 			double delta_theta = std::fabs(last_pose.theta - pose.theta);
 			if (delta_theta > M_PI * 0.5)
@@ -742,60 +742,73 @@ void RoomExplorationServer::navigateExplorationPath(const std::vector<geometry_m
 		}
 		publishNavigationGoal(pose, map_frame_, camera_frame_, robot_poses, distance_robot_fov_middlepoint, temp_goal_eps, true); // eps = 0.35
 		last_pose = pose;
+		published_goal = true;
 	}
+	global_costmap_sub.shutdown();
 
 	std::cout << "published all navigation goals, starting to check seen area" << std::endl;
-
-	// 2. get the global costmap, that has initially not known objects in to check what regions have been seen
-	nav_msgs::OccupancyGrid global_costmap;
-	global_costmap = *(ros::topic::waitForMessage<nav_msgs::OccupancyGrid>(global_costmap_topic_));
-	ROS_INFO("Found global gridmap.");
-
-	std::vector<signed char> pixel_values;
-	pixel_values = global_costmap.data;
+	if (online_coverage_execution_ == true)
+	{
+		for (; number_of_tracked_robot_poses<robot_poses.size(); ++number_of_tracked_robot_poses)
+			coverage_grid.addRobotPose(robot_poses[number_of_tracked_robot_poses]);
+		std::cout << "skipped " << number_of_skipped_covered_goals << " already covered and " << number_of_skipped_unreachable_goals
+				<< " unreachable goals of " << exploration_path.size() << std::endl;
+	}
 
 	// if wanted check for areas that haven't been seen during the execution of the path and revisit them, if wanted
 	if(revisit_areas_ == true)
 	{
 		// save the costmap as Mat of the same type as the given map (8UC1)
 		cv::Mat costmap_as_mat;//(global_map.cols, global_map.rows, CV_8UC1);
+		cv::Mat coverage_map, number_of_coverage_image;
+
+		// 2. get the global costmap, that has initially not known objects in to check what regions have been seen
+		nav_msgs::OccupancyGrid global_costmap;
+		global_costmap = *(ros::topic::waitForMessage<nav_msgs::OccupancyGrid>(global_costmap_topic_));
+		ROS_INFO("Found global gridmap.");
 
 		mapToMat(global_costmap, costmap_as_mat);
 
 		// 70% probability of being an obstacle
 		cv::threshold(costmap_as_mat, costmap_as_mat, 75, 255, cv::THRESH_BINARY_INV);
 
-		// 3. draw the seen positions so the server can check what points haven't been seen
-		std::cout << "checking coverage using the coverage_check_server" << std::endl;
-		cv::Mat coverage_map, number_of_coverage_image;
-		// use the coverage check server to check which areas have been seen
-		//   --> convert path to cv format
-		std::vector<cv::Point3d> path;
-		for (size_t i=0; i<robot_poses.size(); ++i)
-			path.push_back(cv::Point3d(robot_poses[i].x, robot_poses[i].y, robot_poses[i].theta));
-		//   --> convert field of view to Eigen format
-		std::vector<Eigen::Matrix<float, 2, 1> > fov;
-		for(size_t i = 0; i < field_of_view.size(); ++i)
-		{
-			Eigen::Matrix<float, 2, 1> current_vector;
-			current_vector << field_of_view[i].x, field_of_view[i].y;
-			fov.push_back(current_vector);
-		}
-		//   --> convert field of view origin to Eigen format
-		Eigen::Matrix<float, 2, 1> fov_origin;
-		fov_origin <<field_of_view_origin.x, field_of_view_origin.y;
-		//   --> call coverage checker
-		CoverageCheckServer coverage_checker;
-		if (coverage_checker.checkCoverage(costmap_as_mat, map_resolution, cv::Point2d(map_origin.position.x, map_origin.position.y),
-				path, fov, fov_origin, coverage_radius, (planning_mode_==PLAN_FOR_FOOTPRINT), false, coverage_map, number_of_coverage_image) == true)
+		if (online_coverage_execution_ == true)
 		{
-			std::cout << "got the service response" << std::endl;
+			// the coverage has already been tracked during the execution on the room map, the obstacles of the costmap are added
+			// to it s.t. they are not revisited
+			coverage_map = coverage_grid.getCoverageMap().clone();
+			if (coverage_map.size() == costmap_as_mat.size())
+			{
+				coverage_map.setTo(0, costmap_as_mat==0);
+			}
+			else
+			{
+				ROS_WARN("The global costmap does not match the room map, using the room map as obstacle map for revisiting.");
+				cv::threshold(room_map, costmap_as_mat, 127, 255, cv::THRESH_BINARY);
+			}
 		}
 		else
 		{
-			ROS_WARN("Coverage check failed, is the coverage_check_server running?");
-			room_exploration_server_.setAborted();
-			return;
+			// 3. draw the seen positions so the server can check what points haven't been seen
+			std::cout << "checking coverage using the coverage_check_server" << std::endl;
+			// use the coverage check server to check which areas have been seen
+			//   --> convert path to cv format
+			std::vector<cv::Point3d> path;
+			for (size_t i=0; i<robot_poses.size(); ++i)
+				path.push_back(cv::Point3d(robot_poses[i].x, robot_poses[i].y, robot_poses[i].theta));
+			//   --> call coverage checker
+			CoverageCheckServer coverage_checker;
+			if (coverage_checker.checkCoverage(costmap_as_mat, map_resolution, cv::Point2d(map_origin.position.x, map_origin.position.y),
+					path, fov, fov_origin, coverage_radius, (planning_mode_==PLAN_FOR_FOOTPRINT), false, coverage_map, number_of_coverage_image) == true)
+			{
+				std::cout << "got the service response" << std::endl;
+			}
+			else
+			{
+				ROS_WARN("Coverage check failed, is the coverage_check_server running?");
+				room_exploration_server_.setAborted();
+				return;
+			}
 		}
 
 //		// service interface - can be deleted
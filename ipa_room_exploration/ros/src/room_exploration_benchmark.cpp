@@ -0,0 +1,652 @@
+/*!
+ *****************************************************************
+ * \file
+ *
+ * \note
+ * Copyright (c) 2026 \n
+ * Fraunhofer Institute for Manufacturing Engineering
+ * and Automation (IPA) \n\n
+ *
+ *****************************************************************
+ *
+ * \note
+ * Project name: Care-O-bot
+ * \note
+ * ROS stack name: autopnp
+ * \note
+ * ROS package name: ipa_room_exploration
+ *
+ * \brief
+ *
+ *
+ *****************************************************************
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer. \n
+ * - Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution. \n
+ * - Neither the name of the Fraunhofer Institute for Manufacturing
+ * Engineering and Automation (IPA) nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission. \n
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************/
+
+
+#include <ros/package.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <map>
+
+#include <opencv2/opencv.hpp>
+#include <opencv2/highgui/highgui.hpp>
+
+#include <Eigen/Dense>
+
+#include <nav_msgs/OccupancyGrid.h>
+#include <geometry_msgs/Pose2D.h>
+
+#include <ipa_room_exploration/grid_point_explorator.h>
+#include <ipa_room_exploration/boustrophedon_explorator.h>
+#include <ipa_room_exploration/neural_network_explorator.h>
+#include <ipa_room_exploration/convex_sensor_placement_explorator.h>
+#include <ipa_room_exploration/flow_network_explorator.h>
+#include <ipa_room_exploration/energy_functional_explorator.h>
+#include <ipa_room_exploration/voronoi.hpp>
+#include <ipa_room_exploration/path_post_processor.h>
+#include <ipa_room_exploration/coverage_check_server.h>
+#include <ipa_room_exploration/timer.h>
+
+
+// Standalone benchmark of the coverage path planners. Each algorithm is run on every room of the bundled test maps
+// (ground truth segmentation of ipa_room_segmentation) directly via the planner libraries, i.e. without the action server.
+// Every single run is executed in its own worker process, so a crashing or hanging planner only loses this one run and the
+// peak memory of the planner can be measured in isolation (the peak resident set size of the worker includes the memory
+// inherited from the benchmark process, which is small compared to the planners). The results are written as one csv line per run:
+//   map,room,algorithm,status,planning_time_s,peak_rss_kb,path_length_m,number_of_poses,coverage_ratio
+// usage: room_exploration_benchmark [-o results.csv] [-a 1,2,3,4,5,6,7,8] [-m lab_ipa,lab_c_scan] [-t timeout_in_s] [-p params.yaml]
+//
+// All planners plan for the robot footprint with the planner parameters read from room_exploration_action_server_params.yaml
+// (or the file given with -p), so the benchmark always runs with the same settings as the action server.
+
+
+// parameters of one benchmark run, the planner parameters are read from the parameter file of the action server
+struct BenchmarkSettings
+{
+	double map_resolution;	// [m/pixel]
+	cv::Point2d map_origin;	// [m]
+	double robot_radius;	// [m]
+	double coverage_radius;	// [m]
+	int map_correction_closing_neighborhood_size;	// [pixel]
+	double timeout;		// [s], a run that takes longer is killed
+
+	// planner parameters, see readPlannerParameters()
+	int tsp_solver;
+	int64_t tsp_solver_timeout;
+	double min_cell_area;
+	double path_eps;
+	double grid_obstacle_offset;
+	int max_deviation_from_track;
+	int cell_visiting_order;
+	double step_size, A, B, D, E, mu, delta_theta_weight;
+	int number_of_threads;
+	double neural_network_update_threshold;
+	double delta_theta;
+	double curvature_factor;
+	double max_distance_factor;
+	bool use_cut_generator;
+
+	BenchmarkSettings()
+	{
+		map_resolution = 0.05;
+		map_origin = cv::Point2d(0., 0.);
+		robot_radius = 0.3;
+		coverage_radius = 0.3;
+		timeout = 600.;
+	}
+};
+
+// one room of a test map that is planned by all algorithms
+struct BenchmarkRoom
+{
+	cv::Mat room_map;	// preprocessed room map, free space 255, everything else 0
+	cv::Point starting_position;	// [pixel]
+};
+
+// result of one run
+struct BenchmarkResult
+{
+	std::string status;	// ok, empty_path, timeout, crashed
+	double planning_time;	// [s]
+	long peak_rss;		// [kB], peak resident set size of the worker process
+	double path_length;	// [m]
+	size_t number_of_poses;
+	double coverage_ratio;	// covered free pixels / all free pixels of the room
+};
+
+
+// splits a comma separated list
+std::vector<std::string> splitList(const std::string& list)
+{
+	std::vector<std::string> items;
+	std::stringstream stream(list);
+	std::string item;
+	while (std::getline(stream, item, ','))
+		if (item.length() > 0)
+			items.push_back(item);
+	return items;
+}
+
+// reads the value of the given key from the parameters, returns false if the key is missing or the value cannot be converted
+template <typename T>
+bool getParameter(const std::map<std::string, std::string>& parameters, const std::string& key, T& value)
+{
+	std::map<std::string, std::string>::const_iterator parameter = parameters.find(key);
+	if (parameter == parameters.end())
+	{
+		std::cout << "room_exploration_benchmark: Error: parameter " << key << " is missing in the parameter file." << std::endl;
+		return false;
+	}
+	std::stringstream stream(parameter->second);
+	if (!(stream >> std::boolalpha >> value))
+	{
+		std::cout << "room_exploration_benchmark: Error: could not read the value " << parameter->second << " of parameter " << key << "." << std::endl;
+		return false;
+	}
+	return true;
+}
+
+// reads the planner parameters from the parameter file of the action server, which contains one "key: value" pair per line,
+// comments start with #, returns false if the file cannot be read or a parameter is missing
+bool readPlannerParameters(const std::string& parameter_filename, BenchmarkSettings& settings)
+{
+	std::ifstream file(parameter_filename.c_str(), std::ios::in);
+	if (file.is_open() == false)
+	{
+		std::cout << "room_exploration_benchmark: Error: could not open the parameter file " << parameter_filename << std::endl;
+		return false;
+	}
+	std::map<std::string, std::string> parameters;
+	std::string line;
+	while (std::getline(file, line))
+	{
+		const std::size_t comment = line.find('#');
+		if (comment != std::string::npos)
+			line = line.substr(0, comment);
+		const std::size_t separator = line.find(':');
+		if (separator == std::string::npos)
+			continue;
+		std::stringstream key_stream(line.substr(0, separator));
+		std::string key;
+		if (key_stream >> key)
+			parameters[key] = line.substr(separator+1);
+	}
+
+	bool success = getParameter(parameters, "map_correction_closing_neighborhood_size", settings.map_correction_closing_neighborhood_size);
+	success = getParameter(parameters, "tsp_solver", settings.tsp_solver) && success;
+	success = getParameter(parameters, "tsp_solver_timeout", settings.tsp_solver_timeout) && success;
+	success = getParameter(parameters, "min_cell_area", settings.min_cell_area) && success;
+	success = getParameter(parameters, "path_eps", settings.path_eps) && success;
+	success = getParameter(parameters, "grid_obstacle_offset", settings.grid_obstacle_offset) && success;
+	success = getParameter(parameters, "max_deviation_from_track", settings.max_deviation_from_track) && success;
+	success = getParameter(parameters, "cell_visiting_order", settings.cell_visiting_order) && success;
+	success = getParameter(parameters, "step_size", settings.step_size) && success;
+	success = getParameter(parameters, "A", settings.A) && success;
+	success = getParameter(parameters, "B", settings.B) && success;
+	success = getParameter(parameters, "D", settings.D) && success;
+	success = getParameter(parameters, "E", settings.E) && success;
+	success = getParameter(parameters, "mu", settings.mu) && success;
+	success = getParameter(parameters, "delta_theta_weight", settings.delta_theta_weight) && success;
+	success = getParameter(parameters, "number_of_threads", settings.number_of_threads) && success;
+	success = getParameter(parameters, "neural_network_update_threshold", settings.neural_network_update_threshold) && success;
+	success = getParameter(parameters, "delta_theta", settings.delta_theta) && success;
+	success = getParameter(parameters, "curvature_factor", settings.curvature_factor) && success;
+	success = getParameter(parameters, "max_distance_factor", settings.max_distance_factor) && success;
+	success = getParameter(parameters, "use_cut_generator", settings.use_cut_generator) && success;
+	return success;
+}
+
+// applies the same closing as the action server and keeps only the largest connected free area,
+// returns false if no free space is left
+bool preprocessRoomMap(cv::Mat& room_map, const int closing_neighborhood_size)
+{
+	cv::Mat temp;
+	cv::erode(room_map, temp, cv::Mat(), cv::Point(-1, -1), closing_neighborhood_size);
+	cv::dilate(temp, room_map, cv::Mat(), cv::Point(-1, -1), closing_neighborhood_size);
+
+	// label the free areas with 1,2,3,... and find the largest one
+	cv::Mat labels;
+	room_map.convertTo(labels, CV_32SC1);
+	int label = 1, largest_label = 0;
+	double largest_area = 0.;
+	for (int v=0; v<labels.rows; ++v)
+	{
+		for (int u=0; u<labels.cols; ++u)
+		{
+			if (labels.at<int>(v,u) != 255)
+				continue;
+			cv::Rect bounding_box;
+			const double area = cv::floodFill(labels, cv::Point(u,v), cv::Scalar(-label), &bounding_box, 0, 0, 4);
+			if (area > largest_area)
+			{
+				largest_area = area;
+				largest_label = -label;
+			}
+			++label;
+		}
+	}
+	if (largest_label == 0)
+		return false;
+	for (int v=0; v<labels.rows; ++v)
+		for (int u=0; u<labels.cols; ++u)
+			room_map.at<uchar>(v,u) = (labels.at<int>(v,u)==largest_label ? 255 : 0);
+	return true;
+}
+
+// reads the ground truth segmentation of the given test map and returns the preprocessed maps of the accessible rooms,
+// together with a starting position at the point of maximum wall distance of each room
+void getRoomMaps(const std::string& test_map_path, const std::string& map_name, const BenchmarkSettings& settings, std::vector<BenchmarkRoom>& rooms)
+{
+	std::string map_name_basic = map_name;
+	std::size_t pos = map_name.find("_furnitures");
+	if (pos != std::string::npos)
+		map_name_basic = map_name.substr(0, pos);
+	cv::Mat gt_map = cv::imread((test_map_path + map_name_basic + "_gt_segmentation.png").c_str(), CV_8U);
+	cv::Mat floor_plan = cv::imread((test_map_path + map_name + ".png").c_str(), CV_8U);
+	if (gt_map.empty()==true || floor_plan.empty()==true)
+	{
+		std::cout << "room_exploration_benchmark: Error: could not read map " << map_name << " from " << test_map_path << std::endl;
+		return;
+	}
+	cv::threshold(gt_map, gt_map, 250, 255, CV_THRESH_BINARY);
+	cv::threshold(floor_plan, floor_plan, 250, 255, CV_THRESH_BINARY);
+
+	// label the rooms of the ground truth map
+	cv::Mat labeled_map;
+	gt_map.convertTo(labeled_map, CV_32SC1);
+	int label = 1;
+	for (int v=0; v<gt_map.rows; ++v)
+	{
+		for (int u=0; u<gt_map.cols; ++u)
+		{
+			if (gt_map.at<uchar>(v,u)!=255 || labeled_map.at<int>(v,u)!=255)
+				continue;
+			cv::floodFill(labeled_map, cv::Point(u,v), cv::Scalar(label), 0, 0, 0, 8);
+			++label;
+		}
+	}
+
+	const int robot_radius_in_pixel = settings.robot_radius/settings.map_resolution;
+	for (int room=1; room<label; ++room)
+	{
+		BenchmarkRoom benchmark_room;
+		benchmark_room.room_map = cv::Mat(labeled_map.rows, labeled_map.cols, CV_8U, cv::Scalar(0));
+		for (int v=0; v<labeled_map.rows; ++v)
+			for (int u=0; u<labeled_map.cols; ++u)
+				if (labeled_map.at<int>(v,u)==room && floor_plan.at<uchar>(v,u)==255)
+					benchmark_room.room_map.at<uchar>(v,u) = 255;
+		if (preprocessRoomMap(benchmark_room.room_map, settings.map_correction_closing_neighborhood_size) == false)
+			continue;
+
+		// skip rooms that are not accessible for the robot and start in the room center
+		cv::Mat eroded_map, distance_map;
+		cv::erode(benchmark_room.room_map, eroded_map, cv::Mat(), cv::Point(-1, -1), robot_radius_in_pixel);
+		if (cv::countNonZero(eroded_map) == 0)
+			continue;
+		cv::distanceTransform(benchmark_room.room_map, distance_map, CV_DIST_L2, 5);
+		double max_distance = 0.;
+		cv::minMaxLoc(distance_map, 0, &max_distance, 0, &benchmark_room.starting_position);
+		rooms.push_back(benchmark_room);
+	}
+}
+
+// plans the coverage path for the robot footprint with the given algorithm (same numbering as the action server),
+// the path is returned in world coordinates
+void planCoveragePath(const int algorithm, const BenchmarkRoom& room, const BenchmarkSettings& settings, std::vector<geometry_msgs::Pose2D>& path)
+{
+	const float map_resolution = settings.map_resolution;
+	const double grid_spacing_in_pixel = settings.coverage_radius*std::sqrt(2)/settings.map_resolution;
+	const int cell_size = std::floor(grid_spacing_in_pixel);
+	Eigen::Matrix<float, 2, 1> zero_vector;
+	zero_vector << 0, 0;
+	std::vector<Eigen::Matrix<float, 2, 1> > fov_corners_meter(4, zero_vector);
+
+	if (algorithm == 1)
+	{
+		GridPointExplorator planner;
+		planner.getExplorationPath(room.room_map, path, map_resolution, room.starting_position, settings.map_origin, std::floor(grid_spacing_in_pixel), true, zero_vector, settings.tsp_solver, settings.tsp_solver_timeout);
+	}
+	else if (algorithm == 2)
+	{
+		BoustrophedonExplorer planner;
+		planner.getExplorationPath(room.room_map, path, map_resolution, room.starting_position, settings.map_origin, grid_spacing_in_pixel, settings.grid_obstacle_offset, settings.path_eps, settings.cell_visiting_order, true, zero_vector, settings.min_cell_area, settings.max_deviation_from_track);
+	}
+	else if (algorithm == 3)
+	{
+		NeuralNetworkExplorator planner;
+		planner.setParameters(settings.A, settings.B, settings.D, settings.E, settings.mu, settings.step_size, settings.delta_theta_weight);
+		planner.setNumberOfThreads(settings.number_of_threads);
+		planner.setUpdateThreshold(settings.neural_network_update_threshold);
+		planner.getExplorationPath(room.room_map, path, map_resolution, room.starting_position, settings.map_origin, grid_spacing_in_pixel, true, zero_vector, false);
+	}
+	else if (algorithm == 4)
+	{
+		convexSPPExplorator planner;
+		planner.getExplorationPath(room.room_map, path, map_resolution, room.starting_position, settings.map_origin, cell_size, settings.delta_theta, fov_corners_meter, zero_vector, settings.coverage_radius, 7, true);
+	}
+	else if (algorithm == 5)
+	{
+		FlowNetworkExplorator planner;
+		planner.getExplorationPath(room.room_map, path, map_resolution, room.starting_position, settings.map_origin, cell_size, zero_vector, grid_spacing_in_pixel, true, settings.path_eps, settings.curvature_factor, settings.max_distance_factor, settings.use_cut_generator);
+	}
+	else if (algorithm == 6)
+	{
+		EnergyFunctionalExplorator planner;
+		planner.getExplorationPath(room.room_map, path, map_resolution, room.starting_position, settings.map_origin, grid_spacing_in_pixel, true, zero_vector);
+	}
+	else if (algorithm == 7)
+	{
+		// create a usable occupancyGrid map out of the given room map
+		nav_msgs::OccupancyGrid room_gridmap;
+		room_gridmap.info.width = room.room_map.cols;
+		room_gridmap.info.height = room.room_map.rows;
+		room_gridmap.data.resize(room.room_map.cols*room.room_map.rows);
+		for (int v=0; v<room.room_map.rows; ++v)
+			for (int u=0; u<room.room_map.cols; ++u)
+				room_gridmap.data[v*room.room_map.cols+u] = (room.room_map.at<uchar>(v,u)!=0 ? 0 : 100);
+
+		VoronoiMap vm(room_gridmap.data.data(), room_gridmap.info.width, room_gridmap.info.height, cell_size, 2, true);
+		std::vector<geometry_msgs::Pose2D> exploration_path_uncleaned;
+		vm.setSingleRoom(true);
+		vm.generatePath(exploration_path_uncleaned, cv::Mat(), room.starting_position.x, room.starting_position.y);
+
+		PathPostProcessor path_processor;
+		path_processor.setDownsampling(3.5);	// [pixel]
+		path_processor.setWorldTransform(map_resolution, settings.map_origin);
+		path_processor.process(exploration_path_uncleaned, path);
+	}
+	else if (algorithm == 8)
+	{
+		BoustrophedonVariantExplorer planner;
+		planner.getExplorationPath(room.room_map, path, map_resolution, room.starting_position, settings.map_origin, grid_spacing_in_pixel, settings.grid_obstacle_offset, settings.path_eps, settings.cell_visiting_order, true, zero_vector, settings.min_cell_area, settings.max_deviation_from_track);
+	}
+	else
+	{
+		std::cout << "room_exploration_benchmark: Error: unknown algorithm " << algorithm << std::endl;
+	}
+}
+
+// computes the path length and the fraction of the free room area that is covered by the footprint along the path
+void evaluatePath(const BenchmarkRoom& room, const BenchmarkSettings& settings, const std::vector<geometry_msgs::Pose2D>& path, BenchmarkResult& result)
+{
+	result.number_of_poses = path.size();
+	result.path_length = 0.;
+	result.coverage_ratio = 0.;
+	if (path.size() == 0)
+		return;
+
+	// interpolate the path with map resolution, the footprint covers the area in between the poses as well
+	std::vector<cv::Point3d> interpolated_path;
+	interpolated_path.push_back(cv::Point3d(path[0].x, path[0].y, path[0].theta));
+	for (size_t i=1; i<path.size(); ++i)
+	{
+		const double dx = path[i].x - path[i-1].x;
+		const double dy = path[i].y - path[i-1].y;
+		const double distance = std::sqrt(dx*dx + dy*dy);
+		result.path_length += distance;
+		const int steps = std::max(1, (int)std::ceil(distance/settings.map_resolution));
+		for (int s=1; s<=steps; ++s)
+			interpolated_path.push_back(cv::Point3d(path[i-1].x + dx*s/steps, path[i-1].y + dy*s/steps, path[i].theta));
+	}
+
+	// draw the covered area
+	std::vector<Eigen::Matrix<float, 2, 1> > field_of_view;
+	Eigen::Matrix<float, 2, 1> fov_origin;
+	fov_origin << 0, 0;
+	cv::Mat coverage_map, number_of_coverage_image;
+	CoverageCheckServer coverage_checker;
+	if (coverage_checker.checkCoverage(room.room_map, settings.map_resolution, settings.map_origin, interpolated_path, field_of_view, fov_origin,
+			settings.coverage_radius, true, false, coverage_map, number_of_coverage_image) == false)
+		return;
+	int free_pixels = 0, covered_pixels = 0;
+	for (int v=0; v<coverage_map.rows; ++v)
+	{
+		for (int u=0; u<coverage_map.cols; ++u)
+		{
+			if (room.room_map.at<uchar>(v,u) != 255)
+				continue;
+			++free_pixels;
+			if (coverage_map.at<uchar>(v,u) == 127)
+				++covered_pixels;
+		}
+	}
+	if (free_pixels > 0)
+		result.coverage_ratio = (double)covered_pixels/(double)free_pixels;
+}
+
+// writes a buffer completely into a file descriptor
+bool writeAll(const int fd, const void* data, size_t size)
+{
+	const char* buffer = (const char*)data;
+	while (size > 0)
+	{
+		const ssize_t written = write(fd, buffer, size);
+		if (written <= 0)
+			return false;
+		buffer += written;
+		size -= written;
+	}
+	return true;
+}
+
+// runs one planner in a forked worker process that writes its planning time and path into a temporary file,
+// the worker is killed if it exceeds the timeout, the peak memory is read from the resource usage of the worker
+void runIsolated(const int algorithm, const BenchmarkRoom& room, const BenchmarkSettings& settings, BenchmarkResult& result,
+		std::vector<geometry_msgs::Pose2D>& path)
+{
+	result.status = "crashed";
+	result.planning_time = 0.;
+	result.peak_rss = 0;
+	path.clear();
+
+	char result_filename[] = "/tmp/room_exploration_benchmark_XXXXXX";
+	const int result_file = mkstemp(result_filename);
+	if (result_file < 0)
+	{
+		std::cout << "room_exploration_benchmark: Error: could not create a temporary result file." << std::endl;
+		return;
+	}
+	std::cout.flush();
+
+	const pid_t pid = fork();
+	if (pid < 0)
+	{
+		std::cout << "room_exploration_benchmark: Error: could not start the worker process." << std::endl;
+		close(result_file);
+		unlink(result_filename);
+		return;
+	}
+	if (pid == 0)
+	{
+		// worker process: plan and report, without running any destructors of the parent's state
+		std::vector<geometry_msgs::Pose2D> worker_path;
+		Timer timer;
+		planCoveragePath(algorithm, room, settings, worker_path);
+		const double planning_time = timer.getElapsedTimeInSec();
+		std::vector<double> buffer;
+		buffer.reserve(2+3*worker_path.size());
+		buffer.push_back(planning_time);
+		buffer.push_back(worker_path.size());
+		for (size_t i=0; i<worker_path.size(); ++i)
+		{
+			buffer.push_back(worker_path[i].x);
+			buffer.push_back(worker_path[i].y);
+			buffer.push_back(worker_path[i].theta);
+		}
+		std::cout.flush();
+		_exit(writeAll(result_file, buffer.data(), buffer.size()*sizeof(double))==true ? 0 : 1);
+	}
+
+	// wait for the worker, kill it after the timeout
+	int status = 0;
+	struct rusage usage;
+	Timer timer;
+	pid_t finished = 0;
+	while (finished == 0)
+	{
+		finished = wait4(pid, &status, WNOHANG, &usage);
+		if (finished == 0)
+		{
+			if (timer.getElapsedTimeInSec() > settings.timeout)
+			{
+				kill(pid, SIGKILL);
+				finished = wait4(pid, &status, 0, &usage);
+				result.status = "timeout";
+				result.planning_time = settings.timeout;
+			}
+			else
+				usleep(10000);
+		}
+	}
+	if (finished == pid)
+		result.peak_rss = usage.ru_maxrss;
+
+	// read the result of a regularly finished worker
+	if (finished==pid && result.status!="timeout" && WIFEXITED(status) && WEXITSTATUS(status)==0)
+	{
+		std::ifstream file(result_filename, std::ios::in | std::ios::binary);
+		double header[2];
+		if (file.read((char*)header, sizeof(header)))
+		{
+			result.planning_time = header[0];
+			std::vector<double> poses(3*(size_t)header[1]);
+			if (poses.size()==0 || file.read((char*)poses.data(), poses.size()*sizeof(double)))
+			{
+				for (size_t i=0; i+2<poses.size(); i+=3)
+				{
+					geometry_msgs::Pose2D pose;
+					pose.x = poses[i];
+					pose.y = poses[i+1];
+					pose.theta = poses[i+2];
+					path.push_back(pose);
+				}
+				result.status = (path.size()>0 ? "ok" : "empty_path");
+			}
+		}
+	}
+	close(result_file);
+	unlink(result_filename);
+}
+
+
+int main(int argc, char **argv)
+{
+	BenchmarkSettings settings;
+	std::string output_filename = "room_exploration_benchmark.csv";
+	std::string parameter_filename = ros::package::getPath("ipa_room_exploration") + "/ros/launch/room_exploration_action_server_params.yaml";
+	std::vector<int> algorithms;
+	std::vector<std::string> map_names;
+
+	// read the command line
+	for (int i=1; i+1<argc; i+=2)
+	{
+		const std::string option(argv[i]);
+		if (option == "-o")
+			output_filename = argv[i+1];
+		else if (option == "-t")
+			settings.timeout = atof(argv[i+1]);
+		else if (option == "-p")
+			parameter_filename = argv[i+1];
+		else if (option == "-m")
+			map_names = splitList(argv[i+1]);
+		else if (option == "-a")
+		{
+			std::vector<std::string> items = splitList(argv[i+1]);
+			for (size_t j=0; j<items.size(); ++j)
+				algorithms.push_back(atoi(items[j].c_str()));
+		}
+		else
+		{
+			std::cout << "usage: room_exploration_benchmark [-o results.csv] [-a 1,2,3,4,5,6,7,8] [-m lab_ipa,lab_c_scan] [-t timeout_in_s] [-p params.yaml]" << std::endl;
+			return 1;
+		}
+	}
+	if (readPlannerParameters(parameter_filename, settings) == false)
+		return 1;
+	if (algorithms.size() == 0)
+		for (int algorithm=1; algorithm<=8; ++algorithm)
+			algorithms.push_back(algorithm);
+	if (map_names.size() == 0)
+	{
+		map_names.push_back("lab_ipa");
+		map_names.push_back("lab_c_scan");
+		map_names.push_back("Freiburg52_scan");
+	}
+
+	std::ofstream output(output_filename.c_str(), std::ios::out);
+	if (output.is_open() == false)
+	{
+		std::cout << "room_exploration_benchmark: Error: could not open " << output_filename << std::endl;
+		return 1;
+	}
+	output << "map,room,algorithm,status,planning_time_s,peak_rss_kb,path_length_m,number_of_poses,coverage_ratio" << std::endl;
+
+	const std::string test_map_path = ros::package::getPath("ipa_room_segmentation") + "/common/files/test_maps/";
+	for (size_t m=0; m<map_names.size(); ++m)
+	{
+		std::vector<BenchmarkRoom> rooms;
+		getRoomMaps(test_map_path, map_names[m], settings, rooms);
+		std::cout << "room_exploration_benchmark: map " << map_names[m] << " has " << rooms.size() << " accessible rooms." << std::endl;
+
+		for (size_t r=0; r<rooms.size(); ++r)
+		{
+			for (size_t a=0; a<algorithms.size(); ++a)
+			{
+				BenchmarkResult result;
+				std::vector<geometry_msgs::Pose2D> path;
+				runIsolated(algorithms[a], rooms[r], settings, result, path);
+				evaluatePath(rooms[r], settings, path, result);
+
+				output << map_names[m] << "," << r << "," << algorithms[a] << "," << result.status << "," << result.planning_time << ","
+						<< result.peak_rss << "," << result.path_length << "," << result.number_of_poses << "," << result.coverage_ratio << std::endl;
+				std::cout << "room_exploration_benchmark: " << map_names[m] << " room " << r << " algorithm " << algorithms[a] << ": " << result.status
+						<< ", " << result.planning_time << " s, " << result.peak_rss << " kB, " << result.path_length << " m, coverage " << result.coverage_ratio << std::endl;
+			}
+		}
+	}
+	output.close();
+
+	return 0;
+}
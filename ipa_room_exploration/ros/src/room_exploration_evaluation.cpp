@@ -68,6 +68,7 @@
 #include <iostream>
 #include <fstream>
 #include <numeric>
+#include <climits>
 
 #include <opencv2/opencv.hpp>
 #include <opencv2/highgui/highgui.hpp>
@@ -100,6 +101,9 @@
 #include <Eigen/Dense>
 
 #include <boost/regex.hpp>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
 
 #include <cob_map_accessibility_analysis/map_accessibility_analysis.h>
 
@@ -239,6 +243,131 @@ struct ExplorationData
 };
 
 
+// Uniform grid over the map pixels that stores the indices of the poses of an interpolated path (in [m]) per pixel cell.
+// Used to find the path pose at a given trajectory pixel without searching through the whole path.
+class PathPoseGridIndex
+{
+public:
+	PathPoseGridIndex(const std::vector<geometry_msgs::Pose2D>& path, const double map_resolution, const cv::Point2d& map_origin)
+	: path_(path), map_resolution_(map_resolution), map_origin_(map_origin)
+	{
+		if (path.size() == 0)
+			return;
+		min_cell_ = cv::Point(INT_MAX, INT_MAX);
+		cv::Point max_cell(INT_MIN, INT_MIN);
+		for (size_t i=0; i<path.size(); ++i)
+		{
+			const cv::Point cell = getCell(path[i].x, path[i].y);
+			min_cell_.x = std::min(min_cell_.x, cell.x);
+			min_cell_.y = std::min(min_cell_.y, cell.y);
+			max_cell.x = std::max(max_cell.x, cell.x);
+			max_cell.y = std::max(max_cell.y, cell.y);
+		}
+		width_ = max_cell.x - min_cell_.x + 1;
+		height_ = max_cell.y - min_cell_.y + 1;
+		cells_.resize(width_*height_);
+		for (size_t i=0; i<path.size(); ++i)
+		{
+			const cv::Point cell = getCell(path[i].x, path[i].y);
+			cells_[(cell.y-min_cell_.y)*width_ + (cell.x-min_cell_.x)].push_back(i);
+		}
+	}
+
+	// returns the largest index of a path pose that is closer than max_distance (in [m], at most half a pixel) to the given point (in [m]), -1 if there is none
+	int findLastPoseNear(const cv::Point2f& point, const double max_distance) const
+	{
+		int pose_index = -1;
+		if (cells_.size() == 0)
+			return pose_index;
+		const cv::Point center_cell = getCell(point.x, point.y);
+		for (int v=center_cell.y-1; v<=center_cell.y+1; ++v)
+		{
+			for (int u=center_cell.x-1; u<=center_cell.x+1; ++u)
+			{
+				if (u<min_cell_.x || v<min_cell_.y || u>=min_cell_.x+width_ || v>=min_cell_.y+height_)
+					continue;
+				const std::vector<int>& cell = cells_[(v-min_cell_.y)*width_ + (u-min_cell_.x)];
+				for (std::vector<int>::const_iterator index=cell.begin(); index!=cell.end(); ++index)
+					if (*index > pose_index && cv::norm(point-cv::Point2f(path_[*index].x, path_[*index].y)) < max_distance)
+						pose_index = *index;
+			}
+		}
+		return pose_index;
+	}
+
+protected:
+
+	cv::Point getCell(const double x, const double y) const
+	{
+		return cv::Point(cvRound((x-map_origin_.x)/map_resolution_), cvRound((y-map_origin_.y)/map_resolution_));
+	}
+
+	const std::vector<geometry_msgs::Pose2D>& path_;	// in [m]
+	const double map_resolution_;		// in [m/pixel]
+	const cv::Point2d map_origin_;		// in [m]
+	cv::Point min_cell_;		// pixel of the first grid cell
+	int width_, height_;		// number of grid cells
+	std::vector<std::vector<int> > cells_;	// path pose indices per grid cell, row-major
+};
+
+// statistics of the path of one room, computed independently for each room
+struct RoomPathStatistics
+{
+	bool valid;		// false if the room has no valid path
+	double pathlength;		// in [m]
+	double rotation_abs;	// in [rad]
+	int number_of_rotations;
+	std::vector<geometry_msgs::Pose2D> interpolated_path;	// in [m]
+	std::vector<cv::Point> path_pixels;		// the pixels of the interpolated path in path order without the start pixel, in [pixels]
+	std::vector<size_t> segment_ends;		// end index in path_pixels of each segment between two consecutive poses
+
+	RoomPathStatistics()
+	: valid(false), pathlength(0.), rotation_abs(0.), number_of_rotations(0)
+	{
+	}
+};
+
+// coverage statistics of one room
+struct RoomCoverageStatistics
+{
+	bool valid;		// false if the room has no valid path
+	double room_area;		// in [m^2]
+	double covered_percentage;		// in [0,1]
+	std::vector<double> numbers_of_coverages;	// number of coverages of each covered pixel
+
+	RoomCoverageStatistics()
+	: valid(false), room_area(0.), covered_percentage(0.)
+	{
+	}
+};
+
+// parallelism statistics of one room
+struct RoomParallelismStatistics
+{
+	bool valid;		// false if the room has no valid path
+	double wall_angle_score_mean;
+	double trajectory_angle_score_mean;
+	double revisit_time_mean;
+
+	RoomParallelismStatistics()
+	: valid(false), wall_angle_score_mean(0.), trajectory_angle_score_mean(0.), revisit_time_mean(0.)
+	{
+	}
+};
+
+// the rooms of one map that are evaluated in parallel, each thread takes the next unprocessed room
+struct RoomEvaluationQueue
+{
+	size_t number_of_rooms;
+	size_t next_room;		// index of the next room that has not been taken by a thread yet
+	boost::mutex mutex;		// protects next_room
+
+	RoomEvaluationQueue(const size_t rooms)
+	: number_of_rooms(rooms), next_room(0)
+	{
+	}
+};
+
 // class that segments the wanted maps, finds for each resulting room a coverage path and saves these paths
 class ExplorationEvaluation
 {
@@ -644,15 +773,19 @@ public:
 	// function that reads out the calculated paths and does the evaluation
 	void evaluateCoveragePaths(const ExplorationData& data, const std::vector<ExplorationConfig>& configs, const std::string data_storage_path)
 	{
+		// the wall gradients only depend on the map, so they are computed once for all configurations
+		const cv::Mat gradient_map = computeGradientMap(data.floor_plan_);
+
 		// evaluate the individual configurations
 		for(std::vector<ExplorationConfig>::const_iterator config=configs.begin(); config!=configs.end(); ++config)
 		{
-			evaluateCoveragePaths(data, *config, data_storage_path);
+			evaluateCoveragePaths(data, *config, data_storage_path, gradient_map);
 		}
 	}
 
-	// function that reads out the calculated paths and does the evaluation for one configuration
-	void evaluateCoveragePaths(const ExplorationData& data, const ExplorationConfig& config, const std::string data_storage_path)
+	// function that reads out the calculated paths and does the evaluation for one configuration,
+	// gradient_map is the output of computeGradientMap(data.floor_plan_)
+	void evaluateCoveragePaths(const ExplorationData& data, const ExplorationConfig& config, const std::string data_storage_path, const cv::Mat& gradient_map)
 	{
 		const std::string configuration_folder_name = config.generateConfigurationFolderString() + "/";
 		std::cout << configuration_folder_name << data.map_name_ << std::endl;
@@ -740,7 +873,7 @@ public:
 		// 8. parallelism: for each part of the path calculate the parallelism with respect to the nearest wall and the nearest trajectory part
 		std::vector<double> wall_angle_score_means, trajectory_angle_score_means;	// score for parallelism of trajectory to walls and previous parts of the trajectory itself, in range [0,1], high values are good
 		std::vector<double> revisit_time_means; // vector that stores the index-differences of the current pose and the point of its nearest neighboring trajectory, values in [0,1], low values are good
-		statisticsParallelism(data, map, path_map, paths, interpolated_paths, grid_spacing_in_pixel, wall_angle_score_means, trajectory_angle_score_means, revisit_time_means);
+		statisticsParallelism(data, map, path_map, gradient_map, paths, interpolated_paths, grid_spacing_in_pixel, wall_angle_score_means, trajectory_angle_score_means, revisit_time_means);
 		// calculate mean and stddev of the wall angle scores
 		const double wall_angle_score_mean = std::accumulate(wall_angle_score_means.begin(), wall_angle_score_means.end(), 0.0) / std::max(1.0, (double)wall_angle_score_means.size());
 		const double wall_angle_score_stddev = stddev(wall_angle_score_means, wall_angle_score_mean);
@@ -1001,288 +1134,246 @@ public:
 		return gradient_map;
 	}
 
-	// path map, path length, turns, crossings statistics
+	// processes the rooms of a map in parallel, process_room is called once for each room index by one of the threads
+	void processRoomsInParallel(const size_t number_of_rooms, const boost::function<void (size_t)>& process_room)
+	{
+		RoomEvaluationQueue queue(number_of_rooms);
+		const int number_of_threads = std::max(1, std::min((int)boost::thread::hardware_concurrency(), (int)number_of_rooms));
+		if (number_of_threads == 1)
+		{
+			processRoomsOfQueue(&queue, process_room);
+			return;
+		}
+		boost::thread_group threads;
+		for (int t=0; t<number_of_threads; ++t)
+			threads.create_thread(boost::bind(&ExplorationEvaluation::processRoomsOfQueue, this, &queue, process_room));
+		threads.join_all();
+	}
+
+	// worker of processRoomsInParallel, takes rooms from the queue until all are processed
+	void processRoomsOfQueue(RoomEvaluationQueue* queue, const boost::function<void (size_t)> process_room)
+	{
+		while (true)
+		{
+			size_t room = 0;
+			{
+				boost::mutex::scoped_lock lock(queue->mutex);
+				if (queue->next_room >= queue->number_of_rooms)
+					return;
+				room = queue->next_room;
+				++queue->next_room;
+			}
+			process_room(room);
+		}
+	}
+
+	// path map, path length, turns, crossings statistics, the rooms are processed in parallel and drawn into the path map afterwards,
+	// which also counts the crossings in the order of the rooms
 	void statisticsPathLengthCrossingsTurns(const ExplorationData& data, const cv::Mat& map, cv::Mat& path_map, const cv::Point2d& fov_circle_center_point_in_px,
 			const std::vector<std::vector<geometry_msgs::Pose2D> >& paths, std::vector<std::vector<geometry_msgs::Pose2D> >& interpolated_paths,
 			std::vector<double>& pathlengths_for_map, int& nonzero_paths, std::vector<int>& number_of_crossings,
 			std::vector<double>& rotation_values, std::vector<int>& number_of_rotations)
 	{
-		AStarPlanner path_planner;
 		MapAccessibilityAnalysis map_accessibility_analysis;
 		cv::Mat inflated_map;
 		const int robot_radius_in_pixel = floor(data.robot_radius_ / data.map_resolution_);
 		map_accessibility_analysis.inflateMap(map, inflated_map, robot_radius_in_pixel);
 		interpolated_paths.resize(paths.size());
 
-		// draw paths
-		for(size_t room=0; room<paths.size(); ++room)
-		{
-			//std::cout << "room " << room << ", size of path: " << paths[room].size() << std::endl;
+		// compute the statistics of each room
+		std::vector<RoomPathStatistics> room_statistics(paths.size());
+		processRoomsInParallel(paths.size(), [&](const size_t room)
+			{ statisticsPathLengthCrossingsTurnsOfRoom(data, map, inflated_map, fov_circle_center_point_in_px, paths[room], room, room_statistics[room]); });
 
-			// check for false pose
-			if(paths[room].size()==0 || (paths[room][0].x==-1 && paths[room][0].y==-1))
-			{
-				std::cout << "room " << room << " has invalid trajectory." << std::endl;
+		// draw paths and collect the statistics in the order of the rooms, a segment between two consecutive poses counts as
+		// crossing if it visits a pixel that has already been visited by the path of this or a previous room
+		for (size_t room=0; room<paths.size(); ++room)
+		{
+			if (room_statistics[room].valid == false)
 				continue;
-			}
-			else
-				++nonzero_paths;
-
-			// initialize statistics
-			double current_pathlength = 0.0;
-			double current_rotation_abs = 0.0;
-			int current_number_of_rotations = 0, current_number_of_crossings = 0;
-
-			// initialize path
-			geometry_msgs::Pose2D current_pose_px;	// in [pixels]
-			size_t initial_pose_index = 0;
-			bool found_initial_pose = false;
-			for (; initial_pose_index<paths[room].size(); ++initial_pose_index)		// try different starting poses until one works
+			++nonzero_paths;
+			const std::vector<cv::Point>& path_pixels = room_statistics[room].path_pixels;
+			int current_number_of_crossings = 0;
+			size_t segment_begin = 0;
+			for (std::vector<size_t>::const_iterator segment_end=room_statistics[room].segment_ends.begin(); segment_end!=room_statistics[room].segment_ends.end(); ++segment_end)
 			{
-				// shift starting pose into accessible area
-				current_pose_px = paths[room][initial_pose_index];
-				if(current_pose_px.x==-1 && current_pose_px.y==-1)
-				{
-					ROS_WARN("ExplorationEvaluation:evaluateCoveragePaths: current_pose_px.x==-1 && current_pose_px.y==-1 --> this should never happen.");
-					continue;
-				}
-				found_initial_pose = findAccessiblePose(inflated_map, current_pose_px, current_pose_px, data, fov_circle_center_point_in_px, false);
-				if (found_initial_pose == true)
-					break;
-			}
-			if(found_initial_pose == false)
-			{
-				// if any starting pose works, use first pose for further computations to achieve proper error handling
-				ROS_WARN("ExplorationEvaluation:evaluateCoveragePaths: No starting position is accessible.");
-				current_pose_px = paths[room][0];
-				size_t initial_pose_index = 0;
-			}
-			geometry_msgs::Pose2D initial_pose_m;	// in [m]
-			initial_pose_m.x = (current_pose_px.x*data.map_resolution_)+data.map_origin_.position.x;
-			initial_pose_m.y = (current_pose_px.y*data.map_resolution_)+data.map_origin_.position.y;
-			initial_pose_m.theta = current_pose_px.theta;
-			std::vector<geometry_msgs::Pose2D> current_pose_path_meter;	// in [m,m,rad]
-			current_pose_path_meter.push_back(initial_pose_m);
-
-			// loop through trajectory points
-			for(std::vector<geometry_msgs::Pose2D>::const_iterator pose_px=paths[room].begin()+initial_pose_index+1; pose_px!=paths[room].end(); ++pose_px)
-			{
-				// if a false pose has been saved, skip it
-				if(current_pose_px.x==-1 && current_pose_px.y==-1)
-				{
-					ROS_WARN("ExplorationEvaluation:evaluateCoveragePaths: current_pose_px.x==-1 && current_pose_px.y==-1 --> this should never happen.");
-					continue;
-				}
-
-				// find an accessible next pose
-				geometry_msgs::Pose2D next_pose_px = *pose_px;
-				bool found_next = findAccessiblePose(inflated_map, current_pose_px, next_pose_px, data, fov_circle_center_point_in_px);
-				if(found_next==false)
-				{
-					std::cout << "   skipping next_pose_px=(" << next_pose_px.x << "," << next_pose_px.y << ") inaccessible from current_pose_px=(" << current_pose_px.x << "," << current_pose_px.y << ")" << std::endl;
-					continue;	// if no accessible position could be found, go to next possible path point
-				}
-
-				// find pathlength and path between two consecutive poses
-				std::vector<cv::Point> current_interpolated_path;	// vector that stores the current path from one pose to another
-				const cv::Point current_pose_px_pt(current_pose_px.x, current_pose_px.y);
-				const cv::Point next_pose_px_pt(next_pose_px.x, next_pose_px.y);
-				// first query for direct current_pose_px_pt to next_pose_px_pt connection
-				double length_planner = generateDirectConnection(inflated_map, current_pose_px_pt, next_pose_px_pt, current_interpolated_path);
-				if (length_planner < 0.)  // kind of a hack: if there is no accessible connection between two points, try to find a path on the original (not inflated) map, this path could possibly not be driven by the robot in reality
-					length_planner = generateDirectConnection(map, current_pose_px_pt, next_pose_px_pt, current_interpolated_path);
-				// use A* if there is no direct connection
-				if (length_planner < 0.)
-					length_planner = path_planner.planPath(inflated_map, current_pose_px_pt, next_pose_px_pt, 1.0, 0.0, data.map_resolution_, 0, &current_interpolated_path);
-				// kind of a hack: if there is no accessible connection between two points, try to find a path on the original (not inflated) map, this path could possibly not be driven by the robot in reality
-				if (current_interpolated_path.size()==0)
-					length_planner = path_planner.planPath(map, current_pose_px_pt, next_pose_px_pt, 1.0, 0.0, data.map_resolution_, 0, &current_interpolated_path);
-				current_pathlength += (length_planner>1e90 || length_planner<0 ? cv::norm(cv::Point(next_pose_px.x-current_pose_px.x, next_pose_px.y-current_pose_px.y)) : length_planner);
-
-				// if there is any proper connection between the two points, just use the goal point as "path"
-				if (current_interpolated_path.size()<2)
-				{
-					current_interpolated_path.push_back(cv::Point(current_pose_px.x, current_pose_px.y));
-					current_interpolated_path.push_back(cv::Point(next_pose_px.x, next_pose_px.y));
-				}
-
-				// transform the cv::Point path to geometry_msgs::Pose2D --> last point has, first point was already gone a defined angle
-				// also create output map to show path --> and check if one point has already been visited
 				bool has_crossing = false;
-				//cv::circle(path_map, cv::Point(next_pose_px.x, next_pose_px.y), 1, cv::Scalar(196), CV_FILLED);
-				for(std::vector<cv::Point>::iterator point=current_interpolated_path.begin()+1; point!=current_interpolated_path.end(); ++point)
+				for (size_t i=segment_begin; i<*segment_end; ++i)
 				{
-					// check if point has been visited before and draw point into map
-					if(path_map.at<uchar>(*point)==127)
+					// check if point has been visited before and mark point as visited
+					if(path_map.at<uchar>(path_pixels[i])==127)
 						has_crossing = true;
 					else
-						path_map.at<uchar>(*point)=127;
-
-					// transform to world coordinates
-					geometry_msgs::Pose2D current_pose;
-					current_pose.x = (point->x*data.map_resolution_)+data.map_origin_.position.x;
-					current_pose.y = (point->y*data.map_resolution_)+data.map_origin_.position.y;
-					current_pose.theta = 0;		// the angles are computed afterwards with some smoothing interpolation
-
-					// add the pose to the path
-					current_pose_path_meter.push_back(current_pose);
+						path_map.at<uchar>(path_pixels[i])=127;
 				}
 				if (has_crossing == true)
 					++current_number_of_crossings;
+				segment_begin = *segment_end;
+			}
+			number_of_crossings.push_back(current_number_of_crossings);
+			rotation_values.push_back(room_statistics[room].rotation_abs);
+			number_of_rotations.push_back(room_statistics[room].number_of_rotations);
+			interpolated_paths[room].swap(room_statistics[room].interpolated_path);
+			pathlengths_for_map.push_back(room_statistics[room].pathlength);
+		}
+	}
 
-				// set robot_position to new one
-				current_pose_px = next_pose_px;
+	// path length, turns and pixels of the path of one room, the crossings are counted from the pixels afterwards
+	void statisticsPathLengthCrossingsTurnsOfRoom(const ExplorationData& data, const cv::Mat& map, const cv::Mat& inflated_map, const cv::Point2d& fov_circle_center_point_in_px,
+			const std::vector<geometry_msgs::Pose2D>& path, const size_t room, RoomPathStatistics& statistics)
+	{
+		//std::cout << "room " << room << ", size of path: " << path.size() << std::endl;
+
+		// check for false pose
+		if(path.size()==0 || (path[0].x==-1 && path[0].y==-1))
+		{
+			std::cout << "room " << room << " has invalid trajectory." << std::endl;
+			return;
+		}
+		statistics.valid = true;
+
+		AStarPlanner path_planner;
+
+		// initialize path
+		geometry_msgs::Pose2D current_pose_px;	// in [pixels]
+		size_t initial_pose_index = 0;
+		bool found_initial_pose = false;
+		for (; initial_pose_index<path.size(); ++initial_pose_index)		// try different starting poses until one works
+		{
+			// shift starting pose into accessible area
+			current_pose_px = path[initial_pose_index];
+			if(current_pose_px.x==-1 && current_pose_px.y==-1)
+			{
+				ROS_WARN("ExplorationEvaluation:evaluateCoveragePaths: current_pose_px.x==-1 && current_pose_px.y==-1 --> this should never happen.");
+				continue;
+			}
+			found_initial_pose = findAccessiblePose(inflated_map, current_pose_px, current_pose_px, data, fov_circle_center_point_in_px, false);
+			if (found_initial_pose == true)
+				break;
+		}
+		if(found_initial_pose == false)
+		{
+			// if any starting pose works, use first pose for further computations to achieve proper error handling
+			ROS_WARN("ExplorationEvaluation:evaluateCoveragePaths: No starting position is accessible.");
+			current_pose_px = path[0];
+			initial_pose_index = 0;
+		}
+		geometry_msgs::Pose2D initial_pose_m;	// in [m]
+		initial_pose_m.x = (current_pose_px.x*data.map_resolution_)+data.map_origin_.position.x;
+		initial_pose_m.y = (current_pose_px.y*data.map_resolution_)+data.map_origin_.position.y;
+		initial_pose_m.theta = current_pose_px.theta;
+		std::vector<geometry_msgs::Pose2D>& current_pose_path_meter = statistics.interpolated_path;	// in [m,m,rad]
+		current_pose_path_meter.push_back(initial_pose_m);
+
+		// loop through trajectory points
+		double current_pathlength = 0.0;
+		for(std::vector<geometry_msgs::Pose2D>::const_iterator pose_px=path.begin()+initial_pose_index+1; pose_px!=path.end(); ++pose_px)
+		{
+			// if a false pose has been saved, skip it
+			if(current_pose_px.x==-1 && current_pose_px.y==-1)
+			{
+				ROS_WARN("ExplorationEvaluation:evaluateCoveragePaths: current_pose_px.x==-1 && current_pose_px.y==-1 --> this should never happen.");
+				continue;
 			}
 
-			// angles and turn: compute the angles along the pixel-wise path and add to the cumulative rotation
-			const int offset = 2;
-			for (size_t i=0; i<current_pose_path_meter.size(); ++i)
+			// find an accessible next pose
+			geometry_msgs::Pose2D next_pose_px = *pose_px;
+			bool found_next = findAccessiblePose(inflated_map, current_pose_px, next_pose_px, data, fov_circle_center_point_in_px);
+			if(found_next==false)
 			{
-				// compute angle as direction between point 2 steps previous and point 2 steps ahead in the current path
-				const geometry_msgs::Pose2D& pose_1 = current_pose_path_meter[std::max(int(i)-offset,0)];
-				const geometry_msgs::Pose2D& pose_2 = current_pose_path_meter[std::min(i+offset,current_pose_path_meter.size()-1)];
-				current_pose_path_meter[i].theta = std::atan2(pose_2.y-pose_1.y, pose_2.x-pose_1.x);
+				std::cout << "   skipping next_pose_px=(" << next_pose_px.x << "," << next_pose_px.y << ") inaccessible from current_pose_px=(" << current_pose_px.x << "," << current_pose_px.y << ")" << std::endl;
+				continue;	// if no accessible position could be found, go to next possible path point
+			}
 
-				// determine angle differences for the statistics
-				if (i>1)
-				{
-					double angle_difference = current_pose_path_meter[i].theta - current_pose_path_meter[i-1].theta;
-					angle_difference = std::abs(angles::normalize_angle(angle_difference));
-					current_rotation_abs += angle_difference;
-					if (angle_difference > 0.52)		// only count substantial rotations > 30deg
-						++current_number_of_rotations;
-				}
+			// find pathlength and path between two consecutive poses
+			std::vector<cv::Point> current_interpolated_path;	// vector that stores the current path from one pose to another
+			const cv::Point current_pose_px_pt(current_pose_px.x, current_pose_px.y);
+			const cv::Point next_pose_px_pt(next_pose_px.x, next_pose_px.y);
+			// first query for direct current_pose_px_pt to next_pose_px_pt connection
+			double length_planner = generateDirectConnection(inflated_map, current_pose_px_pt, next_pose_px_pt, current_interpolated_path);
+			if (length_planner < 0.)  // kind of a hack: if there is no accessible connection between two points, try to find a path on the original (not inflated) map, this path could possibly not be driven by the robot in reality
+				length_planner = generateDirectConnection(map, current_pose_px_pt, next_pose_px_pt, current_interpolated_path);
+			// use A* if there is no direct connection
+			if (length_planner < 0.)
+				length_planner = path_planner.planPath(inflated_map, current_pose_px_pt, next_pose_px_pt, 1.0, 0.0, data.map_resolution_, 0, &current_interpolated_path);
+			// kind of a hack: if there is no accessible connection between two points, try to find a path on the original (not inflated) map, this path could possibly not be driven by the robot in reality
+			if (current_interpolated_path.size()==0)
+				length_planner = path_planner.planPath(map, current_pose_px_pt, next_pose_px_pt, 1.0, 0.0, data.map_resolution_, 0, &current_interpolated_path);
+			current_pathlength += (length_planner>1e90 || length_planner<0 ? cv::norm(cv::Point(next_pose_px.x-current_pose_px.x, next_pose_px.y-current_pose_px.y)) : length_planner);
+
+			// if there is any proper connection between the two points, just use the goal point as "path"
+			if (current_interpolated_path.size()<2)
+			{
+				current_interpolated_path.push_back(cv::Point(current_pose_px.x, current_pose_px.y));
+				current_interpolated_path.push_back(cv::Point(next_pose_px.x, next_pose_px.y));
 			}
 
-			// save number of crossings of the path
-			number_of_crossings.push_back(current_number_of_crossings);
+			// transform the cv::Point path to geometry_msgs::Pose2D --> last point has, first point was already gone a defined angle
+			// also store the pixels for the path map and the crossings
+			for(std::vector<cv::Point>::iterator point=current_interpolated_path.begin()+1; point!=current_interpolated_path.end(); ++point)
+			{
+				statistics.path_pixels.push_back(*point);
 
-			// save rotation values
-			rotation_values.push_back(current_rotation_abs);
-			number_of_rotations.push_back(current_number_of_rotations);
+				// transform to world coordinates
+				geometry_msgs::Pose2D current_pose;
+				current_pose.x = (point->x*data.map_resolution_)+data.map_origin_.position.x;
+				current_pose.y = (point->y*data.map_resolution_)+data.map_origin_.position.y;
+				current_pose.theta = 0;		// the angles are computed afterwards with some smoothing interpolation
 
-			// save the interpolated path between
-			interpolated_paths[room]=current_pose_path_meter;
+				// add the pose to the path
+				current_pose_path_meter.push_back(current_pose);
+			}
+			statistics.segment_ends.push_back(statistics.path_pixels.size());
 
-			// transform the pixel length to meter
-			current_pathlength *= data.map_resolution_;
-			pathlengths_for_map.push_back(current_pathlength);
+			// set robot_position to new one
+			current_pose_px = next_pose_px;
 		}
+
+		// angles and turn: compute the angles along the pixel-wise path and add to the cumulative rotation
+		const int offset = 2;
+		for (size_t i=0; i<current_pose_path_meter.size(); ++i)
+		{
+			// compute angle as direction between point 2 steps previous and point 2 steps ahead in the current path
+			const geometry_msgs::Pose2D& pose_1 = current_pose_path_meter[std::max(int(i)-offset,0)];
+			const geometry_msgs::Pose2D& pose_2 = current_pose_path_meter[std::min(i+offset,current_pose_path_meter.size()-1)];
+			current_pose_path_meter[i].theta = std::atan2(pose_2.y-pose_1.y, pose_2.x-pose_1.x);
+
+			// determine angle differences for the statistics
+			if (i>1)
+			{
+				double angle_difference = current_pose_path_meter[i].theta - current_pose_path_meter[i-1].theta;
+				angle_difference = std::abs(angles::normalize_angle(angle_difference));
+				statistics.rotation_abs += angle_difference;
+				if (angle_difference > 0.52)		// only count substantial rotations > 30deg
+					++statistics.number_of_rotations;
+			}
+		}
+
+		// transform the pixel length to meter
+		statistics.pathlength = current_pathlength*data.map_resolution_;
 	}
 
+	// coverage statistics, the rooms are checked in parallel
 	void statisticsCoverageArea(const ExplorationData& data, const cv::Mat& map, const cv::Mat& path_map, cv::Mat& map_coverage, cv::Mat& map_path_coverage,
 			const std::vector<std::vector<geometry_msgs::Pose2D> >& paths, const std::vector<std::vector<geometry_msgs::Pose2D> >& interpolated_paths,
 			std::vector<double>& room_areas, std::vector<double>& area_covered_percentages, std::vector<double>& numbers_of_coverages)
 	{
 		map_coverage = map.clone();
-		for(size_t room=0; room<paths.size(); ++room)
+		boost::mutex map_coverage_mutex;	// protects map_coverage
+		std::vector<RoomCoverageStatistics> room_statistics(paths.size());
+		processRoomsInParallel(paths.size(), [&](const size_t room)
+			{ statisticsCoverageAreaOfRoom(data, paths[room], interpolated_paths[room], data.room_maps_[room], map_coverage, map_coverage_mutex, room_statistics[room]); });
+
+		// collect the statistics in the order of the rooms
+		for (size_t room=0; room<paths.size(); ++room)
 		{
-			// ignore paths with size 0 or wrong data
-			if(paths[room].size()==0 || (paths[room][0].x==-1 && paths[room][0].y==-1))
+			if (room_statistics[room].valid == false)
 				continue;
-
-			// map that has the covered areas drawn in
-			cv::Mat coverage_map, number_of_coverage_image;
-
-			// use the coverage check server to check which areas have been seen
-			//   --> convert path to cv format
-			std::vector<cv::Point3d> path;
-			for (size_t i=0; i<interpolated_paths[room].size(); ++i)
-				path.push_back(cv::Point3d(interpolated_paths[room][i].x, interpolated_paths[room][i].y, interpolated_paths[room][i].theta));
-			//   --> convert field of view to Eigen format
-			std::vector<Eigen::Matrix<float, 2, 1> > field_of_view;
-			for(size_t i = 0; i < data.fov_points_.size(); ++i)
-			{
-				Eigen::Matrix<float, 2, 1> current_vector;
-				current_vector << data.fov_points_[i].x, data.fov_points_[i].y;
-				field_of_view.push_back(current_vector);
-			}
-			//   --> convert field of view origin to Eigen format
-			Eigen::Matrix<float, 2, 1> fov_origin;
-			fov_origin << data.fov_origin_.x, data.fov_origin_.y;
-			//   --> call coverage checker
-			CoverageCheckServer coverage_checker;
-			if (coverage_checker.checkCoverage(data.room_maps_[room], data.map_resolution_, cv::Point2d(data.map_origin_.position.x, data.map_origin_.position.y),
-					path, field_of_view, fov_origin, data.coverage_radius_, (data.planning_mode_==FOOTPRINT), true, coverage_map, number_of_coverage_image) == true)
-			{
-				for (int v=0; v<coverage_map.rows; ++v)
-					for (int u=0; u<coverage_map.cols; ++u)
-						if (coverage_map.at<uchar>(v,u)==127)
-							map_coverage.at<uchar>(v,u)=208;
-			}
-			else
-			{
-				ROS_INFO("Error when calling the coverage check server.");
-			}
-
-			// service interface - can be deleted
-//			// use the coverage check server to check which areas have been seen
-//			ipa_building_msgs::CheckCoverageRequest coverage_request;
-//			ipa_building_msgs::CheckCoverageResponse coverage_response;
-//			// fill request
-//			std::string coverage_service_name = "/room_exploration/coverage_check_server/coverage_check";
-//		//	cv::Mat eroded_room_map;
-//		//	cv::erode(data.room_maps_[room], eroded_room_map, cv::Mat(), cv::Point(-1, -1), robot_radius_in_pixel);
-//			sensor_msgs::ImageConstPtr service_image;
-//			cv_bridge::CvImage cv_image;
-//			cv_image.encoding = "mono8";
-//			cv_image.image = data.room_maps_[room];	//eroded_room_map;
-//			service_image = cv_image.toImageMsg();
-//			coverage_request.map_resolution = data.map_resolution_;
-//			coverage_request.input_map = *service_image;
-//			coverage_request.map_origin = data.map_origin_;
-//			coverage_request.path = interpolated_paths[room];
-//			coverage_request.field_of_view = data.fov_points_;
-//			coverage_request.field_of_view_origin = data.fov_origin_;
-//			coverage_request.coverage_radius = data.coverage_radius_;
-//			if (data.planning_mode_ == FOOTPRINT)
-//				coverage_request.check_for_footprint = true;
-//			else if (data.planning_mode_ == FIELD_OF_VIEW)
-//				coverage_request.check_for_footprint = false;
-//			coverage_request.check_number_of_coverages = true;
-//			// send request
-//			if(ros::service::call(coverage_service_name, coverage_request, coverage_response)==true)
-//			{
-//				cv_bridge::CvImagePtr cv_ptr_obj;
-//				cv_ptr_obj = cv_bridge::toCvCopy(coverage_response.coverage_map, sensor_msgs::image_encodings::MONO8);
-//				coverage_map = cv_ptr_obj->image;
-//
-//				for (int v=0; v<coverage_map.rows; ++v)
-//					for (int u=0; u<coverage_map.cols; ++u)
-//						if (coverage_map.at<uchar>(v,u)==127)
-//							map_coverage.at<uchar>(v,u)=208;
-//
-//				cv_ptr_obj = cv_bridge::toCvCopy(coverage_response.number_of_coverage_image, sensor_msgs::image_encodings::TYPE_32SC1);
-//				number_of_coverages_image = cv_ptr_obj->image;
-//			}
-//			else
-//			{
-//				ROS_INFO("Error when calling the coverage check server.");
-//			}
-//				cv::imshow("seen", coverage_map);
-//				cv::waitKey();
-
-			// get the area of the whole room
-			const int white_room_pixels = cv::countNonZero(data.room_maps_[room]);
-			const double room_area = data.map_resolution_ * data.map_resolution_ * (double) white_room_pixels;
-			room_areas.push_back(room_area);
-
-			// get the covered area of the room
-			cv::threshold(coverage_map, coverage_map, 150, 255, cv::THRESH_BINARY); // covered area drawn in as 127 --> find still white pixels
-			const int not_covered_pixels = cv::countNonZero(coverage_map);
-			const double not_covered_area = data.map_resolution_ * data.map_resolution_ * (double) not_covered_pixels;
-
-			// get and save the percentage of coverage
-			double coverage_percentage = (room_area-not_covered_area)/room_area;
-			area_covered_percentages.push_back(coverage_percentage);
-
-			// check how often pixels have been covered
-			double average_coverage_number = 0.0, coverage_number_deviation = 0.0;
-			for(size_t u=0; u<number_of_coverage_image.rows; ++u)
-				for(size_t v=0; v<number_of_coverage_image.cols; ++v)
-					if(number_of_coverage_image.at<int>(u,v)!=0)
-						numbers_of_coverages.push_back(number_of_coverage_image.at<int>(u,v));
+			room_areas.push_back(room_statistics[room].room_area);
+			area_covered_percentages.push_back(room_statistics[room].covered_percentage);
+			numbers_of_coverages.insert(numbers_of_coverages.end(), room_statistics[room].numbers_of_coverages.begin(), room_statistics[room].numbers_of_coverages.end());
 		}
+
 		// create the map with the drawn in path and coverage areas
 		map_path_coverage = map.clone();
 		for (int v=0; v<path_map.rows; ++v)
@@ -1297,139 +1388,213 @@ public:
 		}
 	}
 
-	void statisticsParallelism(const ExplorationData& data, const cv::Mat& map, const cv::Mat& path_map,
+	// coverage statistics of one room, the covered area is drawn into map_coverage
+	void statisticsCoverageAreaOfRoom(const ExplorationData& data, const std::vector<geometry_msgs::Pose2D>& room_path,
+			const std::vector<geometry_msgs::Pose2D>& interpolated_path, const cv::Mat& room_map, cv::Mat& map_coverage, boost::mutex& map_coverage_mutex,
+			RoomCoverageStatistics& statistics)
+	{
+		// ignore paths with size 0 or wrong data
+		if(room_path.size()==0 || (room_path[0].x==-1 && room_path[0].y==-1))
+			return;
+		statistics.valid = true;
+
+		// map that has the covered areas drawn in
+		cv::Mat coverage_map, number_of_coverage_image;
+
+		// use the coverage check server to check which areas have been seen
+		//   --> convert path to cv format
+		std::vector<cv::Point3d> path;
+		for (size_t i=0; i<interpolated_path.size(); ++i)
+			path.push_back(cv::Point3d(interpolated_path[i].x, interpolated_path[i].y, interpolated_path[i].theta));
+		//   --> convert field of view to Eigen format
+		std::vector<Eigen::Matrix<float, 2, 1> > field_of_view;
+		for(size_t i = 0; i < data.fov_points_.size(); ++i)
+		{
+			Eigen::Matrix<float, 2, 1> current_vector;
+			current_vector << data.fov_points_[i].x, data.fov_points_[i].y;
+			field_of_view.push_back(current_vector);
+		}
+		//   --> convert field of view origin to Eigen format
+		Eigen::Matrix<float, 2, 1> fov_origin;
+		fov_origin << data.fov_origin_.x, data.fov_origin_.y;
+		//   --> call coverage checker
+		CoverageCheckServer coverage_checker;
+		if (coverage_checker.checkCoverage(room_map, data.map_resolution_, cv::Point2d(data.map_origin_.position.x, data.map_origin_.position.y),
+				path, field_of_view, fov_origin, data.coverage_radius_, (data.planning_mode_==FOOTPRINT), true, coverage_map, number_of_coverage_image) == true)
+		{
+			boost::mutex::scoped_lock lock(map_coverage_mutex);
+			for (int v=0; v<coverage_map.rows; ++v)
+				for (int u=0; u<coverage_map.cols; ++u)
+					if (coverage_map.at<uchar>(v,u)==127)
+						map_coverage.at<uchar>(v,u)=208;
+		}
+		else
+		{
+			ROS_INFO("Error when calling the coverage check server.");
+		}
+
+		// get the area of the whole room
+		const int white_room_pixels = cv::countNonZero(room_map);
+		statistics.room_area = data.map_resolution_ * data.map_resolution_ * (double) white_room_pixels;
+
+		// get the covered area of the room
+		cv::threshold(coverage_map, coverage_map, 150, 255, cv::THRESH_BINARY); // covered area drawn in as 127 --> find still white pixels
+		const int not_covered_pixels = cv::countNonZero(coverage_map);
+		const double not_covered_area = data.map_resolution_ * data.map_resolution_ * (double) not_covered_pixels;
+
+		// get and save the percentage of coverage
+		statistics.covered_percentage = (statistics.room_area-not_covered_area)/statistics.room_area;
+
+		// check how often pixels have been covered
+		for(int u=0; u<number_of_coverage_image.rows; ++u)
+			for(int v=0; v<number_of_coverage_image.cols; ++v)
+				if(number_of_coverage_image.at<int>(u,v)!=0)
+					statistics.numbers_of_coverages.push_back(number_of_coverage_image.at<int>(u,v));
+	}
+
+	// parallelism statistics, gradient_map is the output of computeGradientMap(map) and shared by all configurations of the map, the rooms are processed in parallel
+	void statisticsParallelism(const ExplorationData& data, const cv::Mat& map, const cv::Mat& path_map, const cv::Mat& gradient_map,
 			const std::vector<std::vector<geometry_msgs::Pose2D> >& paths, const std::vector<std::vector<geometry_msgs::Pose2D> >& interpolated_paths,
 			const double grid_spacing_in_pixel,
 			std::vector<double>& wall_angle_score_means, std::vector<double>& trajectory_angle_score_means, std::vector<double>& revisit_time_means)
 	{
-		// compute the direction of the gradient for each pixel and save the occurring gradients
-		cv::Mat gradient_map = computeGradientMap(map);
-
 		const double trajectory_parallelism_check_range = 2.0*grid_spacing_in_pixel;	//1.0/data.map_resolution_; // valid check-radius when checking for the parallelism to another part of the trajectory, [pixels]
+		std::vector<RoomParallelismStatistics> room_statistics(paths.size());
+		processRoomsInParallel(paths.size(), [&](const size_t room)
+			{ statisticsParallelismOfRoom(data, map, path_map, gradient_map, paths[room], interpolated_paths[room], trajectory_parallelism_check_range, room_statistics[room]); });
+
+		// collect the statistics in the order of the rooms
 		for (size_t room=0; room<paths.size(); ++room)
 		{
-			if (paths[room].size()==0 || (paths[room][0].x==-1 && paths[room][0].y==-1))
+			if (room_statistics[room].valid == false)
 				continue;
+			wall_angle_score_means.push_back(room_statistics[room].wall_angle_score_mean);
+			trajectory_angle_score_means.push_back(room_statistics[room].trajectory_angle_score_mean);
+			revisit_time_means.push_back(room_statistics[room].revisit_time_mean);
+		}
+	}
 
-			std::vector<double> current_wall_angle_scores, current_trajectory_angle_scores;		// values in [0,1], high values are good
-			std::vector<double> current_revisit_times;		// values in [0,1], low values are good
-			for (std::vector<geometry_msgs::Pose2D>::const_iterator pose=paths[room].begin(); pose!=paths[room].end()-1; ++pose)
+	// parallelism of the path of one room to the walls and to the other parts of the path
+	void statisticsParallelismOfRoom(const ExplorationData& data, const cv::Mat& map, const cv::Mat& path_map, const cv::Mat& gradient_map,
+			const std::vector<geometry_msgs::Pose2D>& path, const std::vector<geometry_msgs::Pose2D>& interpolated_path,
+			const double trajectory_parallelism_check_range, RoomParallelismStatistics& statistics)
+	{
+		if (path.size()==0 || (path[0].x==-1 && path[0].y==-1))
+			return;
+		statistics.valid = true;
+
+		// index of the interpolated path to find the path pose at a hit trajectory pixel
+		const PathPoseGridIndex interpolated_path_index(interpolated_path, data.map_resolution_, cv::Point2d(data.map_origin_.position.x, data.map_origin_.position.y));
+
+		std::vector<double> current_wall_angle_scores, current_trajectory_angle_scores;		// values in [0,1], high values are good
+		std::vector<double> current_revisit_times;		// values in [0,1], low values are good
+		for (std::vector<geometry_msgs::Pose2D>::const_iterator pose=path.begin(); pose!=path.end()-1; ++pose)
+		{
+			double dx = (pose+1)->x - pose->x;
+			double dy = (pose+1)->y - pose->y;
+			double norm = std::sqrt(dy*dy + dx*dx);
+			if(norm==0)
+				continue;	// skip if the point and its successor are the same
+			dx = dx/norm;
+			dy = dy/norm;
+
+			// go in the directions of both normals and find the nearest wall
+			bool hit_wall = false, hit_trajectory = false, exceeded_trajectory_parallelism_check_range = false;
+			bool n1_ok = true, n2_ok = true;
+			cv::Point2f n1(pose->x, pose->y), n2(pose->x, pose->y);
+			cv::Point wall_pixel, trajectory_pixel;
+			do
 			{
-				double dx = (pose+1)->x - pose->x;
-				double dy = (pose+1)->y - pose->y;
-				double norm = std::sqrt(dy*dy + dx*dx);
-				if(norm==0)
-					continue;	// skip if the point and its successor are the same
-				dx = dx/norm;
-				dy = dy/norm;
-
-				// go in the directions of both normals and find the nearest wall
-				bool hit_wall = false, hit_trajectory = false, exceeded_trajectory_parallelism_check_range = false;
-				bool n1_ok = true, n2_ok = true;
-				cv::Point2f n1(pose->x, pose->y), n2(pose->x, pose->y);
-				cv::Point wall_pixel, trajectory_pixel;
-				do
+				// update normals
+				n1.x -= dy;
+				n1.y += dx;
+				n2.x += dy;
+				n2.y -= dx;
+
+				// test for coordinates inside image
+				if (n1.x<0.f || n1.y<0.f || (int)n1.x >= map.cols || (int)n1.y >= map.rows)
+					n1_ok = false;
+				if (n2.x<0.f || n2.y<0.f || (int)n2.x >= map.cols || (int)n2.y >= map.rows)
+					n2_ok = false;
+
+				// test if a wall/obstacle has been hit
+				if (hit_wall==false && n1_ok==true && map.at<uchar>(n1)==0)
 				{
-					// update normals
-					n1.x -= dy;
-					n1.y += dx;
-					n2.x += dy;
-					n2.y -= dx;
-
-					// test for coordinates inside image
-					if (n1.x<0.f || n1.y<0.f || (int)n1.x >= map.cols || (int)n1.y >= map.rows)
-						n1_ok = false;
-					if (n2.x<0.f || n2.y<0.f || (int)n2.x >= map.cols || (int)n2.y >= map.rows)
-						n2_ok = false;
-
-					// test if a wall/obstacle has been hit
-					if (hit_wall==false && n1_ok==true && map.at<uchar>(n1)==0)
+					hit_wall = true;
+					n1_ok = false;		// do not further search with direction that has found a wall
+					wall_pixel = n1;
+				}
+				else if (hit_wall==false && n2_ok==true && map.at<uchar>(n2)==0)
+				{
+					hit_wall = true;
+					n2_ok = false;		// do not further search with direction that has found a wall
+					wall_pixel = n2;
+				}
+
+				// only search for the parallelism to another trajectory if the range hasn't been exceeded yet
+				if (exceeded_trajectory_parallelism_check_range==false && hit_trajectory==false)
+				{
+					// test if another trajectory part has been hit, if the check-radius is still satisfied
+					const double dist1 = cv::norm(n1-cv::Point2f(pose->x, pose->y));
+					const double dist2 = cv::norm(n2-cv::Point2f(pose->x, pose->y));
+
+					if (n1_ok==true && dist1<=trajectory_parallelism_check_range && path_map.at<uchar>(n1)==127)
 					{
-						hit_wall = true;
-						n1_ok = false;		// do not further search with direction that has found a wall
-						wall_pixel = n1;
+						hit_trajectory = true;
+						trajectory_pixel = n1;
 					}
-					else if (hit_wall==false && n2_ok==true && map.at<uchar>(n2)==0)
+					else if (n2_ok==true && dist2<=trajectory_parallelism_check_range && path_map.at<uchar>(n2)==127)
 					{
-						hit_wall = true;
-						n2_ok = false;		// do not further search with direction that has found a wall
-						wall_pixel = n2;
+						hit_trajectory = true;
+						trajectory_pixel = n2;
 					}
 
-					// only search for the parallelism to another trajectory if the range hasn't been exceeded yet
-					if (exceeded_trajectory_parallelism_check_range==false && hit_trajectory==false)
-					{
-						// test if another trajectory part has been hit, if the check-radius is still satisfied
-						const double dist1 = cv::norm(n1-cv::Point2f(pose->x, pose->y));
-						const double dist2 = cv::norm(n2-cv::Point2f(pose->x, pose->y));
-
-						if (n1_ok==true && dist1<=trajectory_parallelism_check_range && path_map.at<uchar>(n1)==127)
-						{
-							hit_trajectory = true;
-							trajectory_pixel = n1;
-						}
-						else if (n2_ok==true && dist2<=trajectory_parallelism_check_range && path_map.at<uchar>(n2)==127)
-						{
-							hit_trajectory = true;
-							trajectory_pixel = n2;
-						}
-
-						// if both distances exceed the valid check range, mark as finished
-						if (dist1>trajectory_parallelism_check_range && dist2>trajectory_parallelism_check_range)
-							exceeded_trajectory_parallelism_check_range = true;
-					}
+					// if both distances exceed the valid check range, mark as finished
+					if (dist1>trajectory_parallelism_check_range && dist2>trajectory_parallelism_check_range)
+						exceeded_trajectory_parallelism_check_range = true;
+				}
+			} while ((n1_ok || n2_ok) && ((hit_wall==false) || (hit_trajectory==false && exceeded_trajectory_parallelism_check_range==false)));
 
-//					cv::Mat test_map = map.clone();
-//					cv::circle(test_map, cv::Point(pose->x, pose->y), 2, cv::Scalar(127), CV_FILLED);
-//					cv::circle(test_map, cv::Point((pose+1)->x, (pose+1)->y), 2, cv::Scalar(127), CV_FILLED);
-//					cv::circle(test_map, n1, 2, cv::Scalar(127), CV_FILLED);
-//					cv::circle(test_map, n2, 2, cv::Scalar(127), CV_FILLED);
-//					cv::imshow("normals", test_map);
-//					cv::waitKey();
-				} while ((n1_ok || n2_ok) && ((hit_wall==false) || (hit_trajectory==false && exceeded_trajectory_parallelism_check_range==false)));
+			// if a wall/obstacle was found, determine the gradient at this position and compare it to the direction of the path
+			if (hit_wall==true)
+			{
+				cv::Vec2d gradient = gradient_map.at<cv::Vec2d>(wall_pixel);
+				cv::Point2f normal_vector(-gradient.val[1], gradient.val[0]);
+				const double normal_norm = cv::norm(normal_vector);
+				normal_vector *= (float)(normal_norm!=0. ? 1./normal_norm : 1.);
+				const double delta_theta = std::acos(normal_vector.x*dx + normal_vector.y*dy);
+				const double delta_theta_score = std::abs(0.5*PI-delta_theta)*(1./(0.5*PI));// parallel if delta_theta close to 0 or PI
+				current_wall_angle_scores.push_back(delta_theta_score);
+			}
 
-				// if a wall/obstacle was found, determine the gradient at this position and compare it to the direction of the path
-				if (hit_wall==true)
+			// if another trajectory part could be found, determine the parallelism to it
+			if (hit_trajectory==true)
+			{
+				// find the trajectory point in the interpolated path
+				cv::Point2f trajectory_point_m((trajectory_pixel.x*data.map_resolution_)+data.map_origin_.position.x, (trajectory_pixel.y*data.map_resolution_)+data.map_origin_.position.y); // transform in world coordinates
+				int pose_index = pose-path.begin();
+				int neighbor_index = interpolated_path_index.findLastPoseNear(trajectory_point_m, 0.5*data.map_resolution_);
+				if (neighbor_index == -1)
 				{
-					cv::Vec2d gradient = gradient_map.at<cv::Vec2d>(wall_pixel);
-					cv::Point2f normal_vector(-gradient.val[1], gradient.val[0]);
-					const double normal_norm = cv::norm(normal_vector);
-					normal_vector *= (float)(normal_norm!=0. ? 1./normal_norm : 1.);
-					const double delta_theta = std::acos(normal_vector.x*dx + normal_vector.y*dy);
-					const double delta_theta_score = std::abs(0.5*PI-delta_theta)*(1./(0.5*PI));// parallel if delta_theta close to 0 or PI
-					current_wall_angle_scores.push_back(delta_theta_score);
+					ROS_WARN("ExplorationEvaluation:evaluateCoveragePaths: parallelism check to trajectory, neighbor_index==-1 --> did not find the neighbor for trajectory point (%f,%f)m.", trajectory_point_m.x, trajectory_point_m.y);
+					continue;
 				}
 
-				// if another trajectory part could be found, determine the parallelism to it
-				if (hit_trajectory==true)
-				{
-					// find the trajectory point in the interpolated path
-					cv::Point2f trajectory_point_m((trajectory_pixel.x*data.map_resolution_)+data.map_origin_.position.x, (trajectory_pixel.y*data.map_resolution_)+data.map_origin_.position.y); // transform in world coordinates
-					int pose_index = pose-paths[room].begin();
-					int neighbor_index = -1;
-					for (std::vector<geometry_msgs::Pose2D>::const_iterator neighbor=interpolated_paths[room].begin(); neighbor!=interpolated_paths[room].end(); ++neighbor)
-						if (cv::norm(trajectory_point_m-cv::Point2f(neighbor->x,neighbor->y)) < 0.5*data.map_resolution_)
-							neighbor_index = neighbor-interpolated_paths[room].begin();
-					if (neighbor_index == -1)
-						ROS_WARN("ExplorationEvaluation:evaluateCoveragePaths: parallelism check to trajectory, neighbor_index==-1 --> did not find the neighbor for trajectory point (%f,%f)m.", trajectory_point_m.x, trajectory_point_m.y);
-//						std::cout << "index: " << pose_index << ", n: " << neighbor_index << std::endl;
-
-					// save the found index difference, i.e. the difference in percentage of path completion between current node and neighboring path point
-					current_revisit_times.push_back(std::abs((double)pose_index/(double)paths[room].size() - (double)neighbor_index/(double)interpolated_paths[room].size()));
-
-					// calculate the trajectory direction at the neighbor to get the difference
-					const double n_dx = cos(interpolated_paths[room][neighbor_index].theta);
-					const double n_dy = sin(interpolated_paths[room][neighbor_index].theta);
-					const double delta_theta = std::acos(n_dx*dx + n_dy*dy);	// acos delivers in range [0,Pi]
-					const double delta_theta_score = std::abs(0.5*PI-delta_theta)*(1./(0.5*PI));// parallel if delta_theta close to 0 or PI
-					current_trajectory_angle_scores.push_back(delta_theta_score);
-				}
+				// save the found index difference, i.e. the difference in percentage of path completion between current node and neighboring path point
+				current_revisit_times.push_back(std::abs((double)pose_index/(double)path.size() - (double)neighbor_index/(double)interpolated_path.size()));
+
+				// calculate the trajectory direction at the neighbor to get the difference
+				const double n_dx = cos(interpolated_path[neighbor_index].theta);
+				const double n_dy = sin(interpolated_path[neighbor_index].theta);
+				const double delta_theta = std::acos(n_dx*dx + n_dy*dy);	// acos delivers in range [0,Pi]
+				const double delta_theta_score = std::abs(0.5*PI-delta_theta)*(1./(0.5*PI));// parallel if delta_theta close to 0 or PI
+				current_trajectory_angle_scores.push_back(delta_theta_score);
 			}
-			// save found values
-			wall_angle_score_means.push_back(std::accumulate(current_wall_angle_scores.begin(), current_wall_angle_scores.end(), 0.0) / std::max(1.0, (double)current_wall_angle_scores.size()));
-			trajectory_angle_score_means.push_back(std::accumulate(current_trajectory_angle_scores.begin(), current_trajectory_angle_scores.end(), 0.0) / std::max(1.0, (double)current_trajectory_angle_scores.size()));
-			revisit_time_means.push_back(std::accumulate(current_revisit_times.begin(), current_revisit_times.end(), 0.0) / std::max(1.0, (double)current_revisit_times.size()));
 		}
+		// save found values
+		statistics.wall_angle_score_mean = std::accumulate(current_wall_angle_scores.begin(), current_wall_angle_scores.end(), 0.0) / std::max(1.0, (double)current_wall_angle_scores.size());
+		statistics.trajectory_angle_score_mean = std::accumulate(current_trajectory_angle_scores.begin(), current_trajectory_angle_scores.end(), 0.0) / std::max(1.0, (double)current_trajectory_angle_scores.size());
+		statistics.revisit_time_mean = std::accumulate(current_revisit_times.begin(), current_revisit_times.end(), 0.0) / std::max(1.0, (double)current_revisit_times.size());
 	}
 
 	bool findAccessiblePose(const cv::Mat& inflated_map, const geometry_msgs::Pose2D& current_pose_px, geometry_msgs::Pose2D& target_pose_px, const ExplorationData& data,
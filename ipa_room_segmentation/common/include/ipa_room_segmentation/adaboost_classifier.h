@@ -13,6 +13,7 @@
 
 #include <ipa_room_segmentation/features.h>
 #include <ipa_room_segmentation/raycasting.h>
+#include <ipa_room_segmentation/cv_boost_loader.h>
 
 class AdaboostClassifier
 {
@@ -24,13 +25,19 @@ protected:
 
 #if CV_MAJOR_VERSION == 2
 	CvBoostParams params_; // Parameters for the classifiers
-	CvBoost hallway_boost_, room_boost_; // the AdaBoost-classifiers for rooms and hallways
-#else
-	cv::Ptr<cv::ml::Boost> hallway_boost_, room_boost_; // the AdaBoost-classifiers for rooms and hallways
 #endif
+	BoostPtr hallway_boost_, room_boost_; // the AdaBoost-classifiers for rooms and hallways, loaded classifiers are shared read-only with other instances
 
 	LaserScannerRaycasting raycasting_;
 
+	//labels the pixels of map with mask!=0 as room (150) or hallway (100) and writes the confidence of each decision into
+	//confidences (CV_32FC1 of the size of map), which is the difference of the room and hallway probabilities
+	void classifyPoints(cv::Mat& map, const cv::Mat& mask, cv::Mat& confidences);
+
+	//finds watershed seeds in the white area of region_mask deterministically: in each cell of a grid with the given cell_size
+	//[pixel] the maximum of the distance transform is taken as seed if none of the maxima of the neighboring cells is larger
+	void findWatershedSeeds(const cv::Mat& region_mask, const int cell_size, std::vector<cv::Point>& seeds) const;
+
 public:
 
 
@@ -43,7 +50,12 @@ public:
 
 
 	//labeling-algorithm after the training
+	//prediction_grid_step > 1 classifies only the free pixels of a grid with this step [pixel] and takes over their label
+	//for the pixels in between, pixels between grid points with different labels or a confidence below
+	//min_prediction_confidence are classified themselves
+	//deterministic_watershed_seeding splits too large hallways with seeds from findWatershedSeeds() instead of random points
 	void segmentMap(const cv::Mat& map_to_be_labeled, cv::Mat& segmented_map, double map_resolution_from_subscription,
 			double room_area_factor_lower_limit, double room_area_factor_upper_limit,
-			const std::string& classifier_storage_path, const std::string& classifier_default_path, bool display_results=false);
+			const std::string& classifier_storage_path, const std::string& classifier_default_path, bool display_results=false,
+			const int prediction_grid_step=1, const double min_prediction_confidence=0.2, const bool deterministic_watershed_seeding=true);
 };
@@ -1,8 +1,21 @@
 #pragma once
 #include <opencv2/opencv.hpp>
+#include <string>
 
 #if CV_MAJOR_VERSION == 2
-void loadBoost(CvBoost& boost, std::string const& filename);
+typedef cv::Ptr<CvBoost> BoostPtr;
 #else
-void loadBoost(cv::Ptr<cv::ml::Boost> boost, std::string const& filename);
+typedef cv::Ptr<cv::ml::Boost> BoostPtr;
 #endif
+
+// creates a new, untrained AdaBoost classifier
+BoostPtr createBoost();
+
+// loads the AdaBoost classifier stored in filename into a new object, returns an empty pointer if the file does not contain
+// a trained classifier
+BoostPtr loadBoost(std::string const& filename);
+
+// returns a handle to the AdaBoost classifier stored in filename that is shared between all callers of this function. The file
+// is only read and validated on the first request or after its modification time or size changed, so repeated calls do
+// not cause any model I/O. The returned classifier must only be used for prediction. Returns an empty pointer on failure.
+BoostPtr loadSharedBoost(std::string const& filename);
@@ -15,6 +15,9 @@ public:
 	//function for calculating the feature
 	double get_feature(const std::vector<double>& beams, const std::vector<double>& angles, cv::Point point, int feature);
 	void get_features(const std::vector<double>& beams, const std::vector<double>& angles, cv::Point point, cv::Mat& features);
+	//computes all features for a batch of locations at once, beams contains the beams of one location per row (CV_64FC1) and
+	//features receives the features of one location per row (CV_32FC1), which can directly be passed to the classifiers
+	void get_features(const cv::Mat& beams, const std::vector<double>& angles, const std::vector<cv::Point>& points, cv::Mat& features);
 	//feature 1: average difference between beamlenghts
 	double calc_feature1(const std::vector<double>& beams);
 	//feature 2: standard deviation of difference between beamlengths
@@ -69,6 +72,10 @@ public:
 
 private:
 
+	//computes all features of one location in two fused passes over its beams, the results equal those of calc_feature1..23
+	void calc_features(const double* beams, const int beam_count, const std::vector<double>& angles, const std::vector<double>& cos_angles,
+			const std::vector<double>& sin_angles, cv::Point location, std::vector<cv::Point>& polygon, float* features) const;
+
 	std::vector<double> features_;
 	std::vector<bool> features_computed_;
 
@@ -0,0 +1,95 @@
+/*!
+ *****************************************************************
+ * \file
+ *
+ * \note
+ * Copyright (c) 2026 \n
+ * Fraunhofer Institute for Manufacturing Engineering
+ * and Automation (IPA) \n\n
+ *
+ *****************************************************************
+ *
+ * \note
+ * Project name: Care-O-bot
+ * \note
+ * ROS stack name: autopnp
+ * \note
+ * ROS package name: ipa_room_segmentation
+ *
+ * \brief
+ *
+ *
+ *****************************************************************
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer. \n
+ * - Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution. \n
+ * - Neither the name of the Fraunhofer Institute for Manufacturing
+ * Engineering and Automation (IPA) nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission. \n
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************/
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+// Component tree (max-tree) of a grayscale image: every node is a connected component (8-neighborhood) of the pixels with
+// a value >= some threshold. The node of a component stores the highest threshold at which it exists as its level, its
+// parent is the component that contains it at the next lower threshold. The tree is built once with union-find in
+// O(N log N) after a counting sort of the pixels, so the components and areas of all thresholds can be read from it
+// instead of thresholding the image and finding the contours at every level.
+class MaxTree
+{
+public:
+
+	struct Node
+	{
+		int parent;			// index of the parent node, -1 for the roots
+		int level;			// the node is the component of the pixels >= level for the thresholds in (level of the parent, level]
+		double area;		// area of the component in [pixel^2], equal to cv::contourArea() of its outer contour minus its hole contours
+		cv::Rect bounding_box;	// bounding box of the pixels of the component
+	};
+
+	MaxTree();
+
+	// builds the tree of the given image (CV_8UC1), pixels with value 0 and, like in cv::findContours(), the pixels at the
+	// image border do not belong to any component
+	void build(const cv::Mat& image);
+
+	// nodes of the tree, every node has a smaller index than its parent
+	const std::vector<Node>& getNodes() const;
+
+	// node of each pixel (CV_32SC1), i.e. the component with the pixel at the level of the pixel, -1 for pixels without component
+	const cv::Mat& getPixelNodes() const;
+
+	// returns the node of the component that contains the given pixel at the given threshold, i.e. the component of the
+	// pixels >= level, or -1 if the pixel is not part of such a component
+	int getComponent(const cv::Point& pixel, const int level) const;
+
+protected:
+
+	std::vector<Node> nodes_;
+
+	cv::Mat pixel_nodes_;
+};
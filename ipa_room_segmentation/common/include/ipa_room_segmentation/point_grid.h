@@ -0,0 +1,125 @@
+/*!
+ *****************************************************************
+ * \file
+ *
+ * \note
+ * Copyright (c) 2026 \n
+ * Fraunhofer Institute for Manufacturing Engineering
+ * and Automation (IPA) \n\n
+ *
+ *****************************************************************
+ *
+ * \note
+ * Project name: Care-O-bot
+ * \note
+ * ROS stack name: autopnp
+ * \note
+ * ROS package name: ipa_room_segmentation
+ *
+ * \brief
+ *
+ *
+ *****************************************************************
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer. \n
+ * - Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution. \n
+ * - Neither the name of the Fraunhofer Institute for Manufacturing
+ * Engineering and Automation (IPA) nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission. \n
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************/
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+// Spatial index for a set of pixel positions: the points are sorted into the square cells of a uniform grid over their bounding
+// box, so nearest neighbor and radius queries only look at the points in the cells close to the query position. Queries
+// return the indices of the points in the given vector, points of the same distance are reported in the order of their index.
+class PointGrid
+{
+public:
+
+	PointGrid(const std::vector<cv::Point>& points, const int cell_size);
+
+	// writes the indices of all points with a (Euclidean) distance < radius to center into indices, in increasing order
+	void getPointsInRadius(const cv::Point& center, const double radius, std::vector<int>& indices) const;
+
+	// returns the index of the point closest to center among the points for which is_candidate(index, squared_distance)
+	// returns true, the lowest index if several candidates have the same distance, or -1 if there is no candidate
+	template <typename Predicate>
+	int getNearestPoint(const cv::Point& center, const Predicate& is_candidate) const
+	{
+		int nearest_point = -1;
+		int min_squared_distance = 0;
+		const int center_cell_x = getCellCoordinate(center.x - origin_.x);
+		const int center_cell_y = getCellCoordinate(center.y - origin_.y);
+		const int max_ring = std::max(std::max(center_cell_x, grid_width_-1-center_cell_x), std::max(center_cell_y, grid_height_-1-center_cell_y));
+		// search the rings of cells around the cell of center, the points of ring r+1 are more than r*cell_size away from center
+		for (int ring = 0; ring <= max_ring; ++ring)
+		{
+			for (int cell_y = std::max(0, center_cell_y-ring); cell_y <= std::min(grid_height_-1, center_cell_y+ring); ++cell_y)
+			{
+				const bool border_row = (cell_y == center_cell_y-ring || cell_y == center_cell_y+ring);
+				for (int cell_x = std::max(0, center_cell_x-ring); cell_x <= std::min(grid_width_-1, center_cell_x+ring); ++cell_x)
+				{
+					if (border_row == false && cell_x != center_cell_x-ring && cell_x != center_cell_x+ring)
+						continue;
+					const int cell = cell_y*grid_width_ + cell_x;
+					for (int i = cell_starts_[cell]; i < cell_starts_[cell+1]; ++i)
+					{
+						const int index = cell_points_[i];
+						const int dx = points_[index].x - center.x;
+						const int dy = points_[index].y - center.y;
+						const int squared_distance = dx*dx + dy*dy;
+						if ((nearest_point == -1 || squared_distance < min_squared_distance || (squared_distance == min_squared_distance && index < nearest_point))
+								&& is_candidate(index, squared_distance) == true)
+						{
+							nearest_point = index;
+							min_squared_distance = squared_distance;
+						}
+					}
+				}
+			}
+			if (nearest_point != -1 && min_squared_distance <= ring*cell_size_*ring*cell_size_)
+				break;
+		}
+		return nearest_point;
+	}
+
+protected:
+
+	// cell coordinate of the given offset from the origin, rounded down for negative offsets
+	int getCellCoordinate(const int offset) const;
+
+	std::vector<cv::Point> points_;
+
+	int cell_size_;			// side length of the cells, in [pixel]
+	cv::Point origin_;		// top left corner of the grid
+	int grid_width_;		// number of cells in x-direction
+	int grid_height_;		// number of cells in y-direction
+
+	std::vector<int> cell_starts_;	// the indices of the points in cell c are cell_points_[cell_starts_[c]] to cell_points_[cell_starts_[c+1]-1]
+	std::vector<int> cell_points_;	// point indices sorted by cell and index
+};
@@ -5,6 +5,7 @@
 #include <opencv2/ml/ml.hpp>
 #include <iostream>
 #include <list>
+#include <algorithm>
 #include <vector>
 
 #define PI 3.14159265
@@ -20,8 +21,44 @@ public:
 	//raycasting function based on the bresenham algorithm
 	void bresenham_raycasting(const cv::Mat& map, const cv::Point& location, std::vector<double>& distances);
 
+	//prepares the directional distance maps of the given map for bands of band_rows rows: for each of the 360 beam directions
+	//one line sweep over the map stores the distances to the next obstacle in the rows next to the borders of the bands,
+	//so that the maps of each band can be computed from the rows of the band only
+	void computeDirectionalDistanceMapBorders(const cv::Mat& map, const int band_rows);
+
+	//precomputes the directional distance maps used by directional_raycasting() for the band [min_row, max_row) of the map
+	//that was given to computeDirectionalDistanceMapBorders(): for each of the 360 beam directions the distance of every pixel
+	//to the next obstacle in this direction is computed with one line sweep over the rows of the band
+	void computeDirectionalDistanceMaps(const cv::Mat& map, const int min_row, const int max_row);
+
+	//returns the number of map rows for which the directional distance maps can be computed at once with limited memory
+	int getDirectionalDistanceMapsRows(const cv::Mat& map) const;
+
+	//raycasting function that reads the beams at the given free location from the maps of computeDirectionalDistanceMaps()
+	//with one lookup per beam, the beams follow digital lines and may thus differ from raycasting() where they graze an obstacle
+	void directional_raycasting(const cv::Point& location, std::vector<double>& distances) const;
+
 private:
 
+	//computes the number of steps from each pixel in the rows [first_row, last_row) of the original map to the next obstacle
+	//along the digital lines that move one row in the given direction (+1/-1) and slope*direction columns per step, 0 marks
+	//rays that leave the map, rays that leave these rows continue with the steps of the rows first_row-1 and last_row given by
+	//previous_row_steps and next_row_steps, if steps is not empty the steps are written to it and the steps of the rows in
+	//recorded_rows (sorted) are written to recorded_steps, both keep the orientation of the original map if the transposed
+	//map is given
+	void computeStepsToObstacle(const cv::Mat& map, const int direction, const double slope, const bool transposed,
+			const int first_row, const int last_row, const unsigned short* previous_row_steps, const unsigned short* next_row_steps,
+			cv::Mat& steps, const std::vector<int>& recorded_rows, cv::Mat& recorded_steps) const;
+
 	std::vector<double> precomputed_cos_;
 	std::vector<double> precomputed_sin_;
+
+	std::vector<cv::Mat> directional_steps_;	// number of steps to the next obstacle for each beam direction (CV_16UC1), relative to directional_map_roi_
+	std::vector<double> directional_step_lengths_;	// length of one step along the digital line of each beam direction, in [pixel]
+	cv::Rect directional_map_roi_;	// part of the map covered by the directional distance maps, in [pixel]
+
+	cv::Rect directional_border_roi_;	// part of the map with free pixels and a one pixel border, in [pixel]
+	cv::Mat directional_transposed_map_;	// transposed part of the map within directional_border_roi_
+	std::vector<int> directional_border_rows_;	// rows next to the borders of the bands, relative to directional_border_roi_
+	std::vector<cv::Mat> directional_border_steps_;	// number of steps to the next obstacle in directional_border_rows_ for each beam direction (CV_16UC1)
 };
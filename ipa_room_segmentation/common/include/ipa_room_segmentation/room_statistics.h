@@ -0,0 +1,96 @@
+/*!
+ *****************************************************************
+ * \file
+ *
+ * \note
+ * Copyright (c) 2026 \n
+ * Fraunhofer Institute for Manufacturing Engineering
+ * and Automation (IPA) \n\n
+ *
+ *****************************************************************
+ *
+ * \note
+ * Project name: Care-O-bot
+ * \note
+ * ROS stack name: autopnp
+ * \note
+ * ROS package name: ipa_room_segmentation
+ *
+ * \brief
+ *
+ *
+ *****************************************************************
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer. \n
+ * - Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution. \n
+ * - Neither the name of the Fraunhofer Institute for Manufacturing
+ * Engineering and Automation (IPA) nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission. \n
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************/
+
+
+#pragma once
+
+#include <vector>
+#include <map>
+#include <set>
+
+#include <opencv2/opencv.hpp>
+
+// statistics of one room (segment) of a labeled map
+struct RoomStatistics
+{
+	int label;		// label of the room in the labeled map
+	int area;		// number of room cells, in [pixel]
+	cv::Rect bounding_box;		// in [pixel]
+	std::set<int> neighbor_labels;		// labels of the rooms that share a border with this room (8-neighborhood)
+	cv::Point center;		// room center that is reachable by the robot, in [pixel], (-1,-1) if it could not be determined
+
+	RoomStatistics()
+	: label(0), area(0), center(-1, -1)
+	{
+	}
+};
+
+// Computes the room information of a labeled map of type CV_32SC1, in which rooms carry labels in [1,65279], 0 marks obstacles
+// and values >= 65280 mark unassigned free space.
+class LabeledMapStatistics
+{
+public:
+	LabeledMapStatistics(void) {};
+
+	// collects bounding box, area and neighbors of each room in one pass over the map, the rooms are ordered by their first
+	// occurrence in row-major order and label_to_index maps each room label to its position in rooms
+	void computeRoomStatistics(const cv::Mat& labeled_map, std::vector<RoomStatistics>& rooms, std::map<int, size_t>& label_to_index);
+
+	// marks each room cell (with 255 in connection_to_other_rooms, CV_8UC1) that has a path through cells of its own room to a cell of a different room
+	void computeConnectionToOtherRooms(const cv::Mat& labeled_map, cv::Mat& connection_to_other_rooms);
+
+	// computes the room centers with distance transform and mean shift within the bounding box of each room, the rooms are processed in parallel,
+	// labeled_map may contain fewer room cells than the map that provided rooms (e.g. cells not reachable by the robot set to 0),
+	// if connection_to_other_rooms is not empty, the center is searched among the connected room cells first
+	// map_resolution in [m/cell]
+	void computeRoomCenters(const cv::Mat& labeled_map, const cv::Mat& connection_to_other_rooms, const double map_resolution, std::vector<RoomStatistics>& rooms);
+};
@@ -91,6 +91,7 @@
 #include <ipa_room_segmentation/clique_class.h>
 #include <ipa_room_segmentation/room_class.h>
 #include <ipa_room_segmentation/abstract_voronoi_segmentation.h>
+#include <ipa_room_segmentation/cv_boost_loader.h>
 
 #pragma once
 
@@ -162,10 +163,8 @@ protected:
 
 #if CV_MAJOR_VERSION == 2
 	CvBoostParams params_; // Parameters for the classifiers
-	CvBoost room_boost_, hallway_boost_, doorway_boost_; // The AdaBoost-Classifier to induct the features needed in the conditional random field.
-#else
-	cv::Ptr<cv::ml::Boost> room_boost_, hallway_boost_, doorway_boost_; // The AdaBoost-Classifier to induct the features needed in the conditional random field.
 #endif
+	BoostPtr room_boost_, hallway_boost_, doorway_boost_; // The AdaBoost-Classifier to induct the features needed in the conditional random field. Loaded classifiers are shared read-only with other instances.
 
 	std::vector<double> trained_conditional_weights_; // The weights that are needed for the feature-induction in the conditional random field.
 
@@ -1,8 +1,12 @@
 #include <iostream>
 #include <list>
 #include <vector>
+#include <limits>
 #include <math.h>
 #include <opencv2/opencv.hpp>
 #include <opencv2/highgui/highgui.hpp>
 
-void wavefrontRegionGrowing(cv::Mat& image);
+// Spreads the labels (1..65279) of the given CV_32SC1 image into the neighboring unassigned pixels (values > 65279), obstacles are 0.
+// Each pixel takes the label of the first labeled 8-neighbor in row-major order that was reached before it. With geodesic_tie_break,
+// the neighbor with the shortest geodesic distance to its labeled origin is taken instead, which gives smoother region borders.
+void wavefrontRegionGrowing(cv::Mat& image, const bool geodesic_tie_break=false);
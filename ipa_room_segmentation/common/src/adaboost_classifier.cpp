@@ -20,6 +20,8 @@ AdaboostClassifier::AdaboostClassifier()
 	CvBoostParams params(CvBoost::DISCRETE, 350, 0, 2, false, 0);
 	params_ = params;
 #endif
+	room_boost_ = createBoost();
+	hallway_boost_ = createBoost();
 	trained_ = false;
 }
 
@@ -41,8 +43,12 @@ void AdaboostClassifier::trainClassifiers(const std::vector<cv::Mat>& room_train
 	LaserScannerFeatures lsf;
 	for(size_t map = 0; map < room_training_maps.size(); ++map)
 	{
+		const int directional_distance_map_rows = raycasting_.getDirectionalDistanceMapsRows(room_training_maps[map]);
+		raycasting_.computeDirectionalDistanceMapBorders(room_training_maps[map], directional_distance_map_rows);
 		for (int y = 0; y < room_training_maps[map].rows; y++)
 		{
+			if (y % directional_distance_map_rows == 0)
+				raycasting_.computeDirectionalDistanceMaps(room_training_maps[map], y, y + directional_distance_map_rows);
 			for (int x = 0; x < room_training_maps[map].cols; x++)
 			{
 				if (room_training_maps[map].at<unsigned char>(y, x) != 0)
@@ -57,7 +63,7 @@ void AdaboostClassifier::trainClassifiers(const std::vector<cv::Mat>& room_train
 						labels_for_rooms.push_back(1.0);
 					}
 					//simulate the beams and features for every position and save it
-					raycasting_.raycasting(room_training_maps[map], cv::Point(x, y), temporary_beams);
+					raycasting_.directional_raycasting(cv::Point(x, y), temporary_beams);
 					cv::Mat features;
 					lsf.get_features(temporary_beams, angles_for_simulation_, cv::Point(x, y), features);
 					temporary_features.resize(features.cols);
@@ -73,8 +79,12 @@ void AdaboostClassifier::trainClassifiers(const std::vector<cv::Mat>& room_train
 
 	for(size_t map = 0; map < hallway_training_maps.size(); ++map)
 	{
+		const int directional_distance_map_rows = raycasting_.getDirectionalDistanceMapsRows(hallway_training_maps[map]);
+		raycasting_.computeDirectionalDistanceMapBorders(hallway_training_maps[map], directional_distance_map_rows);
 		for (int y = 0; y < hallway_training_maps[map].rows; y++)
 		{
+			if (y % directional_distance_map_rows == 0)
+				raycasting_.computeDirectionalDistanceMaps(hallway_training_maps[map], y, y + directional_distance_map_rows);
 			for (int x = 0; x < hallway_training_maps[map].cols; x++)
 			{
 				if (hallway_training_maps[map].at<unsigned char>(y, x) != 0)
@@ -89,7 +99,7 @@ void AdaboostClassifier::trainClassifiers(const std::vector<cv::Mat>& room_train
 						labels_for_hallways.push_back(1.0);
 					}
 					//simulate the beams and features for every position and save it
-					raycasting_.raycasting(hallway_training_maps[map], cv::Point(x, y), temporary_beams);
+					raycasting_.directional_raycasting(cv::Point(x, y), temporary_beams);
 					cv::Mat features;
 					lsf.get_features(temporary_beams, angles_for_simulation_, cv::Point(x, y), features);
 					temporary_features.resize(features.cols);
@@ -150,14 +160,14 @@ void AdaboostClassifier::trainClassifiers(const std::vector<cv::Mat>& room_train
 
 	//*********hallway***************
 	std::string filename_hallway = classifier_storage_path + "semantic_hallway_boost.xml";
+	hallway_boost_ = createBoost();	// always train a new classifier, a loaded one may be shared with other instances
 #if CV_MAJOR_VERSION == 2
 	// Train a boost classifier
-	hallway_boost_.train(hallway_features_mat, CV_ROW_SAMPLE, hallway_labels_mat, cv::Mat(), cv::Mat(), cv::Mat(), cv::Mat(), params_);
+	hallway_boost_->train(hallway_features_mat, CV_ROW_SAMPLE, hallway_labels_mat, cv::Mat(), cv::Mat(), cv::Mat(), cv::Mat(), params_);
 	//save the trained booster
-	hallway_boost_.save(filename_hallway.c_str(), "boost");
+	hallway_boost_->save(filename_hallway.c_str(), "boost");
 #else
 	// Train a boost classifier
-	hallway_boost_->create();
 	hallway_boost_->setBoostType(cv::ml::Boost::DISCRETE);
 	hallway_boost_->setWeakCount(350);
 	hallway_boost_->setWeightTrimRate(0);
@@ -171,14 +181,14 @@ void AdaboostClassifier::trainClassifiers(const std::vector<cv::Mat>& room_train
 
 	//*************room***************
 	std::string filename_room = classifier_storage_path + "semantic_room_boost.xml";
+	room_boost_ = createBoost();	// always train a new classifier, a loaded one may be shared with other instances
 #if CV_MAJOR_VERSION == 2
 	// Train a boost classifier
-	room_boost_.train(room_features_mat, CV_ROW_SAMPLE, room_labels_mat, cv::Mat(), cv::Mat(), cv::Mat(), cv::Mat(), params_);
+	room_boost_->train(room_features_mat, CV_ROW_SAMPLE, room_labels_mat, cv::Mat(), cv::Mat(), cv::Mat(), cv::Mat(), params_);
 	//save the trained booster
-	room_boost_.save(filename_room.c_str(), "boost");
+	room_boost_->save(filename_room.c_str(), "boost");
 #else
 	// Train a boost classifier
-	room_boost_->create();
 	room_boost_->setBoostType(cv::ml::Boost::DISCRETE);
 	room_boost_->setWeakCount(350);
 	room_boost_->setWeightTrimRate(0);
@@ -194,9 +204,130 @@ void AdaboostClassifier::trainClassifiers(const std::vector<cv::Mat>& room_train
 	ROS_INFO("Finished training the algorithm.");
 }
 
+void AdaboostClassifier::classifyPoints(cv::Mat& map, const cv::Mat& mask, cv::Mat& confidences)
+{
+	const int directional_distance_map_rows = raycasting_.getDirectionalDistanceMapsRows(map);
+	raycasting_.computeDirectionalDistanceMapBorders(map, directional_distance_map_rows);
+	for (int min_row = 0; min_row < map.rows; min_row += directional_distance_map_rows)
+	{
+		const int max_row = std::min(map.rows, min_row + directional_distance_map_rows);
+		if (cv::countNonZero(mask.rowRange(min_row, max_row)) == 0)
+			continue;
+		raycasting_.computeDirectionalDistanceMaps(map, min_row, max_row);
+#pragma omp parallel for
+		for (int y = min_row; y < max_row; y++)
+		{
+			//collect the pixels of this row, their features are computed and classified at once
+			std::vector<cv::Point> points;
+			for (int x = 0; x < map.cols; x++)
+				if (mask.at<unsigned char>(y, x) != 0)
+					points.push_back(cv::Point(x, y));
+			if (points.size() == 0)
+				continue;
+
+			//simulate the beams and calculate the features for every point
+			cv::Mat beams((int)points.size(), (int)angles_for_simulation_.size(), CV_64FC1);
+			std::vector<double> temporary_beams;
+			for (size_t p = 0; p < points.size(); ++p)
+			{
+				raycasting_.directional_raycasting(points[p], temporary_beams);
+				std::copy(temporary_beams.begin(), temporary_beams.end(), beams.ptr<double>((int)p));
+			}
+			LaserScannerFeatures lsf;
+			cv::Mat features_mat; //OpenCV expects a 32-floating-point Matrix as feature input
+			lsf.get_features(beams, angles_for_simulation_, points, features_mat);
+
+			//classify each Point
+			cv::Mat room_sums, hallway_sums;
+#if CV_MAJOR_VERSION == 2
+			room_sums.create(features_mat.rows, 1, CV_32FC1);
+			hallway_sums.create(features_mat.rows, 1, CV_32FC1);
+			for (int p = 0; p < features_mat.rows; ++p)
+			{
+				room_sums.at<float>(p) = room_boost_->predict(features_mat.row(p), cv::Mat(), cv::Range::all(), false, true);
+				hallway_sums.at<float>(p) = hallway_boost_->predict(features_mat.row(p), cv::Mat(), cv::Range::all(), false, true);
+			}
+#else
+			room_boost_->predict(features_mat, room_sums, cv::ml::Boost::RAW_OUTPUT);
+			hallway_boost_->predict(features_mat, hallway_sums, cv::ml::Boost::RAW_OUTPUT);
+#endif
+			for (size_t p = 0; p < points.size(); ++p)
+			{
+				float room_sum = room_sums.at<float>((int)p);
+				float hallway_sum = hallway_sums.at<float>((int)p);
+				//get the certanity-values for each class (it shows the probability that it belongs to the given class)
+				double room_certanity = (std::exp((double) room_sum)) / (std::exp(-1 * (double) room_sum) + std::exp((double) room_sum));
+				double hallway_certanity = (std::exp((double) hallway_sum))
+				        / (std::exp(-1 * (double) hallway_sum) + std::exp((double) hallway_sum));
+				//make a decision-list and check which class the Point belongs to
+				double probability_for_room = room_certanity;
+				double probability_for_hallway = hallway_certanity * (1.0 - probability_for_room);
+				confidences.at<float>(points[p]) = std::abs(probability_for_room - probability_for_hallway);
+				if (probability_for_room > probability_for_hallway)
+				{
+					map.at<unsigned char>(points[p]) = 150; //label it as room
+				}
+				else
+				{
+					map.at<unsigned char>(points[p]) = 100; //label it as hallway
+				}
+			}
+		}
+	}
+}
+
+void AdaboostClassifier::findWatershedSeeds(const cv::Mat& region_mask, const int cell_size, std::vector<cv::Point>& seeds) const
+{
+	seeds.clear();
+	cv::Mat distance_map;
+	cv::distanceTransform(region_mask, distance_map, CV_DIST_L2, 5);
+
+	//find the maximum of the distance transform in each grid cell, the first pixel in scan order wins on ties
+	const int grid_rows = (region_mask.rows + cell_size - 1) / cell_size;
+	const int grid_cols = (region_mask.cols + cell_size - 1) / cell_size;
+	cv::Mat cell_maxima(grid_rows, grid_cols, CV_32FC1, cv::Scalar(0));
+	std::vector<cv::Point> cell_maximum_locations(grid_rows * grid_cols);
+	for (int y = 0; y < distance_map.rows; ++y)
+	{
+		const float* distance_row = distance_map.ptr<float>(y);
+		float* cell_maxima_row = cell_maxima.ptr<float>(y / cell_size);
+		for (int x = 0; x < distance_map.cols; ++x)
+		{
+			if (distance_row[x] > cell_maxima_row[x / cell_size])
+			{
+				cell_maxima_row[x / cell_size] = distance_row[x];
+				cell_maximum_locations[(y / cell_size) * grid_cols + x / cell_size] = cv::Point(x, y);
+			}
+		}
+	}
+
+	//non-maximum suppression over the neighboring cells, equal maxima are kept so that corridors of constant width get
+	//one seed per cell
+	for (int v = 0; v < grid_rows; ++v)
+	{
+		for (int u = 0; u < grid_cols; ++u)
+		{
+			const float cell_maximum = cell_maxima.at<float>(v, u);
+			if (cell_maximum <= 0.f)
+				continue;
+			bool is_maximum = true;
+			for (int dv = -1; dv <= 1 && is_maximum == true; ++dv)
+				for (int du = -1; du <= 1; ++du)
+					if (v + dv >= 0 && v + dv < grid_rows && u + du >= 0 && u + du < grid_cols && cell_maxima.at<float>(v + dv, u + du) > cell_maximum)
+					{
+						is_maximum = false;
+						break;
+					}
+			if (is_maximum == true)
+				seeds.push_back(cell_maximum_locations[v * grid_cols + u]);
+		}
+	}
+}
+
 void AdaboostClassifier::segmentMap(const cv::Mat& map_to_be_labeled, cv::Mat& segmented_map, double map_resolution_from_subscription,
         double room_area_factor_lower_limit, double room_area_factor_upper_limit, const std::string& classifier_storage_path,
-        const std::string& classifier_default_path, bool display_results)
+        const std::string& classifier_default_path, bool display_results, const int prediction_grid_step, const double min_prediction_confidence,
+        const bool deterministic_watershed_seeding)
 {
 	//******************Semantic-labeling function based on AdaBoost*****************************
 	//This function calculates single-valued features for every white Pixel in the given occupancy-gridmap and classifies it
@@ -204,12 +335,14 @@ void AdaboostClassifier::segmentMap(const cv::Mat& map_to_be_labeled, cv::Mat& s
 	//	I. If the classifiers hasn't been trained before they should load the training-results saved in the
 	//	   classifier_models folder
 	//	II. Go trough each Pixel of the given map. If this Pixel is white simulate the laser-beams for it and calculate each
-	//		of the implemented features.
+	//		of the implemented features. If a prediction grid is used only the white pixels of the grid are classified this
+	//		way, the other pixels take over the label of the surrounding grid points if these agree and are confident.
 	//	III. Apply a median-Filter on the labeled map to smooth the output of it.
 	//	IV. Find the contours of the segments given by III. by thresholding the map. First set the threshold so high that
 	//		only room-areas are shown in the map and find them. Then make these room-areas black and finally set the threshold
 	//		a little lower than the hallway-colour. The function only takes contours that are larger than the minimum value
-	//		and splits too large hallway-areas into smaller areas by putting random Points into the too large hallway contour
+	//		and splits too large hallway-areas into smaller areas by putting random Points (or the grid-wise maxima of the
+	//		distance transform, if deterministic_watershed_seeding is set) into the too large hallway contour
 	//		and apply a watershed-algorithm on it. At last the saved room and hallway contours are drawn with a random
 	//		colour into the map that hasn't been used already.
 
@@ -233,57 +366,80 @@ void AdaboostClassifier::segmentMap(const cv::Mat& map_to_be_labeled, cv::Mat& s
 		std::string filename_room_default = classifier_default_path + "semantic_room_boost.xml";
 		if (boost::filesystem::exists(boost::filesystem::path(filename_room)) == false)
 			boost::filesystem::copy_file(filename_room_default, filename_room);
-		loadBoost(room_boost_, filename_room);
+		room_boost_ = loadSharedBoost(filename_room);
 
 		std::string filename_hallway = classifier_storage_path + "semantic_hallway_boost.xml";
 		std::string filename_hallway_default = classifier_default_path + "semantic_hallway_boost.xml";
 		if (boost::filesystem::exists(boost::filesystem::path(filename_hallway)) == false)
 			boost::filesystem::copy_file(filename_hallway_default, filename_hallway);
-		loadBoost(hallway_boost_,filename_hallway);
+		hallway_boost_ = loadSharedBoost(filename_hallway);
 
+		if (room_boost_.empty() == true || hallway_boost_.empty() == true)
+		{
+			std::cout << "Error: AdaboostClassifier::segmentMap: Could not load the classifier models." << std::endl;
+			return;
+		}
 		trained_ = true;
 		ROS_INFO("Loaded training results.");
 	}
 
 	//*************** II. Go trough each Point and label it as room or hallway.**************************
-#pragma omp parallel for
-	for (int y = 0; y < original_map_to_be_labeled.rows; y++)
+	const cv::Mat free_space_mask = (original_map_to_be_labeled == 255);
+	cv::Mat confidences(original_map_to_be_labeled.rows, original_map_to_be_labeled.cols, CV_32FC1, cv::Scalar(0));
+	if (prediction_grid_step <= 1)
+	{
+		classifyPoints(original_map_to_be_labeled, free_space_mask, confidences);
+	}
+	else
 	{
-		LaserScannerFeatures lsf;
-		for (int x = 0; x < original_map_to_be_labeled.cols; x++)
+		// classify the white pixels of the grid
+		cv::Mat grid_mask = cv::Mat::zeros(original_map_to_be_labeled.rows, original_map_to_be_labeled.cols, CV_8UC1);
+		for (int y = 0; y < original_map_to_be_labeled.rows; y += prediction_grid_step)
+			for (int x = 0; x < original_map_to_be_labeled.cols; x += prediction_grid_step)
+				if (free_space_mask.at<unsigned char>(y, x) != 0)
+					grid_mask.at<unsigned char>(y, x) = 255;
+		classifyPoints(original_map_to_be_labeled, grid_mask, confidences);
+
+		// take over the label of the classified grid points at the corners of the grid cell of each white pixel if they agree
+		// and are confident, otherwise the pixel lies near a label boundary or in an uncertain region and is classified itself
+		cv::Mat refinement_mask = cv::Mat::zeros(original_map_to_be_labeled.rows, original_map_to_be_labeled.cols, CV_8UC1);
+		int number_refined_pixels = 0;
+		for (int y = 0; y < original_map_to_be_labeled.rows; y++)
 		{
-			if (original_map_to_be_labeled.at<unsigned char>(y, x) == 255)
+			const int grid_y = y - y % prediction_grid_step;
+			for (int x = 0; x < original_map_to_be_labeled.cols; x++)
 			{
-				std::vector<double> temporary_beams;
-				raycasting_.raycasting(original_map_to_be_labeled, cv::Point(x, y), temporary_beams);
-				std::vector<float> temporary_features;
-				cv::Mat features_mat; //OpenCV expects a 32-floating-point Matrix as feature input
-				lsf.get_features(temporary_beams, angles_for_simulation_, cv::Point(x, y), features_mat);
-				//classify each Point
-#if CV_MAJOR_VERSION == 2
-				float room_sum = room_boost_.predict(features_mat, cv::Mat(), cv::Range::all(), false, true);
-				float hallway_sum = hallway_boost_.predict(features_mat, cv::Mat(), cv::Range::all(), false, true);
-#else
-				float room_sum = room_boost_->predict(features_mat, cv::Mat(), cv::ml::Boost::RAW_OUTPUT);
-				float hallway_sum = hallway_boost_->predict(features_mat, cv::Mat(), cv::ml::Boost::RAW_OUTPUT);
-#endif
-				//get the certanity-values for each class (it shows the probability that it belongs to the given class)
-				double room_certanity = (std::exp((double) room_sum)) / (std::exp(-1 * (double) room_sum) + std::exp((double) room_sum));
-				double hallway_certanity = (std::exp((double) hallway_certanity))
-				        / (std::exp(-1 * (double) hallway_certanity) + std::exp((double) hallway_certanity));
-				//make a decision-list and check which class the Point belongs to
-				double probability_for_room = room_certanity;
-				double probability_for_hallway = hallway_certanity * (1.0 - probability_for_room);
-				if (probability_for_room > probability_for_hallway)
+				if (free_space_mask.at<unsigned char>(y, x) == 0 || grid_mask.at<unsigned char>(y, x) != 0)
+					continue;
+				const int grid_x = x - x % prediction_grid_step;
+				unsigned char label = 0;
+				bool refine = false;
+				for (int dy = 0; dy <= prediction_grid_step; dy += prediction_grid_step)
 				{
-					original_map_to_be_labeled.at<unsigned char>(y, x) = 150; //label it as room
+					for (int dx = 0; dx <= prediction_grid_step; dx += prediction_grid_step)
+					{
+						const int cy = grid_y + dy;
+						const int cx = grid_x + dx;
+						if (cy >= original_map_to_be_labeled.rows || cx >= original_map_to_be_labeled.cols || grid_mask.at<unsigned char>(cy, cx) == 0)
+							continue;
+						const unsigned char corner_label = original_map_to_be_labeled.at<unsigned char>(cy, cx);
+						if (confidences.at<float>(cy, cx) < min_prediction_confidence || (label != 0 && corner_label != label))
+							refine = true;
+						label = corner_label;
+					}
 				}
-				else
+				if (label == 0 || refine == true)
 				{
-					original_map_to_be_labeled.at<unsigned char>(y, x) = 100; //label it as hallway
+					refinement_mask.at<unsigned char>(y, x) = 255;
+					++number_refined_pixels;
 				}
+				else
+					original_map_to_be_labeled.at<unsigned char>(y, x) = label;
 			}
 		}
+		std::cout << "classified " << cv::countNonZero(grid_mask) << " grid pixels and " << number_refined_pixels << " of "
+				<< cv::countNonZero(free_space_mask) << " white pixels" << std::endl;
+		classifyPoints(original_map_to_be_labeled, refinement_mask, confidences);
 	}
 	std::cout << "labeled all white pixels: " << std::endl;
 	//******************** III. Apply a median filter over the image to smooth the results.***************************
@@ -350,21 +506,45 @@ void AdaboostClassifier::segmentMap(const cv::Mat& map_to_be_labeled, cv::Mat& s
 			cv::Mat contour_Map = cv::Mat::zeros(temporary_map.rows, temporary_map.cols, CV_8UC1);
 			cv::drawContours(contour_Map, contours, contour_counter, cv::Scalar(255), CV_FILLED);
 			cv::erode(contour_Map, contour_Map, cv::Mat(), cv::Point(-1,-1), 10);
-			//center-counter so enough centers could be found
-			int center_counter = 0;
 			//saving-vector for watershed centers
 			std::vector < cv::Point > temporary_watershed_centers;
-			//find enough random watershed centers that are inside the hallway-contour
-			do
+			if (deterministic_watershed_seeding == true)
 			{
-				int random_x = rand() % temporary_map.rows;
-				int random_y = rand() % temporary_map.cols;
-				if (contour_Map.at<unsigned char>(random_y, random_x) == 255)
+				//one seed per grid cell of 8 square meters at most, like the random sampling below
+				const int cell_size = std::max(1, cvRound(std::sqrt(8.) / map_resolution_from_subscription));
+				findWatershedSeeds(contour_Map, cell_size, temporary_watershed_centers);
+				//nothing left after the erosion, keep the hallway as a whole
+				if (temporary_watershed_centers.size() == 0)
 				{
-					temporary_watershed_centers.push_back(cv::Point(random_x, random_y));
-					center_counter++;
+					saved_hallway_contours.push_back(contours[contour_counter]);
+					continue;
 				}
-			} while (center_counter <= (map_resolution_from_subscription * map_resolution_from_subscription * cv::contourArea(contours[contour_counter])) / 8);
+			}
+			else
+			{
+				//center-counter so enough centers could be found
+				int center_counter = 0;
+				const double number_of_centers = (map_resolution_from_subscription * map_resolution_from_subscription * cv::contourArea(contours[contour_counter])) / 8;
+				//the erosion may leave only a few pixels of the contour, so the number of draws is limited
+				const long max_attempts = (cv::countNonZero(contour_Map) > 0 ? 10 * (long)contour_Map.rows * (long)contour_Map.cols : 0);
+				//find enough random watershed centers that are inside the hallway-contour
+				for (long attempt = 0; attempt < max_attempts && center_counter <= number_of_centers; ++attempt)
+				{
+					int random_x = rand() % contour_Map.cols;
+					int random_y = rand() % contour_Map.rows;
+					if (contour_Map.at<unsigned char>(random_y, random_x) == 255)
+					{
+						temporary_watershed_centers.push_back(cv::Point(random_x, random_y));
+						center_counter++;
+					}
+				}
+				//nothing found inside the eroded contour, keep the hallway as a whole
+				if (temporary_watershed_centers.size() == 0)
+				{
+					saved_hallway_contours.push_back(contours[contour_counter]);
+					continue;
+				}
+			}
 			cv::Mat temporary_Map_to_wavefront;
 			contour_Map.convertTo(temporary_Map_to_wavefront, CV_32SC1, 256, 0);
 			//draw the centers as white circles into a black map and give the center-map and the contour-map to the opencv watershed-algorithm
@@ -1,17 +1,86 @@
 #include <ipa_room_segmentation/cv_boost_loader.h>
 
-#if CV_MAJOR_VERSION == 2
-void loadBoost(CvBoost& boost, std::string const& filename)
+#include <iostream>
+#include <map>
+#include <ctime>
+
+#include <boost/filesystem.hpp>
+#include <boost/thread/mutex.hpp>
+
+BoostPtr createBoost()
 {
-	boost.load(filename.c_str());
-}
+#if CV_MAJOR_VERSION == 2
+	return BoostPtr(new CvBoost());
 #else
-void loadBoost(cv::Ptr<cv::ml::Boost> boost, std::string const& filename)
+	return cv::ml::Boost::create();
+#endif
+}
+
+BoostPtr loadBoost(std::string const& filename)
 {
-#if CV_MAJOR_VERSION == 3 && CV_MINOR_VERSION<=2
-	boost->load<cv::ml::Boost>(filename.c_str());
+	BoostPtr boost;
+	try
+	{
+#if CV_MAJOR_VERSION == 2
+		boost = createBoost();
+		boost->load(filename.c_str());
+		if (boost->get_weak_predictors() == 0)
+			boost.release();
 #else
-	boost->load(filename.c_str());
+		boost = cv::Algorithm::load<cv::ml::Boost>(filename);
+		if (boost.empty() == false && boost->isTrained() == false)
+			boost.release();
 #endif
+	}
+	catch (cv::Exception& e)
+	{
+		std::cout << "Error: loadBoost: " << e.what() << std::endl;
+		boost.release();
+	}
+	if (boost.empty() == true)
+		std::cout << "Error: loadBoost: Could not load a trained classifier from " << filename << std::endl;
+	return boost;
+}
+
+// entry of the classifier cache, a cached classifier is valid as long as the file has not been modified
+struct CachedBoost
+{
+	std::time_t modification_time;
+	boost::uintmax_t file_size;
+	BoostPtr boost;
+};
+
+BoostPtr loadSharedBoost(std::string const& filename)
+{
+	static boost::mutex cache_mutex;
+	static std::map<std::string, CachedBoost> cache;
+
+	// get the current state of the file
+	boost::system::error_code error;
+	const boost::filesystem::path path(filename);
+	const std::time_t modification_time = boost::filesystem::last_write_time(path, error);
+	const boost::uintmax_t file_size = (error ? 0 : boost::filesystem::file_size(path, error));
+	if (error)
+	{
+		std::cout << "Error: loadSharedBoost: Could not access " << filename << ": " << error.message() << std::endl;
+		return BoostPtr();
+	}
+
+	// reuse the cached classifier if the file has not changed since it was loaded
+	boost::mutex::scoped_lock lock(cache_mutex);
+	std::map<std::string, CachedBoost>::iterator entry = cache.find(filename);
+	if (entry != cache.end() && entry->second.modification_time == modification_time && entry->second.file_size == file_size)
+		return entry->second.boost;
+
+	CachedBoost cached_boost;
+	cached_boost.modification_time = modification_time;
+	cached_boost.file_size = file_size;
+	cached_boost.boost = loadBoost(filename);
+	if (cached_boost.boost.empty() == true)
+	{
+		cache.erase(filename);
+		return BoostPtr();
+	}
+	cache[filename] = cached_boost;
+	return cached_boost.boost;
 }
-#endif
@@ -2,6 +2,7 @@
 
 #include <ipa_room_segmentation/wavefront_region_growing.h>
 #include <ipa_room_segmentation/contains.h>
+#include <ipa_room_segmentation/max_tree.h>
 
 DistanceSegmentation::DistanceSegmentation()
 {
@@ -21,8 +22,7 @@ void DistanceSegmentation::segmentMap(const cv::Mat& map_to_be_labeled, cv::Mat&
 	//hierarchy saves if the contours are hole-contours:
 	//hierarchy[{0,1,2,3}]={next contour (same level), previous contour (same level), child contour, parent contour}
 	//child-contour = 1 if it has one, = -1 if not, same for parent_contour
-	std::vector < cv::Vec4i > hierarchy, hierarchy_saver;
-	std::vector < std::vector<cv::Point> > temporary_contours;
+	std::vector < cv::Vec4i > hierarchy;
 	//
 	//Segmentation of a gridmap into roomlike areas based on the distance-transformation of the map
 	//
@@ -35,50 +35,51 @@ void DistanceSegmentation::segmentMap(const cv::Mat& map_to_be_labeled, cv::Mat&
 
 	//2. Threshold the map and find the contours of the rooms. Change the threshold and repeat steps until last possible threshold.
 	//Then take the contours from the threshold with the most contours between the roomfactors and draw it in the map with a random color.
-	std::vector<std::vector<cv::Point> > saved_contours, hole_contour_saver;	//saving-vector for the found contours
-	double saved_energy = 0;
-	for (int current_threshold = 255; current_threshold > 0; current_threshold--)
-	{ //change the threshold for the grayscale-image from largest possible value to smallest
-	  //reset number of rooms
-		temporary_contours.clear();
-		contours.clear();
-		hierarchy.clear();
-		cv::threshold(distance_map, thresh_map, current_threshold, 255, cv::THRESH_BINARY);
-		cv::findContours(thresh_map, contours, hierarchy, CV_RETR_CCOMP, CV_CHAIN_APPROX_NONE);
-
-		//Get the number of large enough regions to be a room. Only check non-holes.
-		//Energy function: -(x-a)^2 + b, where x is the current area, a is the optimal area and b is a factor to make the function zero at x=0
-		for (int c = 0; c < contours.size(); c++)
+	//The components of all thresholded maps and their areas (contour area minus the area of the hole contours) are read from the
+	//max-tree of the distance map, which is built once: a node is the component of the pixels > current_threshold for all
+	//thresholds from the level of its parent to its own level-1, so a node of room size adds one room to each of these thresholds.
+	MaxTree distance_tree;
+	distance_tree.build(distance_map);
+	const std::vector<MaxTree::Node>& components = distance_tree.getNodes();
+	std::vector<int> room_count_changes(257, 0);	//room count of a threshold = sum of the changes up to it
+	for (size_t c = 0; c < components.size(); c++)
+	{
+		double room_area = map_resolution_from_subscription * map_resolution_from_subscription * components[c].area;
+		if (room_area >= room_area_factor_lower_limit && room_area <= room_area_factor_upper_limit)
 		{
-			if (hierarchy[c][3] == -1)
-			{
-				double room_area = map_resolution_from_subscription * map_resolution_from_subscription * cv::contourArea(contours[c]);
-				//subtract the area from the hole contours inside the found contour, because the contour area grows extremly large if it is a closed loop
-				for(int hole = 0; hole < contours.size(); hole++)
-				{
-					if(hierarchy[hole][3] == c)//check if the parent of the hole is the current looked at contour
-					{
-						room_area -= map_resolution_from_subscription * map_resolution_from_subscription * cv::contourArea(contours[hole]);
-					}
-				}
-				if (room_area >= room_area_factor_lower_limit && room_area <= room_area_factor_upper_limit)
-				{
-					temporary_contours.push_back(contours[c]);
-					//update the energy of the current configuration
-				}
-			}
+			room_count_changes[(components[c].parent == -1 ? 0 : components[components[c].parent].level)]++;
+			room_count_changes[components[c].level]--;
 		}
-		//check if current step has a better energy than the saved one
-		if (temporary_contours.size() >= saved_contours.size())//(current_energy >= saved_energy)
+	}
+	std::vector<int> room_counts(256, 0);
+	room_counts[0] = room_count_changes[0];
+	for (int current_threshold = 1; current_threshold < 256; current_threshold++)
+		room_counts[current_threshold] = room_counts[current_threshold-1] + room_count_changes[current_threshold];
+	//take the lowest threshold with the most rooms
+	int best_threshold = 255;
+	for (int current_threshold = 255; current_threshold > 0; current_threshold--)
+		if (room_counts[current_threshold] >= room_counts[best_threshold])
+			best_threshold = current_threshold;
+
+	//find the contours at the selected threshold and save the ones of the room components, only check non-holes
+	std::vector<std::vector<cv::Point> > saved_contours, hole_contour_saver;	//saving-vector for the found contours
+	std::vector < cv::Vec4i > hierarchy_saver;
+	cv::threshold(distance_map, thresh_map, best_threshold, 255, cv::THRESH_BINARY);
+	cv::findContours(thresh_map, contours, hierarchy, CV_RETR_CCOMP, CV_CHAIN_APPROX_NONE);
+	for (int c = 0; c < contours.size(); c++)
+	{
+		if (hierarchy[c][3] == -1)
 		{
-			saved_contours.clear();
-			hole_contour_saver.clear();
-			hierarchy_saver.clear();
-			saved_contours = temporary_contours;
-			hole_contour_saver = contours;
-			hierarchy_saver = hierarchy;
+			const int component = distance_tree.getComponent(contours[c][0], best_threshold+1);
+			double room_area = map_resolution_from_subscription * map_resolution_from_subscription * components[component].area;
+			if (room_area >= room_area_factor_lower_limit && room_area <= room_area_factor_upper_limit)
+				saved_contours.push_back(contours[c]);
 		}
 	}
+	hole_contour_saver = contours;
+	hierarchy_saver = hierarchy;
+	std::cout << "Found " << saved_contours.size() << " rooms at the distance threshold " << best_threshold << std::endl;
+
 	//Draw the found contours from the step with most areas in the map with a random colour, that hasn't been used yet
 	std::vector<cv::Scalar> already_used_colors;	//saving-variable for already used fill-colours
 	map_to_be_labeled.convertTo(segmented_map, CV_32SC1, 256, 0);		// rescale to 32 int, 255 --> 255*256 = 65280
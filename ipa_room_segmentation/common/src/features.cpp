@@ -84,38 +84,25 @@ double LaserScannerFeatures::get_feature(const std::vector<double>& beams, const
 
 void LaserScannerFeatures::get_features(const std::vector<double>& beams, const std::vector<double>& angles, cv::Point point, cv::Mat& features)
 {
-	// reset internal data storage
-	resetCachedData();
-
-	// compute features
-	calc_feature1(beams);
-	calc_feature2(beams);
-	calc_feature3(beams, 10);
-	calc_feature4(beams, 10);
-	calc_feature5(beams);
-	calc_feature6(beams);
-	calc_feature7(beams);
-	calc_feature8(beams, angles);
-	calc_feature9(beams, angles);
-	calc_feature10(beams);
-	calc_feature11(beams);
-	calc_feature12(beams);
-	calc_feature13(beams);
-	calc_feature14(beams, angles, point);
-	calc_feature15(beams, angles, point);
-	calc_feature16(beams, angles, point);
-	calc_feature17(beams, angles, point);
-	calc_feature18(beams, angles, point);
-	calc_feature19(beams, angles, point);
-	calc_feature20(beams, angles, point);
-	calc_feature21(beams, angles, point);
-	calc_feature22(beams);
-	calc_feature23(beams);
-
-	// write features
-	features.create(1, get_feature_count(), CV_32FC1);
-	for (int i=0; i<features.cols; ++i)
-		features.at<float>(0,i) = features_[i];
+	const cv::Mat beams_mat(1, (int)beams.size(), CV_64FC1, const_cast<double*>(&beams[0]));
+	get_features(beams_mat, angles, std::vector<cv::Point>(1, point), features);
+}
+
+void LaserScannerFeatures::get_features(const cv::Mat& beams, const std::vector<double>& angles, const std::vector<cv::Point>& points, cv::Mat& features)
+{
+	//the beam directions are the same for all locations
+	const double pi_to_degree = PI / 180;
+	std::vector<double> cos_angles(angles.size()), sin_angles(angles.size());
+	for (size_t b = 0; b < angles.size(); ++b)
+	{
+		cos_angles[b] = std::cos(angles[b] * pi_to_degree);
+		sin_angles[b] = std::sin(angles[b] * pi_to_degree);
+	}
+
+	features.create(beams.rows, get_feature_count(), CV_32FC1);
+	std::vector<cv::Point> polygon(beams.cols);
+	for (int r = 0; r < beams.rows; ++r)
+		calc_features(beams.ptr<double>(r), beams.cols, angles, cos_angles, sin_angles, points[r], polygon, features.ptr<float>(r));
 }
 
 //Calculation of Feature 1: average difference of the beams
@@ -871,3 +858,158 @@ double LaserScannerFeatures::calc_feature21(const std::vector<double>& beams, co
 
 	return features_[20];
 }
+
+//Calculate all features of one location. The first pass over the beams collects the sums, the differences and relations of
+//neighboring beams, the beams of minimal length and the polygonal approximation, the second pass the deviations from the
+//means of the first pass. The features are the same as computed by calc_feature1..23.
+void LaserScannerFeatures::calc_features(const double* beams, const int beam_count, const std::vector<double>& angles, const std::vector<double>& cos_angles,
+		const std::vector<double>& sin_angles, cv::Point location, std::vector<cv::Point>& polygon, float* features) const
+{
+	const double n = beam_count;
+	const double maxval = 10.;	// length limit of the beams for feature 3 and 4
+	const double threshold = 0.5;	// threshold for gaps and relative gaps, see "Semantic labeling of places"
+
+	//***************** first pass *****************
+	double beam_sum = 0., max_beam = 0.;
+	double difference_sum = 0., limited_difference_sum = 0., relation_sum = 0.;
+	double gaps = 0., relative_gaps = 0.;
+	double min_length_1 = 10000000, min_length_2 = 10000000, min_angle_1 = 0., min_angle_2 = 0.;	// minima for feature 8
+	double length_1 = beams[0], length_2 = beams[1], angle_1 = angles[0], angle_2 = angles[1];	// minima for feature 9
+	double sum_x = 0., sum_y = 0.;
+	for (int b = 0; b < beam_count; ++b)
+	{
+		const double beam = beams[b];
+		const double next_beam = (b + 1 < beam_count ? beams[b + 1] : beams[0]);
+		beam_sum += beam;
+		max_beam = std::max(max_beam, beam);
+
+		const double difference = std::abs(beam - next_beam);
+		difference_sum += difference;
+		gaps += (difference > threshold ? 1. : 0.);
+		limited_difference_sum += std::abs(std::min(beam, maxval) - std::min(next_beam, maxval));
+		const double relation = std::min(beam, next_beam) / std::max(beam, next_beam);
+		relation_sum += relation;
+		relative_gaps += (relation < threshold ? 1. : 0.);
+
+		if (beam < min_length_1 && beam > min_length_2)
+		{
+			min_length_1 = beam;
+			min_angle_1 = angles[b];
+		}
+		else if (beam < min_length_2)
+		{
+			min_length_2 = beam;
+			min_angle_2 = angles[b];
+		}
+		if (beam < length_1 && beam > length_2)
+		{
+			length_1 = beam;
+			angle_1 = angles[b];
+		}
+		else if (beam <= length_2)
+		{
+			length_2 = beam;
+			angle_2 = angles[b];
+		}
+
+		polygon[b] = cv::Point(location.x + cos_angles[b] * beam, location.y + sin_angles[b] * beam);
+		sum_x += polygon[b].x;
+		sum_y += polygon[b].y;
+	}
+	const double mean_difference = difference_sum / n;
+	const double mean_limited_difference = limited_difference_sum / n;
+	const double mean_beam = beam_sum / n;
+	const double mean_relation = relation_sum / n;
+	if (max_beam == 0.)
+		max_beam = 1.;
+	const double max_beam_inv = 1. / max_beam;
+	const double mean_relative_beam = mean_beam * max_beam_inv;
+	const cv::Point centroid(sum_x / n, sum_y / n);
+
+	//***************** second pass *****************
+	double difference_deviation_sum = 0., limited_difference_deviation_sum = 0., beam_deviation_sum = 0., beam_kurtosis_sum = 0.;
+	double relation_deviation_sum = 0., relative_beam_deviation_sum = 0., centroid_distance_sum = 0., centroid_distance_square_sum = 0.;
+	for (int b = 0; b < beam_count; ++b)
+	{
+		const double beam = beams[b];
+		const double next_beam = (b + 1 < beam_count ? beams[b + 1] : beams[0]);
+
+		const double difference_deviation = beam - mean_difference;
+		difference_deviation_sum += difference_deviation * difference_deviation;
+		const double limited_difference_deviation = std::abs(std::min(beam, maxval) - std::min(next_beam, maxval)) - mean_limited_difference;
+		limited_difference_deviation_sum += limited_difference_deviation * limited_difference_deviation;
+		const double beam_deviation = beam - mean_beam;
+		const double beam_deviation_square = beam_deviation * beam_deviation;
+		beam_deviation_sum += beam_deviation_square;
+		beam_kurtosis_sum += beam_deviation_square * beam_deviation_square;
+		relation_deviation_sum += beam - mean_relation;
+		const double relative_beam_deviation = beam * max_beam_inv - mean_relative_beam;
+		relative_beam_deviation_sum += relative_beam_deviation * relative_beam_deviation;
+
+		const double delta_x = polygon[b].x - centroid.x;
+		const double delta_y = polygon[b].y - centroid.y;
+		const double centroid_distance_square = delta_x * delta_x + delta_y * delta_y;
+		centroid_distance_sum += std::sqrt(centroid_distance_square);
+		centroid_distance_square_sum += centroid_distance_square;
+	}
+
+	//***************** features based on the beams *****************
+	features[0] = mean_difference;
+	features[1] = std::sqrt(difference_deviation_sum / (n - 1));
+	features[2] = mean_limited_difference;
+	features[3] = std::sqrt(limited_difference_deviation_sum / (n - 1));
+	features[4] = mean_beam;
+	const double beam_deviation = std::sqrt(beam_deviation_sum / (n - 1));
+	features[5] = beam_deviation;
+	features[6] = gaps;
+	const double x1_x2 = std::cos(min_angle_1 * PI / 180) * min_length_1 - std::cos(min_angle_2 * PI / 180) * min_length_2;
+	const double y1_y2 = std::sin(min_angle_1 * PI / 180) * min_length_1 - std::sin(min_angle_2 * PI / 180) * min_length_2;
+	features[7] = std::sqrt(x1_x2*x1_x2 + y1_y2*y1_y2);
+	const double pi_to_degree = PI / 180;
+	const double x_1 = std::cos(angle_1 * pi_to_degree) * length_1;
+	const double y_1 = std::sin(angle_1 * pi_to_degree) * length_1;
+	const double x_2 = std::cos(angle_2 * pi_to_degree) * length_2;
+	const double y_2 = std::sin(angle_2 * pi_to_degree) * length_2;
+	const double coordvec = (x_1 * x_2) + (y_1 * y_2);
+	features[8] = std::acos(std::max(-1., std::min(1., coordvec / (length_1 * length_2)))) * 180.0 / PI;
+	features[9] = mean_relation;
+	features[10] = std::sqrt(relation_deviation_sum / (n - 1));
+	features[11] = relative_gaps;
+	features[12] = (beam_kurtosis_sum / std::pow(beam_deviation, 4)) - 3;
+	features[21] = mean_relative_beam;
+	features[22] = std::sqrt(relative_beam_deviation_sum / (n - 1));
+
+	//***************** features based on the polygonal approximation *****************
+	const double map_resolution = 0.05000;
+	const double area = map_resolution * map_resolution * cv::contourArea(polygon);
+	const double perimeter = cv::arcLength(polygon, true);
+	features[13] = area;
+	features[14] = perimeter;
+	features[15] = area / perimeter;
+	const double mean_centroid_distance = centroid_distance_sum / n;
+	features[16] = mean_centroid_distance;
+	features[17] = std::sqrt(std::max(0., centroid_distance_square_sum - n * mean_centroid_distance * mean_centroid_distance) / (n - 1));
+
+	//half the major and minor axis of the ellipse that surrounds the polygon, taken from the distances of the corners of its bounding box
+	cv::Point2f points[4];
+	cv::fitEllipse(cv::Mat(polygon)).points(points);
+	double max_distance = 0., min_distance = 1e6*1e6;
+	for (int p = 0; p < 4; p++)
+	{
+		for (int np = 0; np < 4; np++)
+		{
+			if (p == np)
+				continue;
+			const float a = (points[p].x - points[np].x);
+			const float b = (points[p].y - points[np].y);
+			const double sqr = a*a + b*b;
+			max_distance = std::max(max_distance, sqr);
+			min_distance = std::min(min_distance, sqr);
+		}
+	}
+	const double major_axis = std::sqrt(max_distance) / 2;
+	const double minor_axis = std::sqrt(min_distance) / 2;
+	features[18] = major_axis;
+	features[19] = minor_axis;
+	features[20] = major_axis / (0.0001 + minor_axis);
+}
@@ -0,0 +1,218 @@
+/*!
+ *****************************************************************
+ * \file
+ *
+ * \note
+ * Copyright (c) 2026 \n
+ * Fraunhofer Institute for Manufacturing Engineering
+ * and Automation (IPA) \n\n
+ *
+ *****************************************************************
+ *
+ * \note
+ * Project name: Care-O-bot
+ * \note
+ * ROS stack name: autopnp
+ * \note
+ * ROS package name: ipa_room_segmentation
+ *
+ * \brief
+ *
+ *
+ *****************************************************************
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer. \n
+ * - Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution. \n
+ * - Neither the name of the Fraunhofer Institute for Manufacturing
+ * Engineering and Automation (IPA) nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission. \n
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************/
+#include <ipa_room_segmentation/max_tree.h>
+
+#include <algorithm>
+
+// returns the root of the union-find tree of pixel and compresses the path to it
+static int findRoot(std::vector<int>& union_parents, int pixel)
+{
+	int root = pixel;
+	while (union_parents[root] != root)
+		root = union_parents[root];
+	while (union_parents[pixel] != root)
+	{
+		const int next = union_parents[pixel];
+		union_parents[pixel] = root;
+		pixel = next;
+	}
+	return root;
+}
+
+MaxTree::MaxTree()
+{
+}
+
+void MaxTree::build(const cv::Mat& image)
+{
+	nodes_.clear();
+	pixel_nodes_ = cv::Mat(image.rows, image.cols, CV_32SC1, cv::Scalar(-1));
+	if (image.rows < 3 || image.cols < 3)
+		return;
+
+	// pixel values with the image border set to 0
+	cv::Mat values = image.clone();
+	values.row(0).setTo(0);
+	values.row(values.rows-1).setTo(0);
+	values.col(0).setTo(0);
+	values.col(values.cols-1).setTo(0);
+	const int cols = values.cols;
+	const unsigned char* value = values.ptr<unsigned char>(0);		// the clone is continuous
+
+	// sort the pixels of the components by decreasing value with a counting sort
+	std::vector<int> histogram(257, 0);
+	for (size_t p = 0; p < values.total(); ++p)
+		if (value[p] != 0)
+			++histogram[256 - value[p]];
+	for (int level = 1; level <= 256; ++level)
+		histogram[level] += histogram[level-1];
+	std::vector<int> sorted_pixels(histogram[256]);
+	for (size_t p = 0; p < values.total(); ++p)
+		if (value[p] != 0)
+			sorted_pixels[histogram[255 - value[p]]++] = (int)p;
+
+	// union-find from the highest to the lowest value (Berger et al., 2007): each pixel becomes the parent of the roots of the
+	// already processed neighbors, so the parent of a pixel is processed after it and has a lower or equal value
+	const int neighbor_offsets[8] = {-cols-1, -cols, -cols+1, -1, 1, cols-1, cols, cols+1};
+	std::vector<int> parents(values.total(), -1), union_parents(values.total(), -1);
+	for (size_t i = 0; i < sorted_pixels.size(); ++i)
+	{
+		const int pixel = sorted_pixels[i];
+		parents[pixel] = pixel;
+		union_parents[pixel] = pixel;
+		for (int n = 0; n < 8; ++n)
+		{
+			const int neighbor = pixel + neighbor_offsets[n];
+			if (union_parents[neighbor] == -1)		// not processed yet or not part of a component, the border is never processed
+				continue;
+			const int root = findRoot(union_parents, neighbor);
+			if (root != pixel)
+			{
+				parents[root] = pixel;
+				union_parents[root] = pixel;
+			}
+		}
+	}
+
+	// let the pixels point to the canonical pixel of their component, i.e. the pixel whose parent has a lower value or itself
+	for (int i = (int)sorted_pixels.size() - 1; i >= 0; --i)
+	{
+		const int pixel = sorted_pixels[i];
+		const int parent = parents[pixel];
+		if (value[parents[parent]] == value[parent])
+			parents[pixel] = parents[parent];
+	}
+
+	// one node per canonical pixel, in the order of processing so that children come before their parents
+	int* pixel_node = pixel_nodes_.ptr<int>(0);
+	for (size_t i = 0; i < sorted_pixels.size(); ++i)
+	{
+		const int pixel = sorted_pixels[i];
+		if (parents[pixel] == pixel || value[parents[pixel]] != value[pixel])
+		{
+			pixel_node[pixel] = (int)nodes_.size();
+			Node node;
+			node.parent = -1;
+			node.level = value[pixel];
+			node.area = 0.;
+			node.bounding_box = cv::Rect(pixel % cols, pixel / cols, 1, 1);
+			nodes_.push_back(node);
+		}
+	}
+	for (size_t i = 0; i < sorted_pixels.size(); ++i)
+	{
+		const int pixel = sorted_pixels[i];
+		if (pixel_node[pixel] != -1)
+		{
+			if (parents[pixel] != pixel)
+				nodes_[pixel_node[pixel]].parent = pixel_node[parents[pixel]];
+		}
+		else
+		{
+			pixel_node[pixel] = pixel_node[parents[pixel]];
+			nodes_[pixel_node[pixel]].bounding_box |= cv::Rect(pixel % cols, pixel / cols, 1, 1);
+		}
+	}
+
+	// The contour area of a component is the area enclosed by the polygons through the centers of its boundary pixels. Each
+	// square between the centers of 2x2 pixels contributes 1 to it if all 4 pixels belong to the component and 1/2 (the
+	// triangle cut off by the diagonal contour edge) if 3 pixels do. So a square adds 1/2 to the component of its second
+	// lowest value and another 1/2 to the component of its lowest value, which contain it at all lower thresholds as well.
+	std::vector<int> half_areas(nodes_.size(), 0);
+	for (int y = 0; y < values.rows-1; ++y)
+	{
+		for (int x = 0; x < cols-1; ++x)
+		{
+			int square[4] = {y*cols+x, y*cols+x+1, (y+1)*cols+x, (y+1)*cols+x+1};
+			for (int i = 1; i < 4; ++i)		// insertion sort by increasing value
+				for (int j = i; j > 0 && value[square[j]] < value[square[j-1]]; --j)
+					std::swap(square[j], square[j-1]);
+			if (value[square[1]] == 0)
+				continue;
+			++half_areas[pixel_node[square[1]]];
+			if (value[square[0]] != 0)
+				++half_areas[pixel_node[square[0]]];
+		}
+	}
+
+	// accumulate the areas and bounding boxes of the subtrees
+	for (size_t n = 0; n < nodes_.size(); ++n)
+	{
+		nodes_[n].area += 0.5 * half_areas[n];
+		const int parent = nodes_[n].parent;
+		if (parent != -1)
+		{
+			nodes_[parent].area += nodes_[n].area;
+			nodes_[parent].bounding_box |= nodes_[n].bounding_box;
+		}
+	}
+}
+
+const std::vector<MaxTree::Node>& MaxTree::getNodes() const
+{
+	return nodes_;
+}
+
+const cv::Mat& MaxTree::getPixelNodes() const
+{
+	return pixel_nodes_;
+}
+
+int MaxTree::getComponent(const cv::Point& pixel, const int level) const
+{
+	int node = pixel_nodes_.at<int>(pixel);
+	if (node == -1 || nodes_[node].level < level)
+		return -1;
+	while (nodes_[node].parent != -1 && nodes_[nodes_[node].parent].level >= level)
+		node = nodes_[node].parent;
+	return node;
+}
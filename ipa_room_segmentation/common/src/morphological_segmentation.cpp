@@ -2,6 +2,7 @@
 
 #include <ipa_room_segmentation/wavefront_region_growing.h>
 #include <ipa_room_segmentation/contains.h>
+#include <ipa_room_segmentation/max_tree.h>
 
 MorphologicalSegmentation::MorphologicalSegmentation()
 {
@@ -13,66 +14,71 @@ void MorphologicalSegmentation::segmentMap(const cv::Mat& map_to_be_labeled, cv:
 {
 	/*This segmentation algorithm does:
 	 * 1. collect the map data
-	 * 2. erode the map to extract contours
+	 * 2. erode the map to extract contours, read from the max-tree of the chessboard distance transform of the map
 	 * 3. find the extracted contures and save them if they fullfill the room-area criterion
 	 * 4. draw and fill the saved contoures in a clone of the map from 1. with a random colour
 	 * 5. get the obstacle information from the original map and draw them in the clone from 4.
 	 * 6. spread the coloured regions to the white Pixels
 	 */
 
-	//make two map clones to work with
-	cv::Mat temporary_map_to_find_rooms = map_to_be_labeled.clone(); //map to find the rooms and for eroding
 	//**************erode temporary_map until last possible room found****************
-	//erode map a specified amount of times
-	std::vector < std::vector<cv::Point> > saved_contours; //saving variable for every contour that is between the upper and the lower limit
+	//A pixel survives n erosions with the 3x3 kernel if its chessboard distance to the next obstacle is > n, so the eroded maps are
+	//the thresholds of the chessboard distance transform of the map. Instead of eroding the map and finding the contours after each
+	//erosion, the components of all eroded maps and their areas (contour area minus the area of the hole contours) are read from
+	//the max-tree of the distance map, which is built once. A component is first found after as many erosions as the level of its
+	//parent (at least one) and exists until level-1 erosions. Components inside an already found room are skipped, as the room
+	//is made black when it is found.
+	const int number_erosions = 73;
+	cv::Mat distance_map;
+	cv::distanceTransform(map_to_be_labeled, distance_map, CV_DIST_C, 3);
+	distance_map.convertTo(distance_map, CV_8U);	//saturates far above the number of erosions
+	MaxTree erosion_tree;
+	erosion_tree.build(distance_map);
+	const std::vector<MaxTree::Node>& components = erosion_tree.getNodes();
+	std::vector<int> room_of_component(components.size(), -1);	//component of the found room that contains the component
+	std::vector<std::pair<int, int> > found_rooms;	//(number of erosions, component) of every component that fullfills the room-area criterion
 	ROS_INFO("starting eroding");
-	for (int counter = 0; counter < 73; counter++)
+	for (int c = (int)components.size() - 1; c >= 0; c--)		//parents come before their children
 	{
-		//erode the map one time
-		cv::Mat eroded_map;
-		cv::Point anchor(-1, -1); //needed for opencv erode
-		cv::erode(temporary_map_to_find_rooms, eroded_map, cv::Mat(), anchor, 1);
-		//save the more eroded map
-		temporary_map_to_find_rooms = eroded_map;
-		//Save the eroded map in a second map, which is used to find the contours. This is neccesarry, because
-		//the function findContours changes the given map and would make it impossible to work any further with it
-		cv::Mat contour_map = eroded_map.clone();
-		//find Contours in the more eroded map
-		std::vector < std::vector<cv::Point> > temporary_contours; //temporary saving-variable
-		//hierarchy saves if the contours are hole-contours:
-		//hierarchy[{0,1,2,3}]={next contour (same level), previous contour (same level), child contour, parent contour}
-		//child-contour = 1 if it has one, = -1 if not, same for parent_contour
-		std::vector < cv::Vec4i > hierarchy;
-		cv::findContours(contour_map, temporary_contours, hierarchy, CV_RETR_CCOMP, CV_CHAIN_APPROX_SIMPLE);
-		if (temporary_contours.size() != 0)
+		const int parent = components[c].parent;
+		if (parent != -1 && room_of_component[parent] != -1)
+		{
+			room_of_component[c] = room_of_component[parent];
+			continue;
+		}
+		const int erosions = std::max(1, (parent == -1 ? 0 : components[parent].level));
+		if (erosions > number_erosions || erosions >= components[c].level)	//the component has been eroded away before
+			continue;
+		//check if contour is large/small enough for a room
+		double room_area = map_resolution_from_subscription * map_resolution_from_subscription * components[c].area;
+		if (room_area_factor_lower_limit < room_area && room_area < room_area_factor_upper_limit)
 		{
-			//check every contour if it fullfills the criteria of a room
-			for (int current_contour = 0; current_contour < temporary_contours.size(); current_contour++)
-			{ //only take first level contours --> second level contours belong to holes and doesn't need to be looked at
-				if (hierarchy[current_contour][3] == -1)
-				{
-					//check if contour is large/small enough for a room
-					double room_area = map_resolution_from_subscription * map_resolution_from_subscription
-					        * cv::contourArea(temporary_contours[current_contour]);
-					//subtract the area from the hole contours inside the found contour, because the contour area grows extremly large if it is a closed loop
-					for (int hole = 0; hole < temporary_contours.size(); hole++)
-					{
-						if (hierarchy[hole][3] == current_contour) //check if the parent of the hole is the current looked at contour
-						{
-							room_area -= map_resolution_from_subscription * map_resolution_from_subscription
-									* cv::contourArea(temporary_contours[hole]);
-						}
-					}
-					if (room_area_factor_lower_limit < room_area && room_area < room_area_factor_upper_limit)
-					{
-						//save contour for later drawing in map
-						saved_contours.push_back(temporary_contours[current_contour]);
-						//make region black if room found --> region doesn't need to be looked at anymore
-						cv::drawContours(temporary_map_to_find_rooms, temporary_contours, current_contour, cv::Scalar(0), CV_FILLED, 8, hierarchy, 2);
-					}
-				}
+			room_of_component[c] = c;
+			found_rooms.push_back(std::pair<int, int>(erosions, c));
+		}
+	}
+	//save the outer contour of each found room in the order of the erosions
+	std::sort(found_rooms.begin(), found_rooms.end());
+	std::vector < std::vector<cv::Point> > saved_contours; //saving variable for every contour that is between the upper and the lower limit
+	const cv::Mat& pixel_components = erosion_tree.getPixelNodes();
+	for (size_t room = 0; room < found_rooms.size(); room++)
+	{
+		//draw the room into a map of its bounding box with a black border, because findContours ignores the image border
+		const int room_component = found_rooms[room].second;
+		const cv::Rect& bounding_box = components[room_component].bounding_box;
+		cv::Mat room_map = cv::Mat::zeros(bounding_box.height + 2, bounding_box.width + 2, CV_8UC1);
+		for (int row = 0; row < bounding_box.height; ++row)
+		{
+			for (int col = 0; col < bounding_box.width; ++col)
+			{
+				const int component = pixel_components.at<int>(bounding_box.y + row, bounding_box.x + col);
+				if (component != -1 && room_of_component[component] == room_component)
+					room_map.at<unsigned char>(row + 1, col + 1) = 255;
 			}
 		}
+		std::vector < std::vector<cv::Point> > room_contours;
+		cv::findContours(room_map, room_contours, CV_RETR_EXTERNAL, CV_CHAIN_APPROX_SIMPLE, bounding_box.tl() - cv::Point(1, 1));
+		saved_contours.insert(saved_contours.end(), room_contours.begin(), room_contours.end());
 	}
 	//*******************draw contures in new map***********************
 	std::cout << "Segmentation Found " << saved_contours.size() << " rooms." << std::endl;
@@ -0,0 +1,120 @@
+/*!
+ *****************************************************************
+ * \file
+ *
+ * \note
+ * Copyright (c) 2026 \n
+ * Fraunhofer Institute for Manufacturing Engineering
+ * and Automation (IPA) \n\n
+ *
+ *****************************************************************
+ *
+ * \note
+ * Project name: Care-O-bot
+ * \note
+ * ROS stack name: autopnp
+ * \note
+ * ROS package name: ipa_room_segmentation
+ *
+ * \brief
+ *
+ *
+ *****************************************************************
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer. \n
+ * - Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution. \n
+ * - Neither the name of the Fraunhofer Institute for Manufacturing
+ * Engineering and Automation (IPA) nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission. \n
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************/
+#include <ipa_room_segmentation/point_grid.h>
+
+#include <cmath>
+
+PointGrid::PointGrid(const std::vector<cv::Point>& points, const int cell_size)
+: points_(points), cell_size_(std::max(1, cell_size)), origin_(0, 0), grid_width_(1), grid_height_(1)
+{
+	if (points_.size() > 0)
+	{
+		cv::Point max_point = points_[0];
+		origin_ = points_[0];
+		for (size_t i = 1; i < points_.size(); ++i)
+		{
+			origin_.x = std::min(origin_.x, points_[i].x);
+			origin_.y = std::min(origin_.y, points_[i].y);
+			max_point.x = std::max(max_point.x, points_[i].x);
+			max_point.y = std::max(max_point.y, points_[i].y);
+		}
+		grid_width_ = (max_point.x - origin_.x) / cell_size_ + 1;
+		grid_height_ = (max_point.y - origin_.y) / cell_size_ + 1;
+	}
+
+	// counting sort of the points by their cell, keeps the order of the indices within each cell
+	std::vector<int> point_cells(points_.size());
+	cell_starts_.assign(grid_width_*grid_height_ + 1, 0);
+	for (size_t i = 0; i < points_.size(); ++i)
+	{
+		point_cells[i] = getCellCoordinate(points_[i].y - origin_.y)*grid_width_ + getCellCoordinate(points_[i].x - origin_.x);
+		++cell_starts_[point_cells[i] + 1];
+	}
+	for (size_t c = 1; c < cell_starts_.size(); ++c)
+		cell_starts_[c] += cell_starts_[c-1];
+	cell_points_.resize(points_.size());
+	std::vector<int> cell_fill(cell_starts_.begin(), cell_starts_.end()-1);
+	for (size_t i = 0; i < points_.size(); ++i)
+		cell_points_[cell_fill[point_cells[i]]++] = (int)i;
+}
+
+int PointGrid::getCellCoordinate(const int offset) const
+{
+	return (offset >= 0 ? offset / cell_size_ : -((-offset + cell_size_ - 1) / cell_size_));
+}
+
+void PointGrid::getPointsInRadius(const cv::Point& center, const double radius, std::vector<int>& indices) const
+{
+	indices.clear();
+	if (radius <= 0.)
+		return;
+	const int reach = (int)std::ceil(radius);
+	const int min_cell_x = std::max(0, getCellCoordinate(center.x - reach - origin_.x));
+	const int max_cell_x = std::min(grid_width_-1, getCellCoordinate(center.x + reach - origin_.x));
+	const int min_cell_y = std::max(0, getCellCoordinate(center.y - reach - origin_.y));
+	const int max_cell_y = std::min(grid_height_-1, getCellCoordinate(center.y + reach - origin_.y));
+	for (int cell_y = min_cell_y; cell_y <= max_cell_y; ++cell_y)
+	{
+		for (int cell_x = min_cell_x; cell_x <= max_cell_x; ++cell_x)
+		{
+			const int cell = cell_y*grid_width_ + cell_x;
+			for (int i = cell_starts_[cell]; i < cell_starts_[cell+1]; ++i)
+			{
+				const int dx = points_[cell_points_[i]].x - center.x;
+				const int dy = points_[cell_points_[i]].y - center.y;
+				if (std::sqrt((double)(dx*dx + dy*dy)) < radius)
+					indices.push_back(cell_points_[i]);
+			}
+		}
+	}
+	std::sort(indices.begin(), indices.end());
+}
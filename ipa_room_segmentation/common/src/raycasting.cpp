@@ -192,3 +192,209 @@ void LaserScannerRaycasting::bresenham_raycasting(const cv::Mat& map, const cv::
 		}
 	}
 }
+
+int LaserScannerRaycasting::getDirectionalDistanceMapsRows(const cv::Mat& map) const
+{
+	//limit the memory of the directional distance maps to about 64MB
+	return std::max(1, (64 << 20) / (360 * (int)sizeof(unsigned short) * std::max(1, map.cols)));
+}
+
+void LaserScannerRaycasting::computeDirectionalDistanceMapBorders(const cv::Mat& map, const int band_rows)
+{
+	//only the part of the map with free pixels is needed, all rays that leave it hit an obstacle pixel right behind its
+	//border, so the cropped map yields the same beams if a one pixel border is kept
+	std::vector<cv::Point> free_pixels;
+	cv::findNonZero(map, free_pixels);
+	cv::Rect roi = cv::boundingRect(free_pixels);
+	roi.x -= 1;
+	roi.y -= 1;
+	roi.width += 2;
+	roi.height += 2;
+	roi &= cv::Rect(0, 0, map.cols, map.rows);
+	directional_border_roi_ = roi;
+	directional_map_roi_ = cv::Rect();
+	directional_steps_.clear();
+	directional_border_rows_.clear();
+	directional_border_steps_.clear();
+	if (roi.area() == 0)
+		return;
+	const cv::Mat roi_map = map(roi);
+
+	//the sweeps run along the rows of the map for steep beams and along the rows of the transposed map otherwise
+	cv::transpose(roi_map, directional_transposed_map_);
+
+	//the rays leave a band through the last row of the previous band or the first row of the next band
+	for (int row = band_rows; row < map.rows; row += band_rows)
+	{
+		const int border_row = row - roi.y;
+		if (border_row > 0 && border_row < roi.height)
+		{
+			directional_border_rows_.push_back(border_row - 1);
+			directional_border_rows_.push_back(border_row);
+		}
+	}
+	if (directional_border_rows_.empty() == true)
+		return;
+
+	directional_border_steps_.resize(360);
+#pragma omp parallel for
+	for (int angle = 0; angle < 360; angle++)
+	{
+		const double dx = precomputed_cos_[angle];
+		const double dy = precomputed_sin_[angle];
+		const bool transposed = (std::abs(dx) > std::abs(dy));
+		const double major = (transposed == true ? dx : dy);
+		const double minor = (transposed == true ? dy : dx);
+		cv::Mat steps;
+		directional_border_steps_[angle] = cv::Mat::zeros((int)directional_border_rows_.size(), roi.width, CV_16UC1);
+		computeStepsToObstacle((transposed == true ? directional_transposed_map_ : roi_map), (major < 0 ? -1 : 1), minor / std::abs(major),
+				transposed, 0, roi.height, NULL, NULL, steps, directional_border_rows_, directional_border_steps_[angle]);
+	}
+}
+
+void LaserScannerRaycasting::computeDirectionalDistanceMaps(const cv::Mat& map, const int min_row, const int max_row)
+{
+	const cv::Rect roi = directional_border_roi_;
+	directional_map_roi_ = roi & cv::Rect(0, min_row, map.cols, max_row - min_row);
+	directional_steps_.clear();
+	if (directional_map_roi_.area() == 0)
+		return;
+
+	//the rows next to the band are needed unless the band touches the border of the map part
+	const int first_row = directional_map_roi_.y - roi.y;
+	const int last_row = first_row + directional_map_roi_.height;
+	const std::vector<int>::const_iterator previous_row = std::lower_bound(directional_border_rows_.begin(), directional_border_rows_.end(), first_row - 1);
+	const std::vector<int>::const_iterator next_row = std::lower_bound(directional_border_rows_.begin(), directional_border_rows_.end(), last_row);
+	if ((first_row > 0 && (previous_row == directional_border_rows_.end() || *previous_row != first_row - 1))
+			|| (last_row < roi.height && (next_row == directional_border_rows_.end() || *next_row != last_row)))
+	{
+		std::cout << "Error: LaserScannerRaycasting::computeDirectionalDistanceMaps: No borders computed for the rows " << min_row << " to " << max_row << std::endl;
+		directional_map_roi_ = cv::Rect();
+		return;
+	}
+	const cv::Mat roi_map = map(roi);
+
+	directional_steps_.resize(360);
+	directional_step_lengths_.resize(360);
+#pragma omp parallel for
+	for (int angle = 0; angle < 360; angle++)
+	{
+		const double dx = precomputed_cos_[angle];
+		const double dy = precomputed_sin_[angle];
+		const bool transposed = (std::abs(dx) > std::abs(dy));
+		const double major = (transposed == true ? dx : dy);
+		const double minor = (transposed == true ? dy : dx);
+		const unsigned short* previous_row_steps = (first_row > 0 ? directional_border_steps_[angle].ptr<unsigned short>((int)(previous_row - directional_border_rows_.begin())) : NULL);
+		const unsigned short* next_row_steps = (last_row < roi.height ? directional_border_steps_[angle].ptr<unsigned short>((int)(next_row - directional_border_rows_.begin())) : NULL);
+		std::vector<int> recorded_rows;
+		cv::Mat recorded_steps;
+		directional_steps_[angle] = cv::Mat::zeros(directional_map_roi_.height, directional_map_roi_.width, CV_16UC1);
+		computeStepsToObstacle((transposed == true ? directional_transposed_map_ : roi_map), (major < 0 ? -1 : 1), minor / std::abs(major),
+				transposed, first_row, last_row, previous_row_steps, next_row_steps, directional_steps_[angle], recorded_rows, recorded_steps);
+		directional_step_lengths_[angle] = 1. / std::abs(major);
+	}
+}
+
+void LaserScannerRaycasting::computeStepsToObstacle(const cv::Mat& map, const int direction, const double slope, const bool transposed,
+		const int first_row, const int last_row, const unsigned short* previous_row_steps, const unsigned short* next_row_steps,
+		cv::Mat& steps, const std::vector<int>& recorded_rows, cv::Mat& recorded_steps) const
+{
+	//the rays move one row in the given direction and slope*direction columns per step, so the next pixel of a ray that
+	//passes (x,y) lies in row y+direction at column x+x_offsets[y+direction]-x_offsets[y] of the digital line,
+	//the rows are swept from the end of the rays towards their origins
+	std::vector<int> x_offsets(map.rows);
+	for (int y = 0; y < map.rows; ++y)
+		x_offsets[y] = cvRound(direction * y * slope);
+
+	//swept rows and computed columns of the map, the rows of a transposed map are columns of the original map
+	const int first_sweep_row = (transposed == true ? 0 : first_row);
+	const int last_sweep_row = (transposed == true ? map.rows : last_row);
+	const int first_x = (transposed == true ? first_row : 0);
+	const int last_x = (transposed == true ? last_row : map.cols);
+	const int start_row = (direction > 0 ? last_sweep_row - 1 : first_sweep_row);
+	const int end_row = (direction > 0 ? first_sweep_row : last_sweep_row - 1);
+
+	std::vector<unsigned short> current_steps(map.cols, 0), next_steps(map.cols, 0);	// 0 means that the ray leaves the map
+	//rays that leave the rows of an original map continue in the row next to them
+	if (transposed == false && start_row + direction >= 0 && start_row + direction < map.rows)
+		std::copy(direction > 0 ? next_row_steps : previous_row_steps, (direction > 0 ? next_row_steps : previous_row_steps) + map.cols, next_steps.begin());
+	for (int y = start_row; ; y -= direction)
+	{
+		if (y + direction < 0 || y + direction >= map.rows)
+		{
+			std::fill(current_steps.begin() + first_x, current_steps.begin() + last_x, 0);
+		}
+		else
+		{
+			//rays that leave the computed columns of a transposed map continue in the rows next to them, the digital lines
+			//move at most one column per step
+			if (first_x > 0)
+				next_steps[first_x - 1] = previous_row_steps[y + direction];
+			if (last_x < map.cols)
+				next_steps[last_x] = next_row_steps[y + direction];
+			const int shift = x_offsets[y + direction] - x_offsets[y];
+			const unsigned char* next_map_row = map.ptr<unsigned char>(y + direction);
+			for (int x = first_x; x < last_x; ++x)
+			{
+				const int next_x = x + shift;
+				if (next_x < 0 || next_x >= map.cols)
+					current_steps[x] = 0;
+				else if (next_map_row[next_x] == 0)
+					current_steps[x] = 1;
+				else if (next_steps[next_x] != 0 && next_steps[next_x] < 65535)
+					current_steps[x] = next_steps[next_x] + 1;
+				else
+					current_steps[x] = 0;
+			}
+		}
+
+		//copy the row into the outputs, the rows of a transposed map are columns of the outputs
+		if (steps.empty() == false)
+		{
+			if (transposed == true)
+			{
+				for (int x = first_x; x < last_x; ++x)
+					steps.at<unsigned short>(x - first_x, y) = current_steps[x];
+			}
+			else
+			{
+				std::copy(current_steps.begin(), current_steps.end(), steps.ptr<unsigned short>(y - first_row));
+			}
+		}
+		if (recorded_rows.empty() == false)
+		{
+			if (transposed == true)
+			{
+				for (size_t i = 0; i < recorded_rows.size(); ++i)
+					recorded_steps.at<unsigned short>((int)i, y) = current_steps[recorded_rows[i]];
+			}
+			else
+			{
+				const std::vector<int>::const_iterator recorded_row = std::lower_bound(recorded_rows.begin(), recorded_rows.end(), y);
+				if (recorded_row != recorded_rows.end() && *recorded_row == y)
+					std::copy(current_steps.begin(), current_steps.end(), recorded_steps.ptr<unsigned short>((int)(recorded_row - recorded_rows.begin())));
+			}
+		}
+
+		if (y == end_row)
+			break;
+		current_steps.swap(next_steps);
+	}
+}
+
+void LaserScannerRaycasting::directional_raycasting(const cv::Point& location, std::vector<double>& distances) const
+{
+	distances.resize(360, 0);
+	if (directional_map_roi_.contains(location) == false || directional_steps_.size() != 360)
+	{
+		std::cout << "Error: LaserScannerRaycasting::directional_raycasting: No directional distance maps computed for location " << location << std::endl;
+		return;
+	}
+	const cv::Point roi_location = location - directional_map_roi_.tl();
+	for (int angle = 0; angle < 360; angle++)
+	{
+		const unsigned short steps = directional_steps_[angle].at<unsigned short>(roi_location);
+		//rays that leave the map get the same length as in raycasting()
+		distances[angle] = (steps == 0 ? 10. : steps * directional_step_lengths_[angle]);
+	}
+}
@@ -0,0 +1,223 @@
+/*!
+ *****************************************************************
+ * \file
+ *
+ * \note
+ * Copyright (c) 2026 \n
+ * Fraunhofer Institute for Manufacturing Engineering
+ * and Automation (IPA) \n\n
+ *
+ *****************************************************************
+ *
+ * \note
+ * Project name: Care-O-bot
+ * \note
+ * ROS stack name: autopnp
+ * \note
+ * ROS package name: ipa_room_segmentation
+ *
+ * \brief
+ *
+ *
+ *****************************************************************
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer. \n
+ * - Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution. \n
+ * - Neither the name of the Fraunhofer Institute for Manufacturing
+ * Engineering and Automation (IPA) nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission. \n
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************/
+
+#include <ipa_room_segmentation/room_statistics.h>
+#include <ipa_room_segmentation/meanshift2d.h>
+
+void LabeledMapStatistics::computeRoomStatistics(const cv::Mat& labeled_map, std::vector<RoomStatistics>& rooms, std::map<int, size_t>& label_to_index)
+{
+	rooms.clear();
+	label_to_index.clear();
+	std::vector<cv::Point> min_corners, max_corners;
+	int last_label = 0;
+	size_t last_index = 0;
+	for (int v = 0; v < labeled_map.rows; ++v)
+	{
+		const int* row = labeled_map.ptr<int>(v);
+		const int* next_row = (v+1 < labeled_map.rows ? labeled_map.ptr<int>(v+1) : NULL);
+		for (int u = 0; u < labeled_map.cols; ++u)
+		{
+			const int label = row[u];
+			if (label <= 0 || label >= 65280)	// do not count walls/obstacles or free space as label
+				continue;
+
+			// find the room of this label, subsequent cells mostly belong to the same room
+			if (label != last_label || rooms.size() == 0)
+			{
+				std::map<int, size_t>::iterator it = label_to_index.find(label);
+				if (it == label_to_index.end())
+				{
+					it = label_to_index.insert(std::make_pair(label, rooms.size())).first;
+					rooms.push_back(RoomStatistics());
+					rooms.back().label = label;
+					min_corners.push_back(cv::Point(u, v));
+					max_corners.push_back(cv::Point(u, v));
+				}
+				last_label = label;
+				last_index = it->second;
+			}
+			RoomStatistics& room = rooms[last_index];
+			++room.area;
+			min_corners[last_index].x = std::min(u, min_corners[last_index].x);
+			max_corners[last_index].x = std::max(u, max_corners[last_index].x);
+			max_corners[last_index].y = v;		// rows are visited in increasing order
+
+			// neighbors: only the forward half of the 8-neighborhood is checked, the relation is stored for both rooms
+			int forward_neighbors[4] = {0, 0, 0, 0};
+			if (u+1 < labeled_map.cols)
+				forward_neighbors[0] = row[u+1];
+			if (next_row != NULL)
+			{
+				forward_neighbors[1] = next_row[u];
+				if (u > 0)
+					forward_neighbors[2] = next_row[u-1];
+				if (u+1 < labeled_map.cols)
+					forward_neighbors[3] = next_row[u+1];
+			}
+			for (int i = 0; i < 4; ++i)
+			{
+				const int neighbor_label = forward_neighbors[i];
+				if (neighbor_label > 0 && neighbor_label < 65280 && neighbor_label != label)
+					room.neighbor_labels.insert(neighbor_label);
+			}
+		}
+	}
+
+	// make the neighborhood symmetric, the neighbor might have been found only from this room's side
+	for (size_t i = 0; i < rooms.size(); ++i)
+	{
+		rooms[i].bounding_box = cv::Rect(min_corners[i], max_corners[i] + cv::Point(1, 1));
+		for (std::set<int>::const_iterator neighbor = rooms[i].neighbor_labels.begin(); neighbor != rooms[i].neighbor_labels.end(); ++neighbor)
+		{
+			std::map<int, size_t>::const_iterator it = label_to_index.find(*neighbor);
+			if (it != label_to_index.end())
+				rooms[it->second].neighbor_labels.insert(rooms[i].label);
+		}
+	}
+}
+
+void LabeledMapStatistics::computeConnectionToOtherRooms(const cv::Mat& labeled_map, cv::Mat& connection_to_other_rooms)
+{
+	// the room cells (except the image border) that directly border a different room are connected, the connection then spreads through
+	// the cells of the same room, each cell is visited once with a queue
+	connection_to_other_rooms = cv::Mat::zeros(labeled_map.rows, labeled_map.cols, CV_8UC1);
+	std::vector<cv::Point> queue;
+	for (int v=1; v<labeled_map.rows-1; ++v)
+	{
+		for (int u=1; u<labeled_map.cols-1; ++u)
+		{
+			const int label = labeled_map.at<int>(v,u);
+			if (label <= 0 || label >= 65280)
+				continue;
+			bool border_to_other_room = false;
+			for (int dv=-1; dv<=1 && border_to_other_room==false; ++dv)
+			{
+				for (int du=-1; du<=1 && border_to_other_room==false; ++du)
+				{
+					const int neighbor_label = labeled_map.at<int>(v+dv,u+du);
+					if (neighbor_label>0 && neighbor_label<65280 && neighbor_label!=label)
+						border_to_other_room = true;
+				}
+			}
+			if (border_to_other_room == true)
+			{
+				connection_to_other_rooms.at<uchar>(v,u) = 255;
+				queue.push_back(cv::Point(u,v));
+			}
+		}
+	}
+	for (size_t i=0; i<queue.size(); ++i)
+	{
+		const cv::Point cell = queue[i];
+		const int label = labeled_map.at<int>(cell);
+		for (int v=std::max(1, cell.y-1); v<=std::min(labeled_map.rows-2, cell.y+1); ++v)
+		{
+			for (int u=std::max(1, cell.x-1); u<=std::min(labeled_map.cols-2, cell.x+1); ++u)
+			{
+				if (connection_to_other_rooms.at<uchar>(v,u)==0 && labeled_map.at<int>(v,u)==label)
+				{
+					connection_to_other_rooms.at<uchar>(v,u) = 255;
+					queue.push_back(cv::Point(u,v));
+				}
+			}
+		}
+	}
+}
+
+void LabeledMapStatistics::computeRoomCenters(const cv::Mat& labeled_map, const cv::Mat& connection_to_other_rooms, const double map_resolution, std::vector<RoomStatistics>& rooms)
+{
+	const cv::Rect map_rect(0, 0, labeled_map.cols, labeled_map.rows);
+#pragma omp parallel for schedule(dynamic)
+	for (int index = 0; index < (int)rooms.size(); ++index)
+	{
+		RoomStatistics& room_statistics = rooms[index];
+		// the room is cut out with a margin of one cell, so the distance transform sees the surrounding obstacles as in the whole map
+		const cv::Rect roi = cv::Rect(room_statistics.bounding_box.x-1, room_statistics.bounding_box.y-1,
+				room_statistics.bounding_box.width+2, room_statistics.bounding_box.height+2) & map_rect;
+		const int label = room_statistics.label;
+
+		// use the room cells that have some connection to another room (trial 1) or just all cells of that room (trial 2)
+		int trial = (connection_to_other_rooms.empty()==false ? 1 : 2);
+		for (; trial <= 2; ++trial)
+		{
+			// compute distance transform for the room
+			int number_room_pixels = 0;
+			cv::Mat room = cv::Mat::zeros(roi.height, roi.width, CV_8UC1);
+			for (int v = 0; v < roi.height; ++v)
+				for (int u = 0; u < roi.width; ++u)
+					if (labeled_map.at<int>(roi.y+v, roi.x+u) == label && (trial==2 || connection_to_other_rooms.at<uchar>(roi.y+v, roi.x+u)==255))
+					{
+						room.at<uchar>(v, u) = 255;
+						++number_room_pixels;
+					}
+			if (number_room_pixels == 0)
+				continue;
+			cv::Mat distance_map; //variable for the distance-transformed map, type: CV_32FC1
+			cv::distanceTransform(room, distance_map, CV_DIST_L2, 5);
+			// find point set with largest distance to obstacles
+			double min_val = 0., max_val = 0.;
+			cv::minMaxLoc(distance_map, &min_val, &max_val);
+			std::vector<cv::Vec2d> room_cells;
+			for (int v = 0; v < distance_map.rows; ++v)
+				for (int u = 0; u < distance_map.cols; ++u)
+					if (distance_map.at<float>(v, u) > max_val * 0.95f)
+						room_cells.push_back(cv::Vec2d(u, v));
+			if (room_cells.size()==0)
+				continue;
+			// use meanshift to find the modes in that set
+			MeanShift2D ms;
+			const cv::Vec2d room_center = ms.findRoomCenter(room, room_cells, map_resolution);
+			room_statistics.center = cv::Point(room_center[0] + roi.x, room_center[1] + roi.y);
+			break;
+		}
+	}
+}
@@ -217,6 +217,9 @@ VoronoiRandomFieldSegmentation::VoronoiRandomFieldSegmentation()
 	CvBoostParams params(CvBoost::DISCRETE, number_of_classifiers_, 0, 2, false, 0);
 	params_ = params;
 #endif
+	room_boost_ = createBoost();
+	hallway_boost_ = createBoost();
+	doorway_boost_ = createBoost();
 	trained_boost_ = false;
 	trained_conditional_field_ = false;
 }
@@ -549,14 +552,14 @@ void VoronoiRandomFieldSegmentation::trainBoostClassifiers(const std::vector<cv:
 		}
 	}
 	std::string filename_room = classifier_storage_path + "vrf_room_boost.xml";
+	room_boost_ = createBoost();	// always train a new classifier, a loaded one may be shared with other instances
 #if CV_MAJOR_VERSION == 2
 	// Train a boost classifier
-	room_boost_.train(features_Mat, CV_ROW_SAMPLE, room_labels_Mat, cv::Mat(), cv::Mat(), cv::Mat(), cv::Mat(), params_);
+	room_boost_->train(features_Mat, CV_ROW_SAMPLE, room_labels_Mat, cv::Mat(), cv::Mat(), cv::Mat(), cv::Mat(), params_);
 	//save the trained booster
-	room_boost_.save(filename_room.c_str(), "boost");
+	room_boost_->save(filename_room.c_str(), "boost");
 #else
 	// Train a boost classifier
-	room_boost_->create();
 	room_boost_->setBoostType(cv::ml::Boost::DISCRETE);
 	room_boost_->setWeakCount(number_of_classifiers_);
 	room_boost_->setWeightTrimRate(0);
@@ -575,14 +578,14 @@ void VoronoiRandomFieldSegmentation::trainBoostClassifiers(const std::vector<cv:
 	for (int i = 0; i < labels_for_classes[1].size(); i++)
 		hallway_labels_Mat.at<float>(i, 0) = labels_for_classes[1][i];
 	std::string filename_hallway = classifier_storage_path + "vrf_hallway_boost.xml";
+	hallway_boost_ = createBoost();	// always train a new classifier, a loaded one may be shared with other instances
 #if CV_MAJOR_VERSION == 2
 	// Train a boost classifier
-	hallway_boost_.train(features_Mat, CV_ROW_SAMPLE, hallway_labels_Mat, cv::Mat(), cv::Mat(), cv::Mat(), cv::Mat(), params_);
+	hallway_boost_->train(features_Mat, CV_ROW_SAMPLE, hallway_labels_Mat, cv::Mat(), cv::Mat(), cv::Mat(), cv::Mat(), params_);
 	//save the trained booster
-	hallway_boost_.save(filename_hallway.c_str(), "boost");
+	hallway_boost_->save(filename_hallway.c_str(), "boost");
 #else
 	// Train a boost classifier
-	hallway_boost_->create();
 	hallway_boost_->setBoostType(cv::ml::Boost::DISCRETE);
 	hallway_boost_->setWeakCount(number_of_classifiers_);
 	hallway_boost_->setWeightTrimRate(0);
@@ -601,14 +604,14 @@ void VoronoiRandomFieldSegmentation::trainBoostClassifiers(const std::vector<cv:
 	for (int i = 0; i < labels_for_classes[2].size(); i++)
 		doorway_labels_Mat.at<float>(i, 0) = labels_for_classes[2][i];
 	std::string filename_doorway = classifier_storage_path + "vrf_doorway_boost.xml";
+	doorway_boost_ = createBoost();	// always train a new classifier, a loaded one may be shared with other instances
 #if CV_MAJOR_VERSION == 2
 	// Train a boost classifier
-	doorway_boost_.train(features_Mat, CV_ROW_SAMPLE, doorway_labels_Mat, cv::Mat(), cv::Mat(), cv::Mat(), cv::Mat(), params_);
+	doorway_boost_->train(features_Mat, CV_ROW_SAMPLE, doorway_labels_Mat, cv::Mat(), cv::Mat(), cv::Mat(), cv::Mat(), params_);
 	//save the trained booster
-	doorway_boost_.save(filename_doorway.c_str(), "boost");
+	doorway_boost_->save(filename_doorway.c_str(), "boost");
 #else
 	// Train a boost classifier
-	doorway_boost_->create();
 	doorway_boost_->setBoostType(cv::ml::Boost::DISCRETE);
 	doorway_boost_->setWeakCount(number_of_classifiers_);
 	doorway_boost_->setWeightTrimRate(0);
@@ -681,13 +684,13 @@ void VoronoiRandomFieldSegmentation::getAdaBoostFeatureVector(std::vector<double
 		{
 #if CV_MAJOR_VERSION == 2
 		case 0:
-			room_boost_.predict(&features, 0, &weak_hypothesis);
+			room_boost_->predict(&features, 0, &weak_hypothesis);
 			break;
 		case 1:
-			hallway_boost_.predict(&features, 0, &weak_hypothesis);
+			hallway_boost_->predict(&features, 0, &weak_hypothesis);
 			break;
 		case 2:
-			doorway_boost_.predict(&features, 0, &weak_hypothesis);
+			doorway_boost_->predict(&features, 0, &weak_hypothesis);
 			break;
 #else
 		case 0:
@@ -846,7 +849,7 @@ void VoronoiRandomFieldSegmentation::findConditionalWeights(std::vector< std::ve
 
 	// Get weights for room, hallway and doorway classifier.
 #if CV_MAJOR_VERSION == 2
-	room_boost_.predict(&features, 0, &weak_hypothesis);
+	room_boost_->predict(&features, 0, &weak_hypothesis);
 #else
 	room_boost_->predict(featuresMat, weaker);
 #endif
@@ -855,7 +858,7 @@ void VoronoiRandomFieldSegmentation::findConditionalWeights(std::vector< std::ve
 		mean_weights[f] += (double) CV_MAT_ELEM(weak_hypothesis, float, 0, f);
 
 #if CV_MAJOR_VERSION == 2
-	hallway_boost_.predict(&features, 0, &weak_hypothesis);
+	hallway_boost_->predict(&features, 0, &weak_hypothesis);
 #else
 	hallway_boost_->predict(featuresMat, weaker);
 #endif
@@ -864,7 +867,7 @@ void VoronoiRandomFieldSegmentation::findConditionalWeights(std::vector< std::ve
 		mean_weights[f] *= (double) CV_MAT_ELEM(weak_hypothesis, float, 0, f);
 
 #if CV_MAJOR_VERSION == 2
-	doorway_boost_.predict(&features, 0, &weak_hypothesis);
+	doorway_boost_->predict(&features, 0, &weak_hypothesis);
 #else
 	doorway_boost_->predict(featuresMat, weaker);
 #endif
@@ -1228,19 +1231,25 @@ void VoronoiRandomFieldSegmentation::segmentMap(const cv::Mat& original_map, cv:
 		std::string filename_room_default = classifier_default_path + "vrf_room_boost.xml";
 		if (boost::filesystem::exists(boost::filesystem::path(filename_room)) == false)
 			boost::filesystem::copy_file(filename_room_default, filename_room);
-		loadBoost(room_boost_,filename_room);
+		room_boost_ = loadSharedBoost(filename_room);
 
 		std::string filename_hallway = classifier_storage_path + "vrf_hallway_boost.xml";
 		std::string filename_hallway_default = classifier_default_path + "vrf_hallway_boost.xml";
 		if (boost::filesystem::exists(boost::filesystem::path(filename_hallway)) == false)
 			boost::filesystem::copy_file(filename_hallway_default, filename_hallway);
-		loadBoost(hallway_boost_,filename_hallway);
+		hallway_boost_ = loadSharedBoost(filename_hallway);
 
 		std::string filename_doorway = classifier_storage_path + "vrf_doorway_boost.xml";
 		std::string filename_doorway_default = classifier_default_path + "vrf_doorway_boost.xml";
 		if (boost::filesystem::exists(boost::filesystem::path(filename_doorway)) == false)
 			boost::filesystem::copy_file(filename_doorway_default, filename_doorway);
-		loadBoost(doorway_boost_,filename_doorway);
+		doorway_boost_ = loadSharedBoost(filename_doorway);
+
+		if (room_boost_.empty() == true || hallway_boost_.empty() == true || doorway_boost_.empty() == true)
+		{
+			std::cout << "Error: VoronoiRandomFieldSegmentation::segmentMap: Could not load the classifier models." << std::endl;
+			return;
+		}
 
 		// set the trained-Boolean true to only load parameters once
 		trained_boost_ = true;
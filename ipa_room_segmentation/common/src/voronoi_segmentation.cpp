@@ -4,9 +4,46 @@
 #include <ipa_room_segmentation/contains.h>
 
 #include <ipa_room_segmentation/timer.h>
+#include <ipa_room_segmentation/point_grid.h>
 #include <set>
 
 
+// accepts every contour point as first basis point
+struct AnyPoint
+{
+	bool operator()(const int index, const int squared_distance) const
+	{
+		return true;
+	}
+};
+
+// accepts the contour points that are farther away from the critical point than the first basis point, closer than the
+// initial second basis point and farther away from the first basis point than the critical point is from the next obstacle
+struct BasisPoint2Candidate
+{
+	const std::vector<cv::Point>& contour_points_;
+	const cv::Point basis_point_1_;
+	const int squared_distance_basis_1_;
+	const int squared_distance_basis_2_;
+	const int squared_min_basis_distance_;
+
+	BasisPoint2Candidate(const std::vector<cv::Point>& contour_points, const cv::Point& basis_point_1, const int squared_distance_basis_1,
+			const int squared_distance_basis_2, const int squared_min_basis_distance)
+	: contour_points_(contour_points), basis_point_1_(basis_point_1), squared_distance_basis_1_(squared_distance_basis_1),
+	  squared_distance_basis_2_(squared_distance_basis_2), squared_min_basis_distance_(squared_min_basis_distance)
+	{
+	}
+
+	bool operator()(const int index, const int squared_distance) const
+	{
+		const int vector_x_basis = basis_point_1_.x - contour_points_[index].x;
+		const int vector_y_basis = basis_point_1_.y - contour_points_[index].y;
+		return (squared_distance > squared_distance_basis_1_ && squared_distance < squared_distance_basis_2_ &&
+				vector_x_basis*vector_x_basis + vector_y_basis*vector_y_basis > squared_min_basis_distance_);
+	}
+};
+
+
 
 VoronoiSegmentation::VoronoiSegmentation()
 {
@@ -34,6 +71,7 @@ void VoronoiSegmentation::segmentMap(const cv::Mat& map_to_be_labeled, cv::Mat&
 	//			1. Get the discretized contours of the map and the holes, because these are the possible candidates for
 	//			   basis-points.
 	//			2. Find the basis-points for each critical-point by finding the two nearest neighbors of the vector from 1.
+	//			   The contour points are sorted into a grid of cells, so only the cells around the critical point are searched.
 	//			   Also it saves the angle between the two vectors pointing from the critical-point to its two basis-points.
 	//			3. Some critical-lines are too close to each other, so the next part eliminates some of them. For this the
 	//			   algorithm checks, which critical points are too close to each other. Then it compares the angles of these
@@ -84,16 +122,19 @@ void VoronoiSegmentation::segmentMap(const cv::Mat& map_to_be_labeled, cv::Mat&
 				//zero-pixel, so larger areas are split into more regions and small areas into fewer
 				int eps = neighborhood_index / (int) distance_map.at<unsigned char>(v, u); //310
 				int loopcounter = 0; //if a part of the graph is not connected to the rest this variable helps to stop the loop
-				std::vector<cv::Point> temporary_points;	//neighboring-variables, which are different for each point
-				std::set<cv::Point, cv_Point_comp> neighbor_points;	//neighboring-variables, which are different for each point
+				std::vector<cv::Point> neighbor_points;	//neighboring-variables, which are different for each point
 				int neighbor_count = 0;		//variable to save the number of neighbors for each point
-				neighbor_points.insert(cv::Point(u,v)); //add the current Point to the neighborhood
+				neighbor_points.push_back(cv::Point(u,v)); //add the current Point to the neighborhood
+				size_t new_points_begin = 0;	//the points found in the last step, the points before have no unchecked neighbors anymore
 				//find every Point along the voronoi graph in a specified neighborhood
 				do
 				{
 					loopcounter++;
-					//check every point in the neighborhood for other neighbors connected to it
-					for(std::set<cv::Point, cv_Point_comp>::iterator it_neighbor_points = neighbor_points.begin(); it_neighbor_points != neighbor_points.end(); it_neighbor_points++)
+					//check every point found in the last step for other neighbors connected to it, points that have already
+					//been looked at are white, the ones found in this step are marked with 128 and count once for each of their
+					//neighbors in the neighborhood
+					const size_t new_points_end = neighbor_points.size();
+					for (size_t neighbor_index = new_points_begin; neighbor_index < new_points_end; neighbor_index++)
 					{
 						for (int row_counter = -1; row_counter <= 1; row_counter++)
 						{
@@ -103,36 +144,43 @@ void VoronoiSegmentation::segmentMap(const cv::Mat& map_to_be_labeled, cv::Mat&
 									continue;
 
 								//check the neighboring points
-								//(if it already is in the neighborhood it doesn't need to be checked again)
-								const cv::Point& current_neighbor_point = *it_neighbor_points;
-								const int nu = current_neighbor_point.x + column_counter;
-								const int nv = current_neighbor_point.y + row_counter;
+								const int nu = neighbor_points[neighbor_index].x + column_counter;
+								const int nv = neighbor_points[neighbor_index].y + row_counter;
 								if (nv >= 0 && nu >= 0 && nv < voronoi_map.rows && nu < voronoi_map.cols &&
-									voronoi_map.at<unsigned char>(nv, nu) == 127 && neighbor_points.find(cv::Point(nu, nv))==neighbor_points.end())
+									(voronoi_map.at<unsigned char>(nv, nu) == 127 || voronoi_map.at<unsigned char>(nv, nu) == 128))
 								{
 									neighbor_count++;
-									temporary_points.push_back(cv::Point(nu, nv));
+									if (voronoi_map.at<unsigned char>(nv, nu) == 127)
+									{
+										voronoi_map.at<unsigned char>(nv, nu) = 128;
+										neighbor_points.push_back(cv::Point(nu, nv));
+									}
 								}
 							}
 						}
 					}
-					//go trough every found point after all neighborhood points have been checked and add them to it
-					for (int temporary_point_index = 0; temporary_point_index < temporary_points.size(); temporary_point_index++)
+					//make the found points white in the voronoi-map (already looked at)
+					for (size_t neighbor_index = new_points_end; neighbor_index < neighbor_points.size(); neighbor_index++)
 					{
-						neighbor_points.insert(temporary_points[temporary_point_index]);
-						//make the found points white in the voronoi-map (already looked at)
-						voronoi_map.at<unsigned char>(temporary_points[temporary_point_index].y, temporary_points[temporary_point_index].x) = 255;
+						voronoi_map.at<unsigned char>(neighbor_points[neighbor_index].y, neighbor_points[neighbor_index].x) = 255;
 						voronoi_map.at<unsigned char>(v, u) = 255;
 					}
-					//check if enough neighbors have been checked or checked enough times (e.g. at a small segment of the graph)
-				} while (neighbor_count <= eps && loopcounter < max_iterations);
-				//check every found point in the neighborhood if it is the local minimum in the distanceMap
+					new_points_begin = new_points_end;
+					//check if enough neighbors have been checked or checked enough times (e.g. at a small segment of the graph) or
+					//if the neighborhood cannot grow anymore
+				} while (neighbor_count <= eps && loopcounter < max_iterations && new_points_begin < neighbor_points.size());
+				//check every found point in the neighborhood if it is the local minimum in the distanceMap, the topmost and then
+				//leftmost one is taken if several points have the minimal distance and the current point is not among them
 				cv::Point current_critical_point = cv::Point(u, v);
-				for(std::set<cv::Point, cv_Point_comp>::iterator it_neighbor_points = neighbor_points.begin(); it_neighbor_points != neighbor_points.end(); it_neighbor_points++)
+				for (size_t neighbor_index = 1; neighbor_index < neighbor_points.size(); neighbor_index++)
 				{
-					if (distance_map.at<unsigned char>(it_neighbor_points->y, it_neighbor_points->x) < distance_map.at<unsigned char>(current_critical_point.y, current_critical_point.x))
+					const cv::Point& neighbor_point = neighbor_points[neighbor_index];
+					const unsigned char neighbor_distance = distance_map.at<unsigned char>(neighbor_point.y, neighbor_point.x);
+					const unsigned char critical_distance = distance_map.at<unsigned char>(current_critical_point.y, current_critical_point.x);
+					if (neighbor_distance < critical_distance || (neighbor_distance == critical_distance && current_critical_point != cv::Point(u, v)
+						&& cv_Point_comp()(neighbor_point, current_critical_point) == true))
 					{
-						current_critical_point = cv::Point(*it_neighbor_points);
+						current_critical_point = neighbor_point;
 					}
 				}
 				//add the local minimum point to the critical points
@@ -163,69 +211,37 @@ void VoronoiSegmentation::segmentMap(const cv::Mat& map_to_be_labeled, cv::Mat&
 	std::vector < std::vector<cv::Point> > contours;
 	cv::findContours(temporary_map_to_extract_the_contours, contours, CV_RETR_CCOMP, CV_CHAIN_APPROX_NONE);
 
-	// 2. Get the basis-points for each critical-point
+	// 2. Get the basis-points for each critical-point, the contour points are searched with a grid of cells around the critical point
+	std::vector<cv::Point> contour_points;
+	for (int c = 0; c < contours.size(); c++)
+		contour_points.insert(contour_points.end(), contours[c].begin(), contours[c].end());
+	const PointGrid contour_point_grid(contour_points, 16);
 	std::vector<cv::Point> basis_points_1, basis_points_2;
 	std::vector<double> length_of_critical_line;
 	std::vector<double> angles; //the angles between the basis-lines of each critical Point
 	for (int critical_point_index = 0; critical_point_index < critical_points.size(); critical_point_index++)
 	{
-		//set inital points and values for the basis points so the distance comparison can be done
-		cv::Point basis_point_1 = contours[0][0];
-		cv::Point basis_point_2 = contours[0][1];
-		//inital values of the first vector from the current critical point to the contour points and for the distance of it
 		const cv::Point& critical_point = critical_points[critical_point_index];
-		double vector_x_1 = critical_point.x - contours[0][0].x;
-		double vector_y_1 = critical_point.y - contours[0][0].y;
-		double distance_basis_1 = std::sqrt(vector_x_1*vector_x_1 + vector_y_1*vector_y_1);
-		//inital values of the second vector from the current critical point to the contour points and for the distance of it
-		double vector_x_2 = critical_point.x - contours[0][1].x;
-		double vector_y_2 = critical_point.y - contours[0][1].y;
-		double distance_basis_2 = std::sqrt(vector_x_2*vector_x_2 + vector_y_2*vector_y_2);
-
-		//find first basis point
-		int basis_vector_1_x, basis_vector_2_x, basis_vector_1_y, basis_vector_2_y;
-		for (int c = 0; c < contours.size(); c++)
-		{
-			for (int p = 0; p < contours[c].size(); p++)
-			{
-				//calculate the Euclidian distance from the critical Point to the Point on the contour
-				const double vector_x = contours[c][p].x - critical_point.x;
-				const double vector_y = contours[c][p].y - critical_point.y;
-				const double current_distance = std::sqrt(vector_x*vector_x + vector_y*vector_y);
-				//compare the distance to the saved distances if it is smaller
-				if (current_distance < distance_basis_1)
-				{
-					distance_basis_1 = current_distance;
-					basis_point_1 = contours[c][p];
-					basis_vector_1_x = vector_x;
-					basis_vector_1_y = vector_y;
-				}
-			}
-		}
-		//find second basisPpoint
-		for (int c = 0; c < contours.size(); c++)
-		{
-			for (int p = 0; p < contours[c].size(); p++)
-			{
-				//calculate the Euclidian distance from the critical point to the point on the contour
-				const double vector_x = contours[c][p].x - critical_point.x;
-				const double vector_y = contours[c][p].y - critical_point.y;
-				const double current_distance = std::sqrt(vector_x*vector_x + vector_y*vector_y);
-				//calculate the distance between the current contour point and the first basis point to make sure they
-				//are not too close to each other
-				const double vector_x_basis = basis_point_1.x - contours[c][p].x;
-				const double vector_y_basis = basis_point_1.y - contours[c][p].y;
-				const double basis_distance = std::sqrt(vector_x_basis*vector_x_basis + vector_y_basis*vector_y_basis);
-				if (current_distance > distance_basis_1 && current_distance < distance_basis_2 &&
-					basis_distance > (double) distance_map.at<unsigned char>(critical_point.y, critical_point.x))
-				{
-					distance_basis_2 = current_distance;
-					basis_point_2 = contours[c][p];
-					basis_vector_2_x = vector_x;
-					basis_vector_2_y = vector_y;
-				}
-			}
-		}
+		//find first basis point, the closest contour point (the first one of the contours if several have the same distance)
+		const cv::Point basis_point_1 = contour_points[contour_point_grid.getNearestPoint(critical_point, AnyPoint())];
+		const int basis_vector_1_x = basis_point_1.x - critical_point.x;
+		const int basis_vector_1_y = basis_point_1.y - critical_point.y;
+		const double distance_basis_1 = std::sqrt((double)(basis_vector_1_x*basis_vector_1_x + basis_vector_1_y*basis_vector_1_y));
+
+		//find second basis point, the closest contour point that is farther away than the first basis point, but closer than
+		//the second point of the contours, and not too close to the first basis point
+		const int initial_vector_x_2 = contours[0][1].x - critical_point.x;
+		const int initial_vector_y_2 = contours[0][1].y - critical_point.y;
+		const int critical_point_obstacle_distance = distance_map.at<unsigned char>(critical_point.y, critical_point.x);
+		const BasisPoint2Candidate basis_point_2_candidate(contour_points, basis_point_1,
+				basis_vector_1_x*basis_vector_1_x + basis_vector_1_y*basis_vector_1_y,
+				initial_vector_x_2*initial_vector_x_2 + initial_vector_y_2*initial_vector_y_2, critical_point_obstacle_distance*critical_point_obstacle_distance);
+		const int basis_point_2_index = contour_point_grid.getNearestPoint(critical_point, basis_point_2_candidate);
+		const cv::Point basis_point_2 = (basis_point_2_index != -1 ? contour_points[basis_point_2_index] : contours[0][1]);
+		const int basis_vector_2_x = basis_point_2.x - critical_point.x;
+		const int basis_vector_2_y = basis_point_2.y - critical_point.y;
+		const double distance_basis_2 = std::sqrt((double)(basis_vector_2_x*basis_vector_2_x + basis_vector_2_y*basis_vector_2_y));
+
 		//calculate angle between the vectors from the critical Point to the found basis-points
 		double current_angle = std::acos((basis_vector_1_x * basis_vector_2_x + basis_vector_1_y * basis_vector_2_y) / (distance_basis_1 * distance_basis_2)) * 180.0 / PI;
 
@@ -239,36 +255,41 @@ void VoronoiSegmentation::segmentMap(const cv::Mat& map_to_be_labeled, cv::Mat&
 	//3. Check which critical points should be used for the segmentation. This is done by checking the points that are
 	//   in a specified distance to each other and take the point with the largest calculated angle, because larger angles
 	//   correspond to a separation across the room, which is more useful
+	//   The close critical points are found with a grid of cells of the mean checking distance.
+	double mean_check_distance = 0.;
+	for (int critical_point_index = 0; critical_point_index < critical_points.size(); critical_point_index++)
+		mean_check_distance += (int) distance_map.at<unsigned char>(critical_points[critical_point_index].y, critical_points[critical_point_index].x) * min_critical_point_distance_factor;
+	if (critical_points.size() > 0)
+		mean_check_distance /= critical_points.size();
+	const PointGrid critical_point_grid(critical_points, cvCeil(mean_check_distance));
+	std::vector<int> close_critical_points;
 	for (int first_critical_point = 0; first_critical_point < critical_points.size(); first_critical_point++)
 	{
 		//reset variable for checking if the line should be drawn
 		bool draw = true;
-		for (int second_critical_point = 0; second_critical_point < critical_points.size(); second_critical_point++)
+		//check if the points are too close to each other corresponding to the distance to the nearest black pixel
+		//of the current critical point. This is done because critical points at doors are closer to the black region
+		//and shorter and may be eliminated in the following step. By reducing the checking distance at this point
+		//it gets better.
+		critical_point_grid.getPointsInRadius(critical_points[first_critical_point],
+				(int) distance_map.at<unsigned char>(critical_points[first_critical_point].y, critical_points[first_critical_point].x) * min_critical_point_distance_factor, //1.7
+				close_critical_points);
+		for (size_t close_point_index = 0; close_point_index < close_critical_points.size(); close_point_index++)
 		{
+			const int second_critical_point = close_critical_points[close_point_index];
 			if (second_critical_point != first_critical_point)
 			{
-				//get distance of the two current Points
-				const double vector_x = critical_points[second_critical_point].x - critical_points[first_critical_point].x;
-				const double vector_y = critical_points[second_critical_point].y - critical_points[first_critical_point].y;
-				const double critical_point_distance = std::sqrt(vector_x*vector_x + vector_y*vector_y);
-				//check if the points are too close to each other corresponding to the distance to the nearest black pixel
-				//of the current critical point. This is done because critical points at doors are closer to the black region
-				//and shorter and may be eliminated in the following step. By reducing the checking distance at this point
-				//it gets better.
-				if (critical_point_distance < ((int) distance_map.at<unsigned char>(critical_points[first_critical_point].y, critical_points[first_critical_point].x) * min_critical_point_distance_factor)) //1.7
+				//if one point in neighborhood is found that has a larger angle the actual to-be-checked point shouldn't be drawn
+				if (angles[first_critical_point] < angles[second_critical_point])
 				{
-					//if one point in neighborhood is found that has a larger angle the actual to-be-checked point shouldn't be drawn
-					if (angles[first_critical_point] < angles[second_critical_point])
-					{
-						draw = false;
-					}
-					//if the angles of the two neighborhood points are the same the shorter one should be drawn, because it is more likely something like e.g. a door
-					if (angles[first_critical_point] == angles[second_critical_point] &&
-						length_of_critical_line[first_critical_point] > length_of_critical_line[second_critical_point] &&
-						(length_of_critical_line[second_critical_point] > 3 || first_critical_point > second_critical_point))
-					{
-						draw = false;
-					}
+					draw = false;
+				}
+				//if the angles of the two neighborhood points are the same the shorter one should be drawn, because it is more likely something like e.g. a door
+				if (angles[first_critical_point] == angles[second_critical_point] &&
+					length_of_critical_line[first_critical_point] > length_of_critical_line[second_critical_point] &&
+					(length_of_critical_line[second_critical_point] > 3 || first_critical_point > second_critical_point))
+				{
+					draw = false;
 				}
 			}
 		}
@@ -1,7 +1,7 @@
 #include <ipa_room_segmentation/wavefront_region_growing.h>
 
 // spreading image is supposed to be of type CV_32SC1
-void wavefrontRegionGrowing(cv::Mat& image)
+void wavefrontRegionGrowing(cv::Mat& image, const bool geodesic_tie_break)
 {
 	//This function spreads the colored regions of the given map to the neighboring white pixels
 	if (image.type()!=CV_32SC1)
@@ -10,35 +10,83 @@ void wavefrontRegionGrowing(cv::Mat& image)
 		return;
 	}
 
-	cv::Mat spreading_map = image.clone();
-	bool finished = false;
-	while (finished == false)
+	// the wavefront is grown layer by layer with a queue, so each unassigned pixel is visited once: a pixel belongs to layer k if it
+	// has a neighbor of layer k-1, labeled pixels and obstacles form layer 0, unassigned pixels are marked with -1 until they are reached
+	cv::Mat layer_map(image.rows, image.cols, CV_32SC1, cv::Scalar(-1));
+	cv::Mat distance_map;		// geodesic distance to the labeled pixels, only used for the tie break
+	if (geodesic_tie_break == true)
+		distance_map = cv::Mat::zeros(image.rows, image.cols, CV_32FC1);
+	std::vector<cv::Point> current_layer, next_layer;
+	for (int row = 0; row < image.rows; ++row)
 	{
-		finished = true;
-		for (int row = 1; row < spreading_map.rows-1; ++row)
+		for (int column = 0; column < image.cols; ++column)
 		{
-			for (int column = 1; column < spreading_map.cols-1; ++column)
+			const int value = image.at<int>(row, column);
+			if (value <= 65279)		// labeled pixels and obstacles
 			{
-				if (spreading_map.at<int>(row, column) > 65279)		// unassigned pixels
+				layer_map.at<int>(row, column) = 0;
+				if (value != 0)
+					current_layer.push_back(cv::Point(column, row));
+			}
+		}
+	}
+
+	const float diagonal_step = std::sqrt(2.f);
+	for (int layer = 1; current_layer.empty()==false; ++layer)
+	{
+		// collect the unassigned pixels next to the current wavefront, the image border is not filled
+		next_layer.clear();
+		for (std::vector<cv::Point>::const_iterator point = current_layer.begin(); point != current_layer.end(); ++point)
+		{
+			for (int row = std::max(1, point->y-1); row <= std::min(image.rows-2, point->y+1); ++row)
+			{
+				for (int column = std::max(1, point->x-1); column <= std::min(image.cols-2, point->x+1); ++column)
+				{
+					if (layer_map.at<int>(row, column) == -1)
+					{
+						layer_map.at<int>(row, column) = layer;
+						next_layer.push_back(cv::Point(column, row));
+					}
+				}
+			}
+		}
+
+		// fill each new pixel with the colour of a labeled neighbor from the previous layers, i.e. the first one in row-major order
+		// or, with the geodesic tie break, the one that is closest to its labeled origin
+		for (std::vector<cv::Point>::const_iterator point = next_layer.begin(); point != next_layer.end(); ++point)
+		{
+			int fill_value = 0;
+			float min_distance = std::numeric_limits<float>::max();
+			bool set_value = false;
+			for (int row_counter = -1; row_counter <= 1 && set_value==false; ++row_counter)
+			{
+				for (int column_counter = -1; column_counter <= 1 && set_value==false; ++column_counter)
 				{
-					//check 3x3 area around white pixel for fillcolour, if filled Pixel around fill white pixel with that colour
-					bool set_value = false;
-					for (int row_counter = -1; row_counter <= 1 && set_value==false; ++row_counter)
+					const int row = point->y + row_counter;
+					const int column = point->x + column_counter;
+					const int neighbor_layer = layer_map.at<int>(row, column);
+					if (neighbor_layer < 0 || neighbor_layer >= layer || image.at<int>(row, column) == 0)
+						continue;
+					if (geodesic_tie_break == false)
+					{
+						fill_value = image.at<int>(row, column);
+						set_value = true;
+					}
+					else
 					{
-						for (int column_counter = -1; column_counter <= 1 && set_value==false; ++column_counter)
+						const float distance = distance_map.at<float>(row, column) + (row_counter!=0 && column_counter!=0 ? diagonal_step : 1.f);
+						if (distance < min_distance)
 						{
-							int value = image.at<int>(row + row_counter, column + column_counter);
-							if (value != 0 && value <= 65279)
-							{
-								spreading_map.at<int>(row, column) = value;
-								set_value = true;
-								finished = false;	// keep on iterating the wavefront propagation until no more changes occur
-							}
+							min_distance = distance;
+							fill_value = image.at<int>(row, column);
 						}
 					}
 				}
 			}
+			image.at<int>(*point) = fill_value;
+			if (geodesic_tie_break == true)
+				distance_map.at<float>(*point) = min_distance;
 		}
-		image = spreading_map.clone();
+		current_layer.swap(next_layer);
 	}
 }
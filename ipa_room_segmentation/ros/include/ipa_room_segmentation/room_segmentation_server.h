@@ -112,6 +112,9 @@ protected:
 	int max_voronoi_random_field_inference_iterations_; //Variable that shows how many iterations should max. be done when infering in the conditional random field.
 	double min_critical_point_distance_factor_; //Variable that sets the minimal distance between two critical Points before one gets eliminated
 	double max_area_for_merging_; //Variable that shows the maximal area of a room that should be merged with its surrounding rooms
+	int semantic_prediction_grid_step_; //Variable for the semantic method that sets the step of the grid of classified pixels [pixel], 1 classifies every pixel
+	double semantic_min_prediction_confidence_; //Variable for the semantic method, grid points with a lower difference of room and hallway probability are refined
+	bool semantic_deterministic_watershed_seeding_; //Variable for the semantic method that splits too large hallways at the grid-wise maxima of the distance transform instead of random points
 	bool display_segmented_map_;	// displays the segmented map upon service call
 	bool publish_segmented_map_;	// publishes the segmented map as grid map upon service call
 	std::vector<cv::Point> doorway_points_; // vector that saves the found doorway points, when using the 5th algorithm (vrf)
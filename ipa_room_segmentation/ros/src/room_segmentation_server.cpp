@@ -60,7 +60,7 @@
 #include <ipa_room_segmentation/room_segmentation_server.h>
 
 #include <ros/package.h>
-#include <ipa_room_segmentation/meanshift2d.h>
+#include <ipa_room_segmentation/room_statistics.h>
 #include <ipa_room_segmentation/dynamic_reconfigure_client.h>
 
 #include <boost/algorithm/string.hpp>
@@ -131,6 +131,12 @@ RoomSegmentationServer::RoomSegmentationServer(ros::NodeHandle nh, std::string n
 		std::cout << "room_segmentation/room_area_factor_upper_limit = " << room_upper_limit_semantic_ << std::endl;
 		node_handle_.param("room_area_factor_lower_limit_semantic", room_lower_limit_semantic_, 1.0);
 		std::cout << "room_segmentation/room_area_factor_lower_limit = " << room_lower_limit_semantic_ << std::endl;
+		node_handle_.param("semantic_prediction_grid_step", semantic_prediction_grid_step_, 1);
+		std::cout << "room_segmentation/semantic_prediction_grid_step = " << semantic_prediction_grid_step_ << std::endl;
+		node_handle_.param("semantic_min_prediction_confidence", semantic_min_prediction_confidence_, 0.2);
+		std::cout << "room_segmentation/semantic_min_prediction_confidence = " << semantic_min_prediction_confidence_ << std::endl;
+		node_handle_.param("semantic_deterministic_watershed_seeding", semantic_deterministic_watershed_seeding_, true);
+		std::cout << "room_segmentation/semantic_deterministic_watershed_seeding = " << semantic_deterministic_watershed_seeding_ << std::endl;
 
 		// train the algorithm if wanted
 		if(train_semantic_ == true)
@@ -336,8 +342,14 @@ void RoomSegmentationServer::dynamic_reconfigure_callback(ipa_room_segmentation:
 	{
 		room_upper_limit_semantic_ = config.room_area_factor_upper_limit_semantic;
 		room_lower_limit_semantic_ = config.room_area_factor_lower_limit_semantic;
+		semantic_prediction_grid_step_ = config.semantic_prediction_grid_step;
+		semantic_min_prediction_confidence_ = config.semantic_min_prediction_confidence;
+		semantic_deterministic_watershed_seeding_ = config.semantic_deterministic_watershed_seeding;
 		std::cout << "room_segmentation/room_area_factor_upper_limit = " << room_upper_limit_semantic_ << std::endl;
 		std::cout << "room_segmentation/room_area_factor_lower_limit = " << room_lower_limit_semantic_ << std::endl;
+		std::cout << "room_segmentation/semantic_prediction_grid_step = " << semantic_prediction_grid_step_ << std::endl;
+		std::cout << "room_segmentation/semantic_min_prediction_confidence = " << semantic_min_prediction_confidence_ << std::endl;
+		std::cout << "room_segmentation/semantic_deterministic_watershed_seeding = " << semantic_deterministic_watershed_seeding_ << std::endl;
 	}
 	//if (room_segmentation_algorithm_ == 5) //set voronoi random field parameters
 	{
@@ -469,7 +481,8 @@ void RoomSegmentationServer::execute_segmentation_server(const ipa_building_msgs
 		const std::string classifier_default_path = package_path + "/common/files/classifier_models/";
 		const std::string classifier_path = "room_segmentation/classifier_models/";
 		semantic_segmentation.segmentMap(original_img, segmented_map, map_resolution, room_lower_limit_semantic_, room_upper_limit_semantic_,
-			classifier_path, classifier_default_path, (display_segmented_map_&&DEBUG_DISPLAYS));
+			classifier_path, classifier_default_path, (display_segmented_map_&&DEBUG_DISPLAYS), semantic_prediction_grid_step_, semantic_min_prediction_confidence_,
+			semantic_deterministic_watershed_seeding_);
 	}
 	else if (room_segmentation_algorithm_ == 5)
 	{
@@ -511,22 +524,16 @@ void RoomSegmentationServer::execute_segmentation_server(const ipa_building_msgs
 					continue;
 
 				// fill each room area with a unique id
+				// (floodFill returns the number of filled cells)
 				cv::Rect rect;
-				cv::floodFill(segmented_map, cv::Point(x,y), label_index, &rect, 0, 0, 4);
-
-				// determine filled area
-				double area = 0;
-				for (int v = rect.y; v < segmented_map.rows; v++)
-					for (int u = rect.x; u < segmented_map.cols; u++)
-						if (segmented_map.at<int>(v,u)==label_index)
-							area += 1.;
-				area = map_resolution * map_resolution * area;	// convert from cells to m^2
+				const int filled_cells = cv::floodFill(segmented_map, cv::Point(x,y), label_index, &rect, 0, 0, 4);
+				const double area = map_resolution * map_resolution * filled_cells;	// convert from cells to m^2
 
 				// exclude too small and too big rooms
 				if (area < room_lower_limit_passthrough_ || area > room_upper_limit_passthrough_)
 				{
-					for (int v = rect.y; v < segmented_map.rows; v++)
-						for (int u = rect.x; u < segmented_map.cols; u++)
+					for (int v = rect.y; v < rect.y+rect.height; v++)
+						for (int u = rect.x; u < rect.x+rect.width; u++)
 							if (segmented_map.at<int>(v,u)==label_index)
 								segmented_map.at<int>(v,u) = 0;
 				}
@@ -547,63 +554,15 @@ void RoomSegmentationServer::execute_segmentation_server(const ipa_building_msgs
 	//	looping_rate.sleep();
 
 	// get the min/max-values and the room-centers
-	// compute room label codebook
+	// compute room label codebook together with the bounding boxes, areas and neighbors of the rooms in one pass over the map
+	LabeledMapStatistics labeled_map_statistics;
+	std::vector<RoomStatistics> rooms;
 	std::map<int, size_t> label_vector_index_codebook; // maps each room label to a position in the rooms vector
-	size_t vector_index = 0;
-	for (int v = 0; v < segmented_map.rows; ++v)
-	{
-		for (int u = 0; u < segmented_map.cols; ++u)
-		{
-			const int label = segmented_map.at<int>(v, u);
-			if (label > 0 && label < 65280) // do not count walls/obstacles or free space as label
-			{
-				if (label_vector_index_codebook.find(label) == label_vector_index_codebook.end())
-				{
-					label_vector_index_codebook[label] = vector_index;
-					vector_index++;
-				}
-			}
-		}
-	}
-	//min/max y/x-values vector for each room. Initialized with extreme values
-	std::vector<int> min_x_value_of_the_room(label_vector_index_codebook.size(), 100000000);
-	std::vector<int> max_x_value_of_the_room(label_vector_index_codebook.size(), 0);
-	std::vector<int> min_y_value_of_the_room(label_vector_index_codebook.size(), 100000000);
-	std::vector<int> max_y_value_of_the_room(label_vector_index_codebook.size(), 0);
-	//vector of the central Point for each room, initially filled with Points out of the map
-	std::vector<int> room_centers_x_values(label_vector_index_codebook.size(), -1);
-	std::vector<int> room_centers_y_values(label_vector_index_codebook.size(), -1);
-	//***********************Find min/max x and y coordinate and center of each found room********************
-	//check y/x-value for every Pixel and make the larger/smaller value to the current value of the room
-	for (int y = 0; y < segmented_map.rows; ++y)
-	{
-		for (int x = 0; x < segmented_map.cols; ++x)
-		{
-			const int label = segmented_map.at<int>(y, x);
-			if (label > 0 && label < 65280) //if Pixel is white or black it is no room --> doesn't need to be checked
-			{
-				const int index = label_vector_index_codebook[label];
-				min_x_value_of_the_room[index] = std::min(x, min_x_value_of_the_room[index]);
-				max_x_value_of_the_room[index] = std::max(x, max_x_value_of_the_room[index]);
-				max_y_value_of_the_room[index] = std::max(y, max_y_value_of_the_room[index]);
-				min_y_value_of_the_room[index] = std::min(y, min_y_value_of_the_room[index]);
-			}
-		}
-	}
-	//get centers for each room
-//	for (size_t idx = 0; idx < room_centers_x_values.size(); ++idx)
-//	{
-//		if (max_x_value_of_the_room[idx] != 0 && max_y_value_of_the_room[idx] != 0 && min_x_value_of_the_room[idx] != 100000000 && min_y_value_of_the_room[idx] != 100000000)
-//		{
-//			room_centers_x_values[idx] = (min_x_value_of_the_room[idx] + max_x_value_of_the_room[idx]) / 2;
-//			room_centers_y_values[idx] = (min_y_value_of_the_room[idx] + max_y_value_of_the_room[idx]) / 2;
-//			cv::circle(segmented_map, cv::Point(room_centers_x_values[idx], room_centers_y_values[idx]), 2, cv::Scalar(200*256), CV_FILLED);
-//		}
-//	}
+	labeled_map_statistics.computeRoomStatistics(segmented_map, rooms, label_vector_index_codebook);
 	// use distance transform and mean shift to find good room centers that are reachable by the robot
 	// first check whether a robot radius shall be applied to obstacles in order to exclude room center points that are not reachable by the robot
 	cv::Mat segmented_map_copy = segmented_map;
-	cv::Mat connection_to_other_rooms = cv::Mat::zeros(segmented_map.rows, segmented_map.cols, CV_8UC1);	// stores for each pixel whether a path to another rooms exists for a robot of size robot_radius
+	cv::Mat connection_to_other_rooms;	// stores for each pixel whether a path to another rooms exists for a robot of size robot_radius
 	if (goal->robot_radius > 0.0)
 	{
 		// consider robot radius for exclusion of non-reachable points
@@ -618,86 +577,22 @@ void RoomSegmentationServer::execute_segmentation_server(const ipa_building_msgs
 					segmented_map_copy.at<int>(v,u) = 0;
 
 		// compute connectivity of remaining accessible room cells to other rooms
-		bool stop = false;
-		while (stop == false)
-		{
-			stop = true;
-			for (int v=1; v<segmented_map_copy.rows-1; ++v)
-			{
-				for (int u=1; u<segmented_map_copy.cols-1; ++u)
-				{
-					// skip already identified cells
-					if (connection_to_other_rooms.at<uchar>(v,u) != 0)
-						continue;
-
-					// only consider cells labeled as a room
-					const int label = segmented_map_copy.at<int>(v,u);
-					if (label <= 0 || label >= 65280)
-						continue;
-
-					for (int dv=-1; dv<=1; ++dv)
-					{
-						for (int du=-1; du<=1; ++du)
-						{
-							if (dv==0 && du==0)
-								continue;
-							const int neighbor_label = segmented_map_copy.at<int>(v+dv,u+du);
-							if (neighbor_label>0 && neighbor_label<65280 && (neighbor_label!=label || (neighbor_label==label && connection_to_other_rooms.at<uchar>(v+dv,u+du)==255)))
-							{
-								// either the room cell has a direct border to a different room or the room cell has a neighbor from the same room label with a connecting path to another room
-								connection_to_other_rooms.at<uchar>(v,u) = 255;
-								stop = false;
-							}
-						}
-					}
-				}
-			}
-		}
+		labeled_map_statistics.computeConnectionToOtherRooms(segmented_map_copy, connection_to_other_rooms);
 	}
 	// compute the room centers
-	MeanShift2D ms;
-	for (std::map<int, size_t>::iterator it = label_vector_index_codebook.begin(); it != label_vector_index_codebook.end(); ++it)
+	labeled_map_statistics.computeRoomCenters(segmented_map_copy, connection_to_other_rooms, map_resolution, rooms);
+	//min/max y/x-values and central Point for each room, the central Point is out of the map if it could not be found
+	std::vector<int> min_x_value_of_the_room(rooms.size()), max_x_value_of_the_room(rooms.size());
+	std::vector<int> min_y_value_of_the_room(rooms.size()), max_y_value_of_the_room(rooms.size());
+	std::vector<int> room_centers_x_values(rooms.size()), room_centers_y_values(rooms.size());
+	for (size_t index = 0; index < rooms.size(); ++index)
 	{
-		int trial = 1; 	// use robot_radius to avoid room centers that are not accessible by a robot with a given radius
-		if (goal->robot_radius <= 0.)
-			trial = 2;
-
-		for (; trial <= 2; ++trial)
-		{
-			// compute distance transform for each room on the room cells that have some connection to another room (trial 1) or just on all cells of that room (trial 2)
-			const int label = it->first;
-			int number_room_pixels = 0;
-			cv::Mat room = cv::Mat::zeros(segmented_map_copy.rows, segmented_map_copy.cols, CV_8UC1);
-			for (int v = 0; v < segmented_map_copy.rows; ++v)
-				for (int u = 0; u < segmented_map_copy.cols; ++u)
-					if (segmented_map_copy.at<int>(v, u) == label && (trial==2 || connection_to_other_rooms.at<uchar>(v,u)==255))
-					{
-						room.at<uchar>(v, u) = 255;
-						++number_room_pixels;
-					}
-			if (number_room_pixels == 0)
-				continue;
-			cv::Mat distance_map; //variable for the distance-transformed map, type: CV_32FC1
-			cv::distanceTransform(room, distance_map, CV_DIST_L2, 5);
-			// find point set with largest distance to obstacles
-			double min_val = 0., max_val = 0.;
-			cv::minMaxLoc(distance_map, &min_val, &max_val);
-			std::vector<cv::Vec2d> room_cells;
-			for (int v = 0; v < distance_map.rows; ++v)
-				for (int u = 0; u < distance_map.cols; ++u)
-					if (distance_map.at<float>(v, u) > max_val * 0.95f)
-						room_cells.push_back(cv::Vec2d(u, v));
-			if (room_cells.size()==0)
-				continue;
-			// use meanshift to find the modes in that set
-			cv::Vec2d room_center = ms.findRoomCenter(room, room_cells, map_resolution);
-			const int index = it->second;
-			room_centers_x_values[index] = room_center[0];
-			room_centers_y_values[index] = room_center[1];
-
-			if (room_cells.size() > 0)
-				break;
-		}
+		min_x_value_of_the_room[index] = rooms[index].bounding_box.x;
+		max_x_value_of_the_room[index] = rooms[index].bounding_box.x + rooms[index].bounding_box.width - 1;
+		min_y_value_of_the_room[index] = rooms[index].bounding_box.y;
+		max_y_value_of_the_room[index] = rooms[index].bounding_box.y + rooms[index].bounding_box.height - 1;
+		room_centers_x_values[index] = rooms[index].center.x;
+		room_centers_y_values[index] = rooms[index].center.y;
 	}
 
 	// convert the segmented map into an indexed map which labels the segments with consecutive numbers (instead of arbitrary unordered labels in segmented map)